@@ -0,0 +1,94 @@
+//
+// Vortexje -- STREAM-style memory bandwidth benchmark.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+// Usage: stream [n_megabytes]
+//
+// Measures the bandwidth of the STREAM triad a = b + s c, with the arrays first touched by a single thread, and with the
+// arrays first touched in parallel, using the same static partitioning as the triad itself.  On NUMA systems, the latter
+// should attain the combined bandwidth of all memory controllers.  This is the access pattern that the solver uses for its dense
+// matrices.  Set OMP_NUM_THREADS and OMP_PROC_BIND=spread to control the threads.
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+
+#define DEFAULT_N_MEGABYTES 256
+#define N_REPETITIONS       10
+
+// Measure the triad bandwidth in GB/s:
+static double
+triad_bandwidth(long n, bool parallel_first_touch)
+{
+    double *a = new double[n];
+    double *b = new double[n];
+    double *c = new double[n];
+    
+    long i;
+    
+    if (parallel_first_touch) {
+        #pragma omp parallel for schedule(static)
+        for (i = 0; i < n; i++) {
+            a[i] = 0.0;
+            b[i] = 1.0;
+            c[i] = 2.0;
+        }
+        
+    } else {
+        for (i = 0; i < n; i++) {
+            a[i] = 0.0;
+            b[i] = 1.0;
+            c[i] = 2.0;
+        }
+    }
+    
+    double best_time = 0.0;
+    
+    for (int k = 0; k < N_REPETITIONS; k++) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        
+        #pragma omp parallel for schedule(static)
+        for (i = 0; i < n; i++)
+            a[i] = b[i] + 3.0 * c[i];
+            
+        double time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (k == 0 || time < best_time)
+            best_time = time;
+    }
+    
+    delete[] a;
+    delete[] b;
+    delete[] c;
+    
+    return 3 * n * sizeof(double) / best_time / 1e9;
+}
+
+int
+main (int argc, char **argv)
+{
+    long n_megabytes = DEFAULT_N_MEGABYTES;
+    if (argc > 1)
+        n_megabytes = atol(argv[1]);
+
+#ifdef _OPENMP
+    cout << "threads:                      " << omp_get_max_threads() << endl;
+#endif
+
+    long n = n_megabytes * 1024 * 1024 / sizeof(double);
+    
+    cout << "array size:                   " << n_megabytes << " MB" << endl;
+    cout << "triad, serial first touch:    " << triad_bandwidth(n, false) << " GB/s" << endl;
+    cout << "triad, parallel first touch:  " << triad_bandwidth(n, true) << " GB/s" << endl;
+    
+    return 0;
+}
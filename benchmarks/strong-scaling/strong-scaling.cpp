@@ -0,0 +1,144 @@
+//
+// Vortexje -- Strong scaling benchmark for the solver.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+// Usage: strong-scaling [n_wings] [max_threads]
+//
+// Solves the flow around a row of n_wings small wings, using 1, 2, 4, ..., max_threads threads, and reports the wall clock
+// time of every solve.
+//
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <vortexje/solver.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+#define DEFAULT_N_WINGS 16
+
+// Create a rectangular wing, spanning the Z axis:
+static shared_ptr<LiftingSurface>
+create_wing(const string &id, double z)
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface(id));
+
+    LiftingSurfaceBuilder surface_builder(*wing);
+
+    const int n_points_per_airfoil = 24;
+    const int n_airfoils = 9;
+
+    const double chord = 0.5;
+    const double span = 1.0;
+
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0.02, 0.4, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++) {
+            airfoil_points[j](0) -= 0.25 * chord;
+            airfoil_points[j](2) += z - span / 2.0 + i * span / (double) (n_airfoils - 1);
+        }
+
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+
+    return wing;
+}
+
+// Time a single solve:
+static double
+time_solve(int n_wings)
+{
+    shared_ptr<Body> body(new Body(string("wings")));
+
+    for (int i = 0; i < n_wings; i++) {
+        stringstream ss;
+        ss << "wing_" << i;
+
+        body->add_lifting_surface(create_wing(ss.str(), 1.5 * i));
+    }
+
+    Solver solver("strong-scaling-log");
+    solver.add_body(body);
+
+    solver.set_freestream_velocity(Vector3d(30, 0, 0));
+    solver.set_fluid_density(1.2);
+
+    solver.initialize_wakes(0.0);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    solver.solve(0.0, false);
+
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int
+main (int argc, char **argv)
+{
+    int n_wings = DEFAULT_N_WINGS;
+    if (argc > 1)
+        n_wings = atoi(argv[1]);
+
+    int max_threads = 1;
+#ifdef _OPENMP
+    max_threads = omp_get_num_procs();
+#endif
+    if (argc > 2)
+        max_threads = atoi(argv[2]);
+
+    vector<int> n_threads;
+    for (int i = 1; i < max_threads; i *= 2)
+        n_threads.push_back(i);
+    n_threads.push_back(max_threads);
+
+    vector<double> times;
+    for (int i = 0; i < (int) n_threads.size(); i++) {
+#ifdef _OPENMP
+        omp_set_num_threads(n_threads[i]);
+#endif
+
+        times.push_back(time_solve(n_wings));
+    }
+
+    // Report:
+    cout << endl;
+    cout << "threads\ttime [s]\tspeedup\tefficiency" << endl;
+    for (int i = 0; i < (int) n_threads.size(); i++) {
+        double speedup = times[0] / times[i];
+
+        cout << n_threads[i] << "\t" << times[i] << "\t" << speedup << "\t" << speedup / n_threads[i] << endl;
+    }
+
+    return 0;
+}
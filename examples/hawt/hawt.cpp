@@ -206,11 +206,14 @@ public:
         this->attitude = AngleAxis<double>(theta_0, Vector3d::UnitX());
         this->rotational_velocity = Vector3d(-dthetadt, 0, 0);
         
-        // Initialize blades:
+        // Initialize blades.  All blades are copies of a single template blade, so that they share their topology:
+        Blade template_blade("blade");
+        
         for (int i = 0; i < n_blades; i++) {
             stringstream ss;
             ss << "blade_" << i;
-            shared_ptr<Blade> blade(new Blade(ss.str()));
+            shared_ptr<Blade> blade(new Blade(template_blade));
+            blade->id = ss.str();
             
             double theta_blade = theta_0 + 2 * M_PI / n_blades * i;
             blade->rotate(Vector3d::UnitX(), theta_blade);
@@ -256,6 +259,9 @@ main (int argc, char **argv)
     Solver solver("hawt-log");
     solver.add_body(hawt);
     
+    // Exploit the symmetry of the rotor:
+    solver.set_cyclic_symmetry(N_BLADES, position, Vector3d::UnitX());
+    
     Vector3d freestream_velocity(WIND_VELOCITY, 0, 0);
     solver.set_freestream_velocity(freestream_velocity);
     
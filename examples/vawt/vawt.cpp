@@ -145,11 +145,14 @@ public:
         add_non_lifting_surface(tower);
 #endif
         
-        // Initialize blades:
+        // Initialize blades.  All blades are copies of a single template blade, so that they share their topology:
+        Blade template_blade("blade");
+        
         for (int i = 0; i < n_blades; i++) {
             stringstream ss;
             ss << "blade_" << i;
-            shared_ptr<Blade> blade(new Blade(ss.str()));
+            shared_ptr<Blade> blade(new Blade(template_blade));
+            blade->id = ss.str();
             
             Vector3d translation(rotor_radius, 0, 0);
             blade->translate(translation);
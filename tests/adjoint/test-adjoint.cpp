@@ -0,0 +1,214 @@
+//
+// Vortexje -- Test adjoint sensitivities against finite differences for a wing.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <iostream>
+
+#include <vortexje/solver.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+static const double pi = 3.141592653589793238462643383279502884;
+
+#define NODE_STEP     1e-6
+#define VELOCITY_STEP 1e-3
+
+#define TEST_TOLERANCE 1e-4
+
+// Create a rectangular wing, spanning the Z axis:
+static shared_ptr<LiftingSurface>
+create_wing()
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface("main"));
+
+    LiftingSurfaceBuilder surface_builder(*wing);
+
+    const int n_points_per_airfoil = 16;
+    const int n_airfoils = 5;
+
+    const double chord = 0.5;
+    const double span = 2.0;
+
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++) {
+            airfoil_points[j](0) -= 0.25 * chord;
+            airfoil_points[j] = AngleAxis<double>(-5.0 / 180.0 * pi, Vector3d::UnitZ()) * airfoil_points[j];
+            airfoil_points[j](2) += -span / 2.0 + i * span / (double) (n_airfoils - 1);
+        }
+
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+
+    return wing;
+}
+
+// Objective function, a weighted combination of lift and pitching moment:
+static double
+objective(Solver &solver, const shared_ptr<Body> &body)
+{
+    return solver.force(body)(1) + solver.moment(body, Vector3d(0, 0, 0))(2);
+}
+
+// Compare an adjoint sensitivity with a finite difference:
+static bool
+compare(const string &name, double adjoint, double finite_difference, double scale)
+{
+    if (fabs(adjoint - finite_difference) > TEST_TOLERANCE * scale) {
+        cerr << " *** TEST FAILED *** " << endl;
+        cerr << " dJ/d" << name << "(adjoint) = " << adjoint << endl;
+        cerr << " dJ/d" << name << "(finite difference) = " << finite_difference << endl;
+        cerr << " ******************* " << endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+int
+main (int argc, char **argv)
+{
+    // Set parameters:
+    Parameters::convect_wake = false;
+
+    shared_ptr<LiftingSurface> wing = create_wing();
+
+    shared_ptr<Body> body(new Body(string("wing")));
+    body->add_lifting_surface(wing);
+
+    Solver solver("test-adjoint-log");
+    solver.add_body(body);
+
+    solver.set_freestream_velocity(Vector3d(30, 0, 0));
+    solver.set_fluid_density(1.2);
+
+    solver.initialize_wakes(0.0);
+    solver.solve();
+
+    // Compute adjoint sensitivities:
+    Solver::Sensitivities sensitivities;
+    if (!solver.adjoint_sensitivities(body, Vector3d(0, 1, 0), Vector3d(0, 0, 1), Vector3d(0, 0, 0), sensitivities)) {
+        cerr << " *** TEST FAILED *** " << endl;
+        cerr << " Adjoint solution failed" << endl;
+        cerr << " ******************* " << endl;
+
+        return 1;
+    }
+
+    const MatrixXd &node_sensitivities = sensitivities.nodes[wing];
+
+    double node_scale = node_sensitivities.cwiseAbs().maxCoeff();
+
+    // Repeat with the cached factorization of the body influence coefficients, solving with its transpose:
+    Parameters::cache_body_influence_coefficients = true;
+
+    solver.solve();
+
+    Solver::Sensitivities cached_sensitivities;
+    if (!solver.adjoint_sensitivities(body, Vector3d(0, 1, 0), Vector3d(0, 0, 1), Vector3d(0, 0, 0), cached_sensitivities)) {
+        cerr << " *** TEST FAILED *** " << endl;
+        cerr << " Adjoint solution with cached factorization failed" << endl;
+        cerr << " ******************* " << endl;
+
+        return 1;
+    }
+
+    Parameters::cache_body_influence_coefficients = false;
+
+    double cached_node_error = (cached_sensitivities.nodes[wing] - node_sensitivities).cwiseAbs().maxCoeff();
+    double cached_velocity_error = max((cached_sensitivities.body_velocities[0] - sensitivities.body_velocities[0]).cwiseAbs().maxCoeff(),
+                                       (cached_sensitivities.body_rotational_velocities[0] - sensitivities.body_rotational_velocities[0]).cwiseAbs().maxCoeff());
+    double cached_velocity_scale = max(sensitivities.body_velocities[0].cwiseAbs().maxCoeff(), sensitivities.body_rotational_velocities[0].cwiseAbs().maxCoeff());
+
+    if (cached_node_error > TEST_TOLERANCE * node_scale || cached_velocity_error > TEST_TOLERANCE * cached_velocity_scale) {
+        cerr << " *** TEST FAILED *** " << endl;
+        cerr << " Adjoint sensitivities with cached factorization differ (nodes: " << cached_node_error << ", velocities: " << cached_velocity_error << ")" << endl;
+        cerr << " ******************* " << endl;
+
+        return 1;
+    }
+
+    // Compare with finite differences for the nodes of a single airfoil section:
+    for (int node = 2 * wing->n_chordwise_nodes(); node < 3 * wing->n_chordwise_nodes(); node++) {
+        for (int d = 0; d < 3; d++) {
+            Vector3d node_position = wing->nodes[node];
+
+            double J[2];
+            for (int sign = 0; sign < 2; sign++) {
+                wing->nodes[node](d) = node_position(d) + (sign == 0 ? NODE_STEP : -NODE_STEP);
+                for (int i = 0; i < (int) wing->node_panel_neighbors[node]->size(); i++)
+                    wing->compute_geometry((*wing->node_panel_neighbors[node])[i]);
+
+                solver.solve();
+
+                J[sign] = objective(solver, body);
+            }
+
+            wing->nodes[node] = node_position;
+            for (int i = 0; i < (int) wing->node_panel_neighbors[node]->size(); i++)
+                wing->compute_geometry((*wing->node_panel_neighbors[node])[i]);
+
+            if (!compare("x", node_sensitivities(d, node), (J[0] - J[1]) / (2 * NODE_STEP), node_scale))
+                return 1;
+        }
+    }
+
+    // Compare with finite differences for the body velocities:
+    double velocity_scale = max(sensitivities.body_velocities[0].cwiseAbs().maxCoeff(), sensitivities.body_rotational_velocities[0].cwiseAbs().maxCoeff());
+
+    for (int rotational = 0; rotational < 2; rotational++) {
+        for (int d = 0; d < 3; d++) {
+            double J[2];
+            for (int sign = 0; sign < 2; sign++) {
+                Vector3d perturbation = Vector3d::Zero();
+                perturbation(d) = (sign == 0 ? VELOCITY_STEP : -VELOCITY_STEP);
+
+                if (rotational)
+                    body->set_rotational_velocity(perturbation);
+                else
+                    body->set_velocity(perturbation);
+
+                solver.solve();
+
+                J[sign] = objective(solver, body);
+            }
+
+            body->set_velocity(Vector3d::Zero());
+            body->set_rotational_velocity(Vector3d::Zero());
+
+            double adjoint = rotational ? sensitivities.body_rotational_velocities[0](d) : sensitivities.body_velocities[0](d);
+
+            if (!compare(rotational ? "omega" : "v", adjoint, (J[0] - J[1]) / (2 * VELOCITY_STEP), velocity_scale))
+                return 1;
+        }
+    }
+
+    return 0;
+}
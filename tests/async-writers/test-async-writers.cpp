@@ -0,0 +1,250 @@
+//
+// Vortexje -- Test asynchronous surface and field writers against their synchronous counterparts.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#include <vortexje/solver.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+#include <vortexje/surface-writers/async-surface-writer.hpp>
+#include <vortexje/field-writers/vtk-binary-field-writer.hpp>
+#include <vortexje/field-writers/async-field-writer.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+#define N_STEPS 5
+
+// Create a rectangular wing, spanning the Z axis:
+static shared_ptr<LiftingSurface>
+create_wing()
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface("main"));
+    
+    LiftingSurfaceBuilder surface_builder(*wing);
+    
+    const int n_points_per_airfoil = 16;
+    const int n_airfoils = 6;
+    
+    const double chord = 0.5;
+    const double span = 2.0;
+    
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+    
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+    
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++)
+            airfoil_points[j](2) += -span / 2.0 + i * span / (double) (n_airfoils - 1);
+        
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+        
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+        
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+    
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+    
+    return wing;
+}
+
+// Surface writer which keeps copies of everything written.  Writing is slowed down, so that the asynchronous writer
+// falls behind:
+class RecordingSurfaceWriter : public SurfaceWriter
+{
+public:
+    RecordingSurfaceWriter(int delay) : delay(delay), consistent_surfaces(true) {}
+    
+    const char *file_extension() const
+    {
+        return ".rec";
+    }
+    
+    bool write(const std::shared_ptr<Surface> &surface, const std::string &filename,
+               int node_offset, int panel_offset,
+               const std::vector<std::string> &view_names, const std::vector<ViewData> &view_data)
+    {
+        this_thread::sleep_for(chrono::milliseconds(delay));
+        
+        Record &record = records[filename];
+        record.id           = surface->id;
+        record.nodes        = surface->nodes;
+        record.panel_nodes  = surface->panel_nodes;
+        record.node_offset  = node_offset;
+        record.panel_offset = panel_offset;
+        record.view_names   = view_names;
+        record.view_data.assign(view_data.begin(), view_data.end());
+        
+        // Every surface must be represented by the same object at every step:
+        map<string, const Surface *>::const_iterator it = surfaces.find(surface->id);
+        if (it != surfaces.end() && it->second != surface.get())
+            consistent_surfaces = false;
+        surfaces[surface->id] = surface.get();
+        
+        return true;
+    }
+    
+    class Record
+    {
+    public:
+        string id;
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > nodes;
+        vector<vector<int> > panel_nodes;
+        int node_offset;
+        int panel_offset;
+        vector<string> view_names;
+        vector<MatrixXd, Eigen::aligned_allocator<MatrixXd> > view_data;
+    };
+    
+    int delay;
+    
+    map<string, Record> records;
+    
+    map<string, const Surface *> surfaces;
+    
+    bool consistent_surfaces;
+};
+
+static bool
+equal(const RecordingSurfaceWriter::Record &a, const RecordingSurfaceWriter::Record &b)
+{
+    if (a.id != b.id || a.nodes != b.nodes || a.panel_nodes != b.panel_nodes ||
+        a.node_offset != b.node_offset || a.panel_offset != b.panel_offset || a.view_names != b.view_names)
+        return false;
+    
+    if (a.view_data.size() != b.view_data.size())
+        return false;
+    
+    for (int k = 0; k < (int) a.view_data.size(); k++) {
+        if (a.view_data[k] != b.view_data[k])
+            return false;
+    }
+    
+    return true;
+}
+
+static string
+read_file(const string &filename)
+{
+    ifstream f(filename.c_str(), ios::binary);
+    
+    stringstream ss;
+    ss << f.rdbuf();
+    
+    return ss.str();
+}
+
+int
+main (int argc, char **argv)
+{
+    // Set up a translating and rotating wing:
+    shared_ptr<LiftingSurface> wing = create_wing();
+    
+    shared_ptr<Body> body(new Body(string("wing-body")));
+    body->add_lifting_surface(wing);
+    
+    Solver solver("test-async-writers-log");
+    solver.add_body(body);
+    
+    Vector3d freestream_velocity(30, 0, 0);
+    solver.set_freestream_velocity(freestream_velocity);
+    solver.set_fluid_density(1.2);
+    
+    body->set_velocity(Vector3d(0, 1.0, 0));
+    body->set_rotational_velocity(Vector3d(0, 0, 0.5));
+    
+    // Log every step synchronously, and asynchronously through a queue of length one:
+    RecordingSurfaceWriter sync_writer(0);
+    RecordingSurfaceWriter async_target_writer(5);
+    AsyncSurfaceWriter async_writer(async_target_writer, 1);
+    
+    VTKBinaryFieldWriter field_writer;
+    VTKBinaryFieldWriter async_target_field_writer;
+    AsyncFieldWriter async_field_writer(async_target_field_writer, 1);
+    
+    double dt = 0.01;
+    
+    solver.initialize_wakes(dt);
+    for (int step_number = 0; step_number < N_STEPS; step_number++) {
+        if (!solver.solve(dt))
+            return 1;
+        
+        solver.log(step_number, sync_writer);
+        solver.log(step_number, async_writer);
+        
+        stringstream ss;
+        ss << "test-async-writers-field-" << step_number;
+        
+        field_writer.write_velocity_and_velocity_potential_field(solver, ss.str() + "-sync.vtk", -0.5, 1.0, -0.5, 0.5, -1.0, 1.0, 0.25, 0.25, 0.25);
+        async_field_writer.write_velocity_and_velocity_potential_field(solver, ss.str() + "-async.vtk", -0.5, 1.0, -0.5, 0.5, -1.0, 1.0, 0.25, 0.25, 0.25);
+        
+        body->set_position(body->position + dt * body->velocity);
+        body->set_attitude(AngleAxisd(dt * 0.5, Vector3d::UnitZ()) * body->attitude);
+        
+        solver.update_wakes(dt);
+    }
+    
+    if (!async_writer.flush() || !async_field_writer.flush())
+        return 1;
+    
+    // Compare surfaces:
+    if (async_target_writer.records.size() != sync_writer.records.size() || !async_target_writer.consistent_surfaces) {
+        cerr << " *** TEST FAILED *** " << endl;
+        cerr << " " << async_target_writer.records.size() << " surfaces written asynchronously, expected " << sync_writer.records.size() << endl;
+        cerr << " consistent surfaces = " << async_target_writer.consistent_surfaces << endl;
+        cerr << " ******************* " << endl;
+        
+        return 1;
+    }
+    
+    map<string, RecordingSurfaceWriter::Record>::const_iterator it;
+    for (it = sync_writer.records.begin(); it != sync_writer.records.end(); it++) {
+        map<string, RecordingSurfaceWriter::Record>::const_iterator ait = async_target_writer.records.find(it->first);
+        if (ait == async_target_writer.records.end() || !equal(it->second, ait->second)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " Asynchronous output differs for " << it->first << endl;
+            cerr << " ******************* " << endl;
+            
+            return 1;
+        }
+    }
+    
+    // Compare fields:
+    for (int step_number = 0; step_number < N_STEPS; step_number++) {
+        stringstream ss;
+        ss << "test-async-writers-field-" << step_number;
+        
+        string sync_data  = read_file(ss.str() + "-sync.vtk");
+        string async_data = read_file(ss.str() + "-async.vtk");
+        
+        if (sync_data.empty() || sync_data != async_data) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " Asynchronous field output differs for step " << step_number << endl;
+            cerr << " ******************* " << endl;
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,173 @@
+//
+// Vortexje -- Test Anderson acceleration of the boundary layer iteration for a wing.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <vortexje/solver.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+static const double pi = 3.141592653589793238462643383279502884;
+
+#define TRANSPIRATION_GAIN -0.6
+
+#define ACCELERATION_DEPTH 5
+
+#define TEST_TOLERANCE 1e-6
+
+// Model boundary layer, of which the blowing velocity grows with the surface velocity.  This couples the boundary layer 
+// and the potential flow strongly enough for the plain fixed-point iteration to converge slowly:
+class TranspirationBoundaryLayer : public BoundaryLayer
+{
+public:
+    TranspirationBoundaryLayer(int n_panels) : blowing_velocities(VectorXd::Zero(n_panels)) {}
+    
+    bool recalculate(const Vector3d &freestream_velocity, const MatrixXd &surface_velocities)
+    {
+        blowing_velocities = TRANSPIRATION_GAIN * (surface_velocities.rowwise().norm().array() - freestream_velocity.norm()).matrix();
+        
+        return true;
+    }
+    
+    double thickness(const shared_ptr<Surface> &surface, int panel) const
+    {
+        return 0.0;
+    }
+    
+    Vector3d velocity(const shared_ptr<Surface> &surface, int panel, double y) const
+    {
+        return Vector3d(0, 0, 0);
+    }
+    
+    double blowing_velocity(const shared_ptr<Surface> &surface, int panel) const
+    {
+        return blowing_velocities(panel);
+    }
+    
+    Vector3d friction(const shared_ptr<Surface> &surface, int panel) const
+    {
+        return Vector3d(0, 0, 0);
+    }
+    
+private:
+    VectorXd blowing_velocities;
+};
+
+// Create a rectangular wing, spanning the Z axis:
+static shared_ptr<LiftingSurface>
+create_wing()
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface("main"));
+
+    LiftingSurfaceBuilder surface_builder(*wing);
+
+    const int n_points_per_airfoil = 16;
+    const int n_airfoils = 7;
+
+    const double chord = 0.5;
+    const double span = 2.0;
+
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++) {
+            airfoil_points[j](0) -= 0.25 * chord;
+            airfoil_points[j] = AngleAxis<double>(-5.0 / 180.0 * pi, Vector3d::UnitZ()) * airfoil_points[j];
+            airfoil_points[j](2) += -span / 2.0 + i * span / (double) (n_airfoils - 1);
+        }
+
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+
+    return wing;
+}
+
+// Solve the coupled problem, and return the force together with the number of boundary layer iterations:
+static Vector3d
+run_wing(int acceleration_depth, int &n_iterations)
+{
+    Parameters::boundary_layer_acceleration_depth = acceleration_depth;
+    
+    shared_ptr<LiftingSurface> wing = create_wing();
+    
+    shared_ptr<Body> body(new Body(string("wing")));
+    body->add_lifting_surface(wing);
+
+    Solver solver("test-boundary-layer-acceleration-log");
+    solver.add_body(body, shared_ptr<BoundaryLayer>(new TranspirationBoundaryLayer(wing->n_panels())));
+
+    solver.set_freestream_velocity(Vector3d(30, 0, 0));
+    solver.set_fluid_density(1.2);
+
+    solver.initialize_wakes(0.0);
+    if (!solver.solve()) {
+        n_iterations = -1;
+        
+        return Vector3d(0, 0, 0);
+    }
+
+    n_iterations = solver.boundary_layer_iterations();
+    
+    return solver.force(body);
+}
+
+int
+main (int argc, char **argv)
+{
+    // Set parameters:
+    Parameters::convect_wake = false;
+    
+    Parameters::max_boundary_layer_iterations      = 200;
+    Parameters::boundary_layer_iteration_tolerance = 1e-10;
+
+    // Run plain and accelerated iterations:
+    int plain_iterations, accelerated_iterations;
+    
+    Vector3d plain_force       = run_wing(0, plain_iterations);
+    Vector3d accelerated_force = run_wing(ACCELERATION_DEPTH, accelerated_iterations);
+    
+    cout << "Boundary layer iterations:  plain " << plain_iterations << ", accelerated " << accelerated_iterations << endl;
+
+    // Compare:
+    double delta = (plain_force - accelerated_force).norm();
+    if (plain_iterations < 0 || accelerated_iterations < 0 || accelerated_iterations >= plain_iterations ||
+        plain_iterations > Parameters::max_boundary_layer_iterations || delta > TEST_TOLERANCE * max(plain_force.norm(), 1.0)) {
+        cerr << " *** TEST FAILED *** " << endl;
+        cerr << " Iterations(plain) = " << plain_iterations << endl;
+        cerr << " Iterations(accelerated) = " << accelerated_iterations << endl;
+        cerr << " F(plain) = " << plain_force.transpose() << endl;
+        cerr << " F(accelerated) = " << accelerated_force.transpose() << endl;
+        cerr << " ******************* " << endl;
+
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,230 @@
+//
+// Vortexje -- Test that a run resumed from a checkpoint reproduces the original run exactly.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <iostream>
+
+#include <vortexje/solver.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+#include <vortexje/empirical-wakes/ramasamy-leishman-wake.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+static const double pi = 3.141592653589793238462643383279502884;
+
+#define N_STEPS_BEFORE_CHECKPOINT 4
+#define N_STEPS_AFTER_CHECKPOINT  4
+
+#define CHECKPOINT_FILENAME "test-checkpoint-log/checkpoint.vxj"
+
+static const double dt = 0.01;
+
+// Create a rectangular wing, spanning the Z axis.  A flipped wing has the same numbers of nodes and panels, but its panels
+// are oriented the other way around:
+static shared_ptr<LiftingSurface>
+create_wing(bool flipped)
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface("main"));
+
+    LiftingSurfaceBuilder surface_builder(*wing);
+
+    const int n_points_per_airfoil = 16;
+    const int n_airfoils = 7;
+
+    const double chord = 0.5;
+    const double span = 2.0;
+
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++) {
+            airfoil_points[j](0) -= 0.25 * chord;
+            airfoil_points[j](2) += -span / 2.0 + i * span / (double) (n_airfoils - 1);
+        }
+
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+
+        if (i > 0) {
+            vector<int> airfoil_panels;
+            if (flipped)
+                airfoil_panels = surface_builder.create_panels_between_shapes(prev_airfoil_nodes, airfoil_nodes, trailing_edge_point_id);
+            else
+                airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+
+    return wing;
+}
+
+// Create a wing with a Ramasamy-Leishman wake:
+static shared_ptr<Body>
+create_body(shared_ptr<Wake> &wake, bool flipped = false)
+{
+    shared_ptr<Body> body(new Body(string("wing")));
+
+    shared_ptr<LiftingSurface> wing = create_wing(flipped);
+    wake = shared_ptr<Wake>(new RamasamyLeishmanWake(wing));
+
+    body->add_lifting_surface(wing, wake);
+
+    return body;
+}
+
+// Advance the pitching and plunging wing by a number of time steps, and record the forces and the wake doublet distributions:
+static void
+run_steps(Solver &solver, const shared_ptr<Body> &body, const shared_ptr<Wake> &wake, int first_step, int n_steps,
+          vector<Vector3d, Eigen::aligned_allocator<Vector3d> > &forces, vector<vector<double> > &wake_doublet_coefficients)
+{
+    for (int step = first_step; step < first_step + n_steps; step++) {
+        double t = step * dt;
+
+        body->set_attitude(AngleAxis<double>(-5.0 / 180.0 * pi * sin(20 * t), Vector3d::UnitZ()) * Quaterniond::Identity());
+        body->set_velocity(Vector3d(0, 0.2 * cos(20 * t), 0));
+        body->set_position(Vector3d(0, 0.01 * sin(20 * t), 0));
+
+        solver.solve(dt);
+
+        forces.push_back(solver.force(body));
+        wake_doublet_coefficients.push_back(wake->doublet_coefficients);
+
+        solver.update_wakes(dt);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    // Set parameters:
+    Parameters::convect_wake                = true;
+    Parameters::unsteady_bernoulli          = true;
+    Parameters::recycle_krylov_subspace     = true;
+    Parameters::doublet_extrapolation_order = 2;
+
+    // Original run, saving a checkpoint in the background halfway:
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > original_forces;
+    vector<vector<double> > original_wake_doublet_coefficients;
+
+    {
+        shared_ptr<Wake> wake;
+        shared_ptr<Body> body = create_body(wake);
+
+        Solver solver("test-checkpoint-log");
+        solver.add_body(body);
+
+        solver.set_freestream_velocity(Vector3d(30, 0, 0));
+        solver.set_fluid_density(1.2);
+
+        solver.initialize_wakes(dt);
+
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > forces;
+        vector<vector<double> > wake_doublet_coefficients;
+        run_steps(solver, body, wake, 0, N_STEPS_BEFORE_CHECKPOINT, forces, wake_doublet_coefficients);
+
+        if (!solver.save_checkpoint(CHECKPOINT_FILENAME, true)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " Saving checkpoint failed." << endl;
+            cerr << " ******************* " << endl;
+
+            return 1;
+        }
+
+        run_steps(solver, body, wake, N_STEPS_BEFORE_CHECKPOINT, N_STEPS_AFTER_CHECKPOINT, original_forces, original_wake_doublet_coefficients);
+
+        if (!solver.flush_checkpoints()) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " Writing checkpoint failed." << endl;
+            cerr << " ******************* " << endl;
+
+            return 1;
+        }
+    }
+
+    // A checkpoint cannot be loaded into a solver with different bodies:
+    {
+        Solver solver("test-checkpoint-log");
+
+        if (solver.load_checkpoint(CHECKPOINT_FILENAME)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " Checkpoint was loaded into a solver without bodies." << endl;
+            cerr << " ******************* " << endl;
+
+            return 1;
+        }
+    }
+
+    // Nor into a solver with bodies of different topology:
+    {
+        shared_ptr<Wake> wake;
+        shared_ptr<Body> body = create_body(wake, true);
+
+        Solver solver("test-checkpoint-log");
+        solver.add_body(body);
+
+        if (solver.load_checkpoint(CHECKPOINT_FILENAME)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " Checkpoint was loaded into a wing of different topology." << endl;
+            cerr << " ******************* " << endl;
+
+            return 1;
+        }
+    }
+
+    // Resumed run, from a freshly built wing without wake:
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > resumed_forces;
+    vector<vector<double> > resumed_wake_doublet_coefficients;
+
+    {
+        shared_ptr<Wake> wake;
+        shared_ptr<Body> body = create_body(wake);
+
+        Solver solver("test-checkpoint-log");
+        solver.add_body(body);
+
+        if (!solver.load_checkpoint(CHECKPOINT_FILENAME)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " Loading checkpoint failed." << endl;
+            cerr << " ******************* " << endl;
+
+            return 1;
+        }
+
+        run_steps(solver, body, wake, N_STEPS_BEFORE_CHECKPOINT, N_STEPS_AFTER_CHECKPOINT, resumed_forces, resumed_wake_doublet_coefficients);
+    }
+
+    // Compare bit for bit:
+    for (int i = 0; i < N_STEPS_AFTER_CHECKPOINT; i++) {
+        if (original_forces[i] != resumed_forces[i] || original_wake_doublet_coefficients[i] != resumed_wake_doublet_coefficients[i]) {
+            cerr.precision(17);
+
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " Step " << N_STEPS_BEFORE_CHECKPOINT + i << endl;
+            cerr << " F(original) = " << original_forces[i].transpose() << endl;
+            cerr << " F(resumed)  = " << resumed_forces[i].transpose() << endl;
+            cerr << " ******************* " << endl;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
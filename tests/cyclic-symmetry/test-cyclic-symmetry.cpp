@@ -0,0 +1,167 @@
+//
+// Vortexje -- Test cyclic symmetry solver against the full solver for a three-bladed rotor.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+#include <vortexje/solver.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+#include <vortexje/empirical-wakes/ramasamy-leishman-wake.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+static const double pi = 3.141592653589793238462643383279502884;
+
+#define N_BLADES        3
+#define ROTOR_RADIUS    2.0
+#define WIND_VELOCITY   6.0
+#define ROTATIONAL_RATE 9.0
+
+#define N_STEPS 4
+
+#define TEST_TOLERANCE 1e-6
+
+// Create a single, untwisted, blade along the Z axis:
+static shared_ptr<LiftingSurface>
+create_blade(const string &id)
+{
+    shared_ptr<LiftingSurface> blade(new LiftingSurface(id));
+
+    LiftingSurfaceBuilder surface_builder(*blade);
+
+    const int n_points_per_airfoil = 16;
+    const int n_airfoils = 5;
+
+    const double chord = 0.2;
+    const double root_radius = 0.4;
+
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++) {
+            airfoil_points[j](0) -= 0.25 * chord;
+            airfoil_points[j] = AngleAxis<double>(-10.0 / 180.0 * pi, Vector3d::UnitZ()) * airfoil_points[j];
+            airfoil_points[j](2) += root_radius + i * (ROTOR_RADIUS - root_radius) / (double) (n_airfoils - 1);
+        }
+
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+
+    blade->rotate(Vector3d::UnitZ(), -pi / 2.0);
+
+    return blade;
+}
+
+// Create a rotor turning about the X axis:
+static shared_ptr<Body>
+create_rotor(const string &id)
+{
+    shared_ptr<Body> rotor(new Body(id));
+
+    rotor->rotational_velocity = Vector3d(-ROTATIONAL_RATE, 0, 0);
+
+    for (int i = 0; i < N_BLADES; i++) {
+        stringstream ss;
+        ss << "blade_" << i;
+
+        shared_ptr<LiftingSurface> blade = create_blade(ss.str());
+        blade->rotate(Vector3d::UnitX(), 2 * pi / N_BLADES * i);
+
+        shared_ptr<RamasamyLeishmanWake> wake(new RamasamyLeishmanWake(blade));
+        rotor->add_lifting_surface(blade, wake);
+    }
+
+    return rotor;
+}
+
+// Run the rotor for a few time steps, and log the blade forces:
+static vector<Vector3d, Eigen::aligned_allocator<Vector3d> >
+run_rotor(bool cyclic_symmetry)
+{
+    shared_ptr<Body> rotor = create_rotor(string("rotor"));
+
+    Solver solver("test-cyclic-symmetry-log");
+    solver.add_body(rotor);
+
+    if (cyclic_symmetry)
+        solver.set_cyclic_symmetry(N_BLADES, Vector3d(0, 0, 0), Vector3d::UnitX());
+
+    solver.set_freestream_velocity(Vector3d(WIND_VELOCITY, 0, 0));
+    solver.set_fluid_density(1.2);
+
+    double dt = 0.01;
+
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > forces;
+
+    solver.initialize_wakes(dt);
+    for (int step = 0; step < N_STEPS; step++) {
+        solver.solve(dt);
+
+        for (int i = 0; i < N_BLADES; i++)
+            forces.push_back(solver.force(rotor->lifting_surfaces[i]->surface));
+
+        forces.push_back(solver.moment(rotor, Vector3d(0, 0, 0)));
+
+        Quaterniond new_attitude = AngleAxis<double>(rotor->rotational_velocity(0) * dt, Vector3d::UnitX()) * rotor->attitude;
+        rotor->set_attitude(new_attitude);
+
+        solver.update_wakes(dt);
+    }
+
+    return forces;
+}
+
+int
+main (int argc, char **argv)
+{
+    // Set parameters:
+    Parameters::convect_wake       = true;
+    Parameters::unsteady_bernoulli = true;
+
+    RamasamyLeishmanWake::Parameters::initial_vortex_core_radius = 1e-3;
+    RamasamyLeishmanWake::Parameters::min_vortex_core_radius     = 1e-3;
+
+    // Run full and cyclic solvers:
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > full_forces   = run_rotor(false);
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > cyclic_forces = run_rotor(true);
+
+    // Compare:
+    for (int i = 0; i < (int) full_forces.size(); i++) {
+        double delta = (full_forces[i] - cyclic_forces[i]).norm();
+        if (delta > TEST_TOLERANCE * max(full_forces[i].norm(), 1.0)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " F(full) = " << full_forces[i].transpose() << endl;
+            cerr << " F(cyclic) = " << cyclic_forces[i].transpose() << endl;
+            cerr << " ******************* " << endl;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
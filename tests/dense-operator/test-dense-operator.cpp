@@ -0,0 +1,70 @@
+//
+// Vortexje -- Test the multithreaded dense matrix-vector product against Eigen.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <iostream>
+
+#include <Eigen/IterativeLinearSolvers>
+
+#include <vortexje/dense-operator.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+#define N 1000
+
+#define TEST_TOLERANCE 1e-12
+
+int
+main (int argc, char **argv)
+{
+    // Create a diagonally dominant matrix, resembling a matrix of influence coefficients:
+    MatrixXd A = MatrixXd::Random(N, N) / N;
+    A.diagonal().array() += 0.5;
+
+    VectorXd x = VectorXd::Random(N);
+
+    // Compare matrix-vector products:
+    VectorXd y;
+    DenseOperator(A).multiply(x, y);
+
+    VectorXd y_ref = A * x;
+
+    double delta = (y - y_ref).norm();
+    if (delta > TEST_TOLERANCE * y_ref.norm()) {
+        cerr << " *** TEST FAILED *** " << endl;
+        cerr << " |y - y(Eigen)| = " << delta << endl;
+        cerr << " ******************* " << endl;
+
+        return 1;
+    }
+
+    // Compare solutions:
+    BiCGSTAB<MatrixXd, DiagonalPreconditioner<double> > solver_ref(A);
+    solver_ref.setTolerance(TEST_TOLERANCE);
+
+    VectorXd x_ref = solver_ref.solve(y_ref);
+
+    DenseOperator A_operator(A);
+    BiCGSTAB<LinearOperator, LinearOperator::Preconditioner> solver(A_operator);
+    solver.setTolerance(TEST_TOLERANCE);
+
+    VectorXd x_operator = solver.solve(y_ref);
+
+    delta = (x_operator - x_ref).norm();
+    if (solver.info() != Success || delta > 10 * TEST_TOLERANCE * x_ref.norm()) {
+        cerr << " *** TEST FAILED *** " << endl;
+        cerr << " |x - x(Eigen)| = " << delta << endl;
+        cerr << " ******************* " << endl;
+
+        return 1;
+    }
+
+    return 0;
+}
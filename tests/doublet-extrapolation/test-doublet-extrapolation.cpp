@@ -0,0 +1,181 @@
+//
+// Vortexje -- Test the extrapolated initial guesses of the doublet distribution against the previous solution.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <vortexje/solver.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+static const double pi = 3.141592653589793238462643383279502884;
+
+#define N_STEPS 6
+
+#define TEST_TOLERANCE 1e-6
+
+// Create a rectangular wing, spanning the Z axis:
+static shared_ptr<LiftingSurface>
+create_wing()
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface("main"));
+
+    LiftingSurfaceBuilder surface_builder(*wing);
+
+    const int n_points_per_airfoil = 16;
+    const int n_airfoils = 7;
+
+    const double chord = 0.5;
+    const double span = 2.0;
+
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++) {
+            airfoil_points[j](0) -= 0.25 * chord;
+            airfoil_points[j](2) += -span / 2.0 + i * span / (double) (n_airfoils - 1);
+        }
+
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+
+    return wing;
+}
+
+// Sum the iteration counts of the linear solver, as logged by the solver:
+static int
+count_iterations(const string &log)
+{
+    const string prefix = "Solver: Done computing doublet distribution in ";
+
+    int n_iterations = 0;
+
+    istringstream lines(log);
+    string line;
+    while (getline(lines, line)) {
+        if (line.compare(0, prefix.size(), prefix) == 0)
+            n_iterations += atoi(line.c_str() + prefix.size());
+    }
+
+    return n_iterations;
+}
+
+// Run the wing for a few time steps, and log the forces and the total number of iterations of the linear solver:
+static vector<Vector3d, Eigen::aligned_allocator<Vector3d> >
+run_wing(int doublet_extrapolation_order, int &n_iterations)
+{
+    Parameters::doublet_extrapolation_order = doublet_extrapolation_order;
+
+    shared_ptr<Body> body(new Body(string("wing")));
+    body->add_lifting_surface(create_wing());
+
+    Solver solver("test-doublet-extrapolation-log");
+    solver.add_body(body);
+
+    solver.set_freestream_velocity(Vector3d(30, 0, 0));
+    solver.set_fluid_density(1.2);
+
+    double dt = 0.01;
+
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > forces;
+
+    // Capture the log of the solver:
+    ostringstream log;
+    streambuf *cout_buffer = cout.rdbuf(log.rdbuf());
+
+    solver.initialize_wakes(dt);
+    for (int step = 0; step < N_STEPS; step++) {
+        double t = step * dt;
+
+        // Pitch and plunge:
+        body->set_attitude(AngleAxis<double>(-5.0 / 180.0 * pi * sin(20 * t), Vector3d::UnitZ()) * Quaterniond::Identity());
+        body->set_velocity(Vector3d(0, 0.2 * cos(20 * t), 0));
+        body->set_position(Vector3d(0, 0.01 * sin(20 * t), 0));
+
+        solver.solve(dt);
+
+        forces.push_back(solver.force(body));
+
+        solver.update_wakes(dt);
+    }
+
+    cout.rdbuf(cout_buffer);
+
+    n_iterations = count_iterations(log.str());
+
+    return forces;
+}
+
+int
+main (int argc, char **argv)
+{
+    // Set parameters:
+    Parameters::convect_wake       = true;
+    Parameters::unsteady_bernoulli = true;
+
+    // Reference run, starting every time step from the previous solution:
+    int reference_n_iterations;
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > reference_forces = run_wing(0, reference_n_iterations);
+
+    // The initial guess must not affect the converged solution:
+    for (int order = 1; order <= 2; order++) {
+        int n_iterations;
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > forces = run_wing(order, n_iterations);
+
+        cout << "Extrapolation order " << order << ": " << n_iterations << " iterations, against " << reference_n_iterations;
+        cout << " without extrapolation." << endl;
+
+        for (int i = 0; i < (int) reference_forces.size(); i++) {
+            double delta = (reference_forces[i] - forces[i]).norm();
+            if (delta > TEST_TOLERANCE * max(reference_forces[i].norm(), 1.0)) {
+                cerr << " *** TEST FAILED *** " << endl;
+                cerr << " Extrapolation order " << order << ", step " << i << endl;
+                cerr << " F(ref) = " << reference_forces[i].transpose() << endl;
+                cerr << " F = " << forces[i].transpose() << endl;
+                cerr << " ******************* " << endl;
+
+                return 1;
+            }
+        }
+
+        // Quadratic extrapolation must save iterations on the smoothly varying doublet distribution:
+        if (order == 2 && (reference_n_iterations == 0 || n_iterations > reference_n_iterations)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " Iterations(ref) = " << reference_n_iterations << endl;
+            cerr << " Iterations(quadratic extrapolation) = " << n_iterations << endl;
+            cerr << " ******************* " << endl;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
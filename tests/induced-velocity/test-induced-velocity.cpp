@@ -0,0 +1,136 @@
+//
+// Vortexje -- Test batched and fused evaluation of induced velocities and potentials against evaluation panel by panel.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <iostream>
+
+#include <vortexje/surface.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+#define N_POINTS 20
+
+#define TEST_TOLERANCE 1e-10
+
+// Create a rectangular wing, spanning the Z axis:
+static shared_ptr<LiftingSurface>
+create_wing()
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface("main"));
+
+    LiftingSurfaceBuilder surface_builder(*wing);
+
+    const int n_points_per_airfoil = 16;
+    const int n_airfoils = 6;
+
+    const double chord = 0.5;
+    const double span = 2.0;
+
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++)
+            airfoil_points[j](2) += -span / 2.0 + i * span / (double) (n_airfoils - 1);
+
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+
+    return wing;
+}
+
+int
+main (int argc, char **argv)
+{
+    shared_ptr<LiftingSurface> wing = create_wing();
+    
+    // Assign random strengths:
+    VectorXd source_coefficients  = VectorXd::Random(wing->n_panels());
+    VectorXd doublet_coefficients = VectorXd::Random(wing->n_panels());
+    
+    // Pick points around the wing:
+    Matrix3Xd points = Matrix3Xd::Random(3, N_POINTS);
+    
+    // Evaluate in a single batch:
+    Matrix3Xd velocities(3, N_POINTS);
+    wing->induced_velocities(points, source_coefficients, doublet_coefficients, velocities);
+    
+    VectorXd potentials(N_POINTS);
+    wing->induced_velocity_potentials(points, source_coefficients, doublet_coefficients, potentials);
+    
+    // Compare with the sums over the panels:
+    for (int j = 0; j < N_POINTS; j++) {
+        Vector3d x = points.col(j);
+        
+        Vector3d velocity_ref(0, 0, 0);
+        double potential_ref = 0.0;
+        for (int i = 0; i < wing->n_panels(); i++) {
+            velocity_ref += wing->vortex_ring_unit_velocity(x, i) * doublet_coefficients(i);
+            velocity_ref += wing->source_unit_velocity(x, i) * source_coefficients(i);
+            
+            potential_ref += wing->doublet_influence(x, i) * doublet_coefficients(i);
+            potential_ref += wing->source_influence(x, i) * source_coefficients(i);
+        }
+        
+        double velocity_delta  = (velocities.col(j) - velocity_ref).norm();
+        double potential_delta = fabs(potentials(j) - potential_ref);
+        if (velocity_delta > TEST_TOLERANCE * max(velocity_ref.norm(), 1.0) || potential_delta > TEST_TOLERANCE * max(fabs(potential_ref), 1.0)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " x = " << x.transpose() << endl;
+            cerr << " V(batch) = " << velocities.col(j).transpose() << endl;
+            cerr << " V(panels) = " << velocity_ref.transpose() << endl;
+            cerr << " phi(batch) = " << potentials(j) << endl;
+            cerr << " phi(panels) = " << potential_ref << endl;
+            cerr << " ******************* " << endl;
+            
+            return 1;
+        }
+    }
+    
+    // Evaluate velocities and potentials together, and compare with the separate evaluation:
+    Matrix3Xd fused_velocities(3, N_POINTS);
+    VectorXd fused_potentials(N_POINTS);
+    wing->induced_velocities_and_potentials(points, source_coefficients, doublet_coefficients, fused_velocities, fused_potentials);
+    
+    for (int j = 0; j < N_POINTS; j++) {
+        double velocity_delta  = (fused_velocities.col(j) - velocities.col(j)).norm();
+        double potential_delta = fabs(fused_potentials(j) - potentials(j));
+        if (velocity_delta > TEST_TOLERANCE * max(velocities.col(j).norm(), 1.0) || potential_delta > TEST_TOLERANCE * max(fabs(potentials(j)), 1.0)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " x = " << points.col(j).transpose() << endl;
+            cerr << " V(fused) = " << fused_velocities.col(j).transpose() << endl;
+            cerr << " V(separate) = " << velocities.col(j).transpose() << endl;
+            cerr << " phi(fused) = " << fused_potentials(j) << endl;
+            cerr << " phi(separate) = " << potentials(j) << endl;
+            cerr << " ******************* " << endl;
+            
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+//
+// Vortexje -- Test batched load cases against separate solutions for a wing.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <iostream>
+
+#include <vortexje/solver.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+static const double pi = 3.141592653589793238462643383279502884;
+
+#define N_LOAD_CASES 4
+
+#define TEST_TOLERANCE 1e-6
+
+// Create a rectangular wing, spanning the Z axis:
+static shared_ptr<LiftingSurface>
+create_wing()
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface("main"));
+
+    LiftingSurfaceBuilder surface_builder(*wing);
+
+    const int n_points_per_airfoil = 16;
+    const int n_airfoils = 7;
+
+    const double chord = 0.5;
+    const double span = 2.0;
+
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++) {
+            airfoil_points[j](0) -= 0.25 * chord;
+            airfoil_points[j](2) += -span / 2.0 + i * span / (double) (n_airfoils - 1);
+        }
+
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+
+    return wing;
+}
+
+// Create load cases with varying angles of attack and sideslip, and varying rotation rates:
+static vector<Solver::LoadCase, Eigen::aligned_allocator<Solver::LoadCase> >
+create_load_cases()
+{
+    vector<Solver::LoadCase, Eigen::aligned_allocator<Solver::LoadCase> > load_cases;
+
+    for (int c = 0; c < N_LOAD_CASES; c++) {
+        double alpha = (2.0 + c) / 180.0 * pi;
+        double beta  = (c % 2) / 180.0 * pi;
+
+        Solver::LoadCase load_case(30 * Vector3d(cos(alpha) * cos(beta), sin(alpha), cos(alpha) * sin(beta)));
+
+        load_case.body_velocities.push_back(Vector3d(0, 0, 0));
+        load_case.body_rotational_velocities.push_back(Vector3d(0.5 * c, 0, 0.2 * c));
+
+        load_cases.push_back(load_case);
+    }
+
+    return load_cases;
+}
+
+int
+main (int argc, char **argv)
+{
+    // Set parameters:
+    Parameters::convect_wake = false;
+
+    shared_ptr<Body> body(new Body(string("wing")));
+    body->add_lifting_surface(create_wing());
+
+    Solver solver("test-load-cases-log");
+    solver.add_body(body);
+
+    solver.set_freestream_velocity(Vector3d(30, 0, 0));
+    solver.set_fluid_density(1.2);
+
+    solver.initialize_wakes(0.0);
+
+    vector<Solver::LoadCase, Eigen::aligned_allocator<Solver::LoadCase> > load_cases = create_load_cases();
+
+    Vector3d x(0, 0, 0);
+
+    // Solve batch:
+    vector<Solver::LoadCaseResult> results;
+    if (!solver.solve_load_cases(load_cases, x, results)) {
+        cerr << " *** TEST FAILED *** " << endl;
+        cerr << " Batched solution failed" << endl;
+        cerr << " ******************* " << endl;
+
+        return 1;
+    }
+
+    // Solve separately, and compare:
+    for (int c = 0; c < N_LOAD_CASES; c++) {
+        solver.set_freestream_velocity(load_cases[c].freestream_velocity);
+        body->set_velocity(load_cases[c].body_velocities[0]);
+        body->set_rotational_velocity(load_cases[c].body_rotational_velocities[0]);
+
+        solver.solve();
+
+        Vector3d F = solver.force(body);
+        Vector3d M = solver.moment(body, x);
+
+        double delta_F = (F - results[c].forces[0]).norm();
+        double delta_M = (M - results[c].moments[0]).norm();
+        if (delta_F > TEST_TOLERANCE * max(F.norm(), 1.0) || delta_M > TEST_TOLERANCE * max(M.norm(), 1.0)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " F(separate) = " << F.transpose() << endl;
+            cerr << " F(batched) = " << results[c].forces[0].transpose() << endl;
+            cerr << " M(separate) = " << M.transpose() << endl;
+            cerr << " M(batched) = " << results[c].moments[0].transpose() << endl;
+            cerr << " ******************* " << endl;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
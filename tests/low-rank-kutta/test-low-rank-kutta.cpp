@@ -0,0 +1,133 @@
+//
+// Vortexje -- Test the low-rank Kutta condition update against the full solver for a pitching and plunging wing.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <iostream>
+
+#include <vortexje/solver.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+static const double pi = 3.141592653589793238462643383279502884;
+
+#define N_STEPS 5
+
+#define TEST_TOLERANCE 1e-6
+
+// Create a rectangular wing, spanning the Z axis:
+static shared_ptr<LiftingSurface>
+create_wing()
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface("main"));
+
+    LiftingSurfaceBuilder surface_builder(*wing);
+
+    const int n_points_per_airfoil = 16;
+    const int n_airfoils = 7;
+
+    const double chord = 0.5;
+    const double span = 2.0;
+
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++) {
+            airfoil_points[j](0) -= 0.25 * chord;
+            airfoil_points[j](2) += -span / 2.0 + i * span / (double) (n_airfoils - 1);
+        }
+
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+
+    return wing;
+}
+
+// Run the wing for a few time steps, and log the forces:
+static vector<Vector3d, Eigen::aligned_allocator<Vector3d> >
+run_wing(bool cache_body_influence_coefficients)
+{
+    Parameters::cache_body_influence_coefficients = cache_body_influence_coefficients;
+
+    shared_ptr<Body> body(new Body(string("wing")));
+    body->add_lifting_surface(create_wing());
+
+    Solver solver("test-low-rank-kutta-log");
+    solver.add_body(body);
+
+    solver.set_freestream_velocity(Vector3d(30, 0, 0));
+    solver.set_fluid_density(1.2);
+
+    double dt = 0.01;
+
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > forces;
+
+    solver.initialize_wakes(dt);
+    for (int step = 0; step < N_STEPS; step++) {
+        double t = step * dt;
+
+        // Pitch and plunge:
+        body->set_attitude(AngleAxis<double>(-5.0 / 180.0 * pi * sin(20 * t), Vector3d::UnitZ()) * Quaterniond::Identity());
+        body->set_velocity(Vector3d(0, 0.2 * cos(20 * t), 0));
+        body->set_position(Vector3d(0, 0.01 * sin(20 * t), 0));
+
+        solver.solve(dt);
+
+        forces.push_back(solver.force(body));
+
+        solver.update_wakes(dt);
+    }
+
+    return forces;
+}
+
+int
+main (int argc, char **argv)
+{
+    // Set parameters:
+    Parameters::convect_wake       = true;
+    Parameters::unsteady_bernoulli = true;
+
+    // Run iterative and low-rank solvers:
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > iterative_forces = run_wing(false);
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > low_rank_forces  = run_wing(true);
+
+    // Compare:
+    for (int i = 0; i < (int) iterative_forces.size(); i++) {
+        double delta = (iterative_forces[i] - low_rank_forces[i]).norm();
+        if (delta > TEST_TOLERANCE * max(iterative_forces[i].norm(), 1.0)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " F(iterative) = " << iterative_forces[i].transpose() << endl;
+            cerr << " F(low rank) = " << low_rank_forces[i].transpose() << endl;
+            cerr << " ******************* " << endl;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
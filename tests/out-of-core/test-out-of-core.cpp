@@ -0,0 +1,163 @@
+//
+// Vortexje -- Test the out-of-core solver against the in-core solver, and check its resident memory.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <iostream>
+
+#include <sys/resource.h>
+
+#include <vortexje/solver.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+static const double pi = 3.141592653589793238462643383279502884;
+
+#define N_STEPS 2
+
+#define BLOCK_SIZE 64
+
+#define TEST_TOLERANCE 1e-6
+
+// Create a finely paneled rectangular wing, spanning the Z axis:
+static shared_ptr<LiftingSurface>
+create_wing()
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface("main"));
+
+    LiftingSurfaceBuilder surface_builder(*wing);
+
+    const int n_points_per_airfoil = 32;
+    const int n_airfoils = 41;
+
+    const double chord = 0.5;
+    const double span = 4.0;
+
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++) {
+            airfoil_points[j](0) -= 0.25 * chord;
+            airfoil_points[j](2) += -span / 2.0 + i * span / (double) (n_airfoils - 1);
+        }
+
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+
+    return wing;
+}
+
+// Peak resident set size, in bytes:
+static double
+max_resident_set_size()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_maxrss * 1024.0;
+}
+
+// Run the wing for a few time steps, and log the forces:
+static vector<Vector3d, Eigen::aligned_allocator<Vector3d> >
+run_wing(bool out_of_core, int &n_panels)
+{
+    Parameters::out_of_core = out_of_core;
+
+    shared_ptr<Body> body(new Body(string("wing")));
+    body->add_lifting_surface(create_wing());
+
+    n_panels = body->lifting_surfaces[0]->surface->n_panels();
+
+    Solver solver("test-out-of-core-log");
+    solver.add_body(body);
+
+    solver.set_freestream_velocity(Vector3d(30, 0, 0));
+    solver.set_fluid_density(1.2);
+
+    body->set_attitude(AngleAxis<double>(-5.0 / 180.0 * pi, Vector3d::UnitZ()) * Quaterniond::Identity());
+
+    double dt = 0.01;
+
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > forces;
+
+    solver.initialize_wakes(dt);
+    for (int step = 0; step < N_STEPS; step++) {
+        solver.solve(dt);
+
+        forces.push_back(solver.force(body));
+
+        solver.update_wakes(dt);
+    }
+
+    return forces;
+}
+
+int
+main (int argc, char **argv)
+{
+    // Set parameters:
+    Parameters::convect_wake       = true;
+    Parameters::unsteady_bernoulli = true;
+
+    Parameters::out_of_core_block_size = BLOCK_SIZE;
+
+    // Run the out-of-core solver first, so that the peak resident set size is not dominated by the in-core matrix:
+    int n_panels;
+
+    double initial_rss = max_resident_set_size();
+
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > out_of_core_forces = run_wing(true, n_panels);
+
+    double out_of_core_rss = max_resident_set_size() - initial_rss;
+    double matrix_size     = (double) n_panels * n_panels * sizeof(double);
+
+    if (out_of_core_rss > 0.5 * matrix_size) {
+        cerr << " *** TEST FAILED *** " << endl;
+        cerr << " Resident set size increase = " << out_of_core_rss << " bytes" << endl;
+        cerr << " Matrix size = " << matrix_size << " bytes" << endl;
+        cerr << " ******************* " << endl;
+
+        return 1;
+    }
+
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > in_core_forces = run_wing(false, n_panels);
+
+    // Compare:
+    for (int i = 0; i < (int) in_core_forces.size(); i++) {
+        double delta = (in_core_forces[i] - out_of_core_forces[i]).norm();
+        if (delta > TEST_TOLERANCE * max(in_core_forces[i].norm(), 1.0)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " F(in core) = " << in_core_forces[i].transpose() << endl;
+            cerr << " F(out of core) = " << out_of_core_forces[i].transpose() << endl;
+            cerr << " ******************* " << endl;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
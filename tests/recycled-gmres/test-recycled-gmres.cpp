@@ -0,0 +1,194 @@
+//
+// Vortexje -- Test recycled GMRES against BiCGSTAB for a pitching and plunging wing.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <vortexje/solver.hpp>
+#include <vortexje/recycled-gmres.hpp>
+#include <vortexje/dense-operator.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+static const double pi = 3.141592653589793238462643383279502884;
+
+#define N_STEPS 8
+
+#define TEST_TOLERANCE 1e-6
+
+#define GMRES_TOLERANCE 1e-6
+
+// Create a rectangular wing, spanning the Z axis:
+static shared_ptr<LiftingSurface>
+create_wing()
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface("main"));
+
+    LiftingSurfaceBuilder surface_builder(*wing);
+
+    const int n_points_per_airfoil = 16;
+    const int n_airfoils = 7;
+
+    const double chord = 0.5;
+    const double span = 2.0;
+
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++) {
+            airfoil_points[j](0) -= 0.25 * chord;
+            airfoil_points[j](2) += -span / 2.0 + i * span / (double) (n_airfoils - 1);
+        }
+
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+
+    return wing;
+}
+
+// Run the wing for a few time steps, and log the forces:
+static vector<Vector3d, Eigen::aligned_allocator<Vector3d> >
+run_wing(bool recycle_krylov_subspace)
+{
+    Parameters::recycle_krylov_subspace = recycle_krylov_subspace;
+
+    shared_ptr<Body> body(new Body(string("wing")));
+    body->add_lifting_surface(create_wing());
+
+    Solver solver("test-recycled-gmres-log");
+    solver.add_body(body);
+
+    solver.set_freestream_velocity(Vector3d(30, 0, 0));
+    solver.set_fluid_density(1.2);
+
+    double dt = 0.01;
+
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > forces;
+
+    solver.initialize_wakes(dt);
+    for (int step = 0; step < N_STEPS; step++) {
+        double t = step * dt;
+
+        // Pitch and plunge:
+        body->set_attitude(AngleAxis<double>(-5.0 / 180.0 * pi * sin(20 * t), Vector3d::UnitZ()) * Quaterniond::Identity());
+        body->set_velocity(Vector3d(0, 0.2 * cos(20 * t), 0));
+        body->set_position(Vector3d(0, 0.01 * sin(20 * t), 0));
+
+        solver.solve(dt);
+
+        forces.push_back(solver.force(body));
+
+        solver.update_wakes(dt);
+    }
+
+    return forces;
+}
+
+// Solve a sequence of slowly changing linear systems with a single recycled GMRES solver.  Every solution must satisfy the
+// tolerance, and the error reported by the solver must be its true relative residual |b - A x| / |b|:
+static bool
+solve_sequence(const MatrixXd &A0, const MatrixXd &dA, int n_systems, double &residual, double &error)
+{
+    RecycledGMRES gmres;
+    gmres.set_tolerance(GMRES_TOLERANCE);
+    gmres.set_restart(5, 2);
+
+    VectorXd x = VectorXd::Zero(A0.rows());
+    for (int i = 0; i < n_systems; i++) {
+        MatrixXd A = A0 + i * dA;
+        VectorXd b = VectorXd::Ones(A.rows()) + i * VectorXd::LinSpaced(A.rows(), 0, 1);
+
+        bool success = gmres.solve(DenseOperator(A), b, x);
+
+        residual = (b - A * x).norm() / b.norm();
+        error    = gmres.error();
+
+        if (!success || residual > GMRES_TOLERANCE || fabs(error - residual) > 1e-6 * residual + 1e-14)
+            return false;
+    }
+
+    return true;
+}
+
+int
+main (int argc, char **argv)
+{
+    // Check the true residual of recycled solves.  The first sequence requires restarts;  the matrices of the second have only
+    // three distinct eigenvalues, so that the Krylov subspace is exhausted before the end of the first cycle:
+    srand(0);
+
+    const int n = 40;
+
+    MatrixXd A_restarted = 4 * MatrixXd::Identity(n, n) + MatrixXd::Random(n, n) / sqrt(n);
+    MatrixXd A_breakdown = MatrixXd::Zero(n, n);
+    for (int i = 0; i < n; i++)
+        A_breakdown(i, i) = 1 + i % 3;
+
+    for (int i = 0; i < 2; i++) {
+        double residual, error;
+
+        bool success;
+        if (i == 0)
+            success = solve_sequence(A_restarted, 1e-3 * MatrixXd::Random(n, n), 4, residual, error);
+        else
+            success = solve_sequence(A_breakdown, 1e-3 * MatrixXd::Identity(n, n), 4, residual, error);
+
+        if (!success) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " |b - A x| / |b| = " << residual << endl;
+            cerr << " Reported error  = " << error << endl;
+            cerr << " ******************* " << endl;
+
+            return 1;
+        }
+    }
+
+    // Set parameters:
+    Parameters::convect_wake       = true;
+    Parameters::unsteady_bernoulli = true;
+
+    // Run BiCGSTAB and recycled GMRES solvers:
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > bicgstab_forces = run_wing(false);
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > recycled_forces  = run_wing(true);
+
+    // Compare:
+    for (int i = 0; i < (int) bicgstab_forces.size(); i++) {
+        double delta = (bicgstab_forces[i] - recycled_forces[i]).norm();
+        if (delta > TEST_TOLERANCE * max(bicgstab_forces[i].norm(), 1.0)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " F(BiCGSTAB) = " << bicgstab_forces[i].transpose() << endl;
+            cerr << " F(recycled) = " << recycled_forces[i].transpose() << endl;
+            cerr << " ******************* " << endl;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
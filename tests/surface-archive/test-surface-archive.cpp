@@ -0,0 +1,233 @@
+//
+// Vortexje -- Test surface archives by reading back the logs of an unsteady simulation.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#include <vortexje/solver.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+#include <vortexje/surface-writers/archive-surface-writer.hpp>
+#include <vortexje/surface-archive-reader.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+#define N_STEPS 5
+
+#define TEST_TOLERANCE 1e-10
+
+// Create a rectangular wing, spanning the Z axis:
+static shared_ptr<LiftingSurface>
+create_wing()
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface("main"));
+    
+    LiftingSurfaceBuilder surface_builder(*wing);
+    
+    const int n_points_per_airfoil = 16;
+    const int n_airfoils = 6;
+    
+    const double chord = 0.5;
+    const double span = 2.0;
+    
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+    
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+    
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++)
+            airfoil_points[j](2) += -span / 2.0 + i * span / (double) (n_airfoils - 1);
+        
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+        
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+        
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+    
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+    
+    return wing;
+}
+
+// Surface writer which forwards to another writer, and keeps copies of everything written:
+class RecordingSurfaceWriter : public SurfaceWriter
+{
+public:
+    RecordingSurfaceWriter(SurfaceWriter &writer) : writer(writer) {}
+    
+    const char *file_extension() const
+    {
+        return writer.file_extension();
+    }
+    
+    bool write(const std::shared_ptr<Surface> &surface, const std::string &filename,
+               int node_offset, int panel_offset,
+               const std::vector<std::string> &view_names, const std::vector<ViewData> &view_data)
+    {
+        Record &record = records[filename];
+        record.nodes       = surface->nodes;
+        record.panel_nodes = surface->panel_nodes;
+        record.view_names  = view_names;
+        record.view_data.assign(view_data.begin(), view_data.end());
+        
+        return writer.write(surface, filename, node_offset, panel_offset, view_names, view_data);
+    }
+    
+    class Record
+    {
+    public:
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > nodes;
+        vector<vector<int> > panel_nodes;
+        vector<string> view_names;
+        vector<MatrixXd, Eigen::aligned_allocator<MatrixXd> > view_data;
+    };
+    
+    map<string, Record> records;
+
+private:
+    SurfaceWriter &writer;
+};
+
+// Compare all steps in an archive with the recorded steps:
+static bool
+compare(const string &filename, const RecordingSurfaceWriter &recording_writer)
+{
+    SurfaceArchiveReader reader;
+    if (!reader.open(filename))
+        return false;
+    
+    if (reader.n_entries() != (int) recording_writer.records.size()) {
+        cerr << " *** TEST FAILED *** " << endl;
+        cerr << " " << filename << ": " << reader.n_entries() << " steps, expected " << recording_writer.records.size() << endl;
+        cerr << " ******************* " << endl;
+        
+        return false;
+    }
+    
+    map<string, RecordingSurfaceWriter::Record>::const_iterator it;
+    for (it = recording_writer.records.begin(); it != recording_writer.records.end(); it++) {
+        const RecordingSurfaceWriter::Record &record = it->second;
+        
+        int entry = reader.find(it->first);
+        
+        shared_ptr<Surface> surface;
+        vector<string> view_names;
+        vector<MatrixXd, Eigen::aligned_allocator<MatrixXd> > view_data;
+        if (entry < 0 || !reader.read(entry, surface, view_names, view_data)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " " << filename << ": Unable to read " << it->first << endl;
+            cerr << " ******************* " << endl;
+            
+            return false;
+        }
+        
+        double node_delta = 0.0;
+        if (surface->nodes.size() == record.nodes.size()) {
+            for (int i = 0; i < (int) record.nodes.size(); i++)
+                node_delta = max(node_delta, (surface->nodes[i] - record.nodes[i]).norm());
+        } else
+            node_delta = INFINITY;
+        
+        bool view_data_equal = (view_names == record.view_names && view_data.size() == record.view_data.size());
+        for (int k = 0; view_data_equal && k < (int) view_data.size(); k++)
+            view_data_equal = (view_data[k] == record.view_data[k]);
+        
+        if (node_delta > TEST_TOLERANCE || surface->panel_nodes != record.panel_nodes || !view_data_equal) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " " << filename << ": Mismatch in " << it->first << endl;
+            cerr << " node delta = " << node_delta << endl;
+            cerr << " panels equal = " << (surface->panel_nodes == record.panel_nodes) << endl;
+            cerr << " view data equal = " << view_data_equal << endl;
+            cerr << " ******************* " << endl;
+            
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+int
+main (int argc, char **argv)
+{
+    // Set up a pitching and plunging wing:
+    shared_ptr<LiftingSurface> wing = create_wing();
+    
+    shared_ptr<Body> body(new Body(string("wing-body")));
+    body->add_lifting_surface(wing);
+    
+    Solver solver("test-surface-archive-log");
+    solver.add_body(body);
+    
+    Vector3d freestream_velocity(30, 0, 0);
+    solver.set_freestream_velocity(freestream_velocity);
+    solver.set_fluid_density(1.2);
+    
+    body->set_velocity(Vector3d(0, 1.0, 0));
+    body->set_rotational_velocity(Vector3d(0, 0, 0.5));
+    
+    // Log every step into an archive:
+    ArchiveSurfaceWriter archive_writer("test-surface-archive.vxa");
+    RecordingSurfaceWriter recording_writer(archive_writer);
+    
+    double dt = 0.01;
+    
+    solver.initialize_wakes(dt);
+    for (int step_number = 0; step_number < N_STEPS; step_number++) {
+        if (!solver.solve(dt))
+            return 1;
+        
+        solver.log(step_number, recording_writer);
+        
+        // Log the final step twice, to store unchanged geometry:
+        if (step_number == N_STEPS - 1)
+            solver.log(step_number + 1, recording_writer);
+        
+        body->set_position(body->position + dt * body->velocity);
+        body->set_attitude(AngleAxisd(dt * 0.5, Vector3d::UnitZ()) * body->attitude);
+        
+        solver.update_wakes(dt);
+    }
+    
+    if (!archive_writer.close())
+        return 1;
+    
+    if (!compare("test-surface-archive.vxa", recording_writer))
+        return 1;
+    
+    // Remove the index, as if the archive had not been closed, and read it again:
+    ifstream f("test-surface-archive.vxa", ios::binary);
+    stringstream ss;
+    ss << f.rdbuf();
+    f.close();
+    
+    string data = ss.str();
+    
+    ofstream g("test-surface-archive-truncated.vxa", ios::binary);
+    g.write(data.data(), data.size() - 1);
+    g.close();
+    
+    if (!compare("test-surface-archive-truncated.vxa", recording_writer))
+        return 1;
+    
+    return 0;
+}
@@ -0,0 +1,141 @@
+//
+// Vortexje -- Test symmetry plane solver against the full solver for a rectangular wing.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <iostream>
+
+#include <vortexje/solver.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+static const double pi = 3.141592653589793238462643383279502884;
+
+#define HALF_SPAN 1.0
+#define N_STEPS   3
+
+#define TEST_TOLERANCE 1e-6
+
+// Create a rectangular wing, spanning the Z axis from z_min to HALF_SPAN:
+static shared_ptr<LiftingSurface>
+create_wing(double z_min, int n_airfoils)
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface("main"));
+
+    LiftingSurfaceBuilder surface_builder(*wing);
+
+    const int n_points_per_airfoil = 16;
+
+    const double chord = 0.5;
+
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++)
+            airfoil_points[j](2) += z_min + i * (HALF_SPAN - z_min) / (double) (n_airfoils - 1);
+
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+
+    wing->rotate(Vector3d::UnitZ(), -5.0 / 180.0 * pi);
+
+    return wing;
+}
+
+// Run the wing for a few time steps, and log the force and the velocity at a point off the wing:
+static vector<Vector3d, Eigen::aligned_allocator<Vector3d> >
+run_wing(bool symmetry_plane)
+{
+    shared_ptr<LiftingSurface> wing;
+    if (symmetry_plane)
+        wing = create_wing(0.0, 5);
+    else
+        wing = create_wing(-HALF_SPAN, 9);
+
+    shared_ptr<Body> body(new Body(string("wing")));
+    body->add_lifting_surface(wing);
+
+    Solver solver("test-symmetry-plane-log");
+    solver.add_body(body);
+
+    if (symmetry_plane)
+        solver.add_symmetry_plane(Vector3d(0, 0, 0), Vector3d::UnitZ());
+
+    solver.set_freestream_velocity(Vector3d(30, 0, 0));
+    solver.set_fluid_density(1.2);
+
+    double dt = 0.01;
+
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > results;
+
+    solver.initialize_wakes(dt);
+    for (int step = 0; step < N_STEPS; step++) {
+        solver.solve(dt);
+
+        Vector3d F = solver.force(body);
+        if (symmetry_plane) {
+            // Account for the mirrored half:
+            F(0) *= 2;
+            F(1) *= 2;
+            F(2) = 0;
+        }
+        results.push_back(F);
+
+        results.push_back(solver.velocity(Vector3d(0.25, 0.3, 0.5)));
+
+        solver.update_wakes(dt);
+    }
+
+    return results;
+}
+
+int
+main (int argc, char **argv)
+{
+    // Set parameters:
+    Parameters::convect_wake       = true;
+    Parameters::unsteady_bernoulli = true;
+
+    // Run full and half solvers:
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > full_results = run_wing(false);
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > half_results = run_wing(true);
+
+    // Compare:
+    for (int i = 0; i < (int) full_results.size(); i++) {
+        double delta = (full_results[i] - half_results[i]).norm();
+        if (delta > TEST_TOLERANCE * max(full_results[i].norm(), 1.0)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " X(full) = " << full_results[i].transpose() << endl;
+            cerr << " X(symmetry plane) = " << half_results[i].transpose() << endl;
+            cerr << " ******************* " << endl;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+//
+// Vortexje -- Test unique vortex filament evaluation against vortex ring evaluation, for all vortex core models.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <iostream>
+
+#include <vortexje/wake.hpp>
+#include <vortexje/vortex-core-wake.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+#define N_WAKE_LAYERS 6
+
+#define N_POINTS 20
+
+#define TEST_TOLERANCE 1e-12
+
+// Create a rectangular wing, spanning the Z axis:
+static shared_ptr<LiftingSurface>
+create_wing()
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface("main"));
+
+    LiftingSurfaceBuilder surface_builder(*wing);
+
+    const int n_points_per_airfoil = 16;
+    const int n_airfoils = 6;
+
+    const double chord = 0.5;
+    const double span = 2.0;
+
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++)
+            airfoil_points[j](2) += -span / 2.0 + i * span / (double) (n_airfoils - 1);
+
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+
+    return wing;
+}
+
+// Compare the vortex sheet velocities with the sums of the vortex ring velocities:
+static bool
+compare(const Surface &surface, const VectorXd &doublet_coefficients, const Matrix3Xd &points)
+{
+    Matrix3Xd velocities(3, points.cols());
+    surface.vortex_sheet_velocities(points, doublet_coefficients, velocities);
+    
+    for (int j = 0; j < points.cols(); j++) {
+        Vector3d x = points.col(j);
+        
+        Vector3d velocity_ref(0, 0, 0);
+        for (int i = 0; i < doublet_coefficients.size(); i++)
+            velocity_ref += surface.vortex_ring_unit_velocity(x, i) * doublet_coefficients(i);
+            
+        double delta = (velocities.col(j) - velocity_ref).norm();
+        if (delta > TEST_TOLERANCE * max(velocity_ref.norm(), 1.0)) {
+            cerr << " *** TEST FAILED *** " << endl;
+            cerr << " Surface = " << surface.id << endl;
+            cerr << " x = " << x.transpose() << endl;
+            cerr << " V(filaments) = " << velocities.col(j).transpose() << endl;
+            cerr << " V(rings) = " << velocity_ref.transpose() << endl;
+            cerr << " ******************* " << endl;
+            
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+int
+main (int argc, char **argv)
+{
+    // Set parameters:
+    Parameters::wake_vortex_core_radius = 0.05;
+    
+    // Create a wing, and let it shed wakes by moving it forward:
+    shared_ptr<LiftingSurface> wing = create_wing();
+    
+    vector<shared_ptr<Wake> > wakes;
+    wakes.push_back(shared_ptr<Wake>(new Wake(wing)));
+    wakes.push_back(shared_ptr<Wake>(new LambOseenWake(wing)));
+    wakes.push_back(shared_ptr<Wake>(new VatistasWake(wing)));
+    
+    for (int i = 0; i < N_WAKE_LAYERS; i++) {
+        for (int j = 0; j < (int) wakes.size(); j++)
+            wakes[j]->add_layer();
+        
+        wing->translate(Vector3d(-0.1, 0, 0));
+    }
+    
+    // Assign random strengths:
+    VectorXd wing_doublet_coefficients = VectorXd::Random(wing->n_panels());
+    VectorXd wake_doublet_coefficients = VectorXd::Random(wakes[0]->n_panels());
+    
+    // Pick points around the wing, including points close to the wake filaments:
+    Matrix3Xd points = Matrix3Xd::Random(3, N_POINTS);
+    for (int i = 0; i < N_POINTS; i += 2)
+        points.col(i) = wakes[0]->nodes[i % wakes[0]->n_nodes()] + 0.01 * points.col(i);
+        
+    // Compare:
+    if (!compare(*wing, wing_doublet_coefficients, points))
+        return 1;
+    
+    for (int j = 0; j < (int) wakes.size(); j++) {
+        if (!compare(*wakes[j], wake_doublet_coefficients, points))
+            return 1;
+            
+        // Leave out the latest row of wake panels:
+        if (!compare(*wakes[j], wake_doublet_coefficients.head(wakes[j]->n_panels() - wing->n_spanwise_panels()), points))
+            return 1;
+    }
+
+    return 0;
+}
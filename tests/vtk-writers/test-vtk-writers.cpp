@@ -0,0 +1,286 @@
+//
+// Vortexje -- Test binary and XML VTK writers by reading back the written data arrays.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#ifdef VORTEXJE_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <vortexje/solver.hpp>
+#include <vortexje/lifting-surface-builder.hpp>
+#include <vortexje/shape-generators/airfoils/naca4-airfoil-generator.hpp>
+#include <vortexje/surface-writers/vtk-binary-surface-writer.hpp>
+#include <vortexje/surface-writers/vtk-xml-surface-writer.hpp>
+#include <vortexje/field-writers/vtk-binary-field-writer.hpp>
+#include <vortexje/field-writers/vtk-xml-field-writer.hpp>
+#include <vortexje/vtk-binary-data.hpp>
+#include <vortexje/vtk-collection-writer.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+#define TEST_TOLERANCE 1e-12
+
+// Create a rectangular wing, spanning the Z axis:
+static shared_ptr<LiftingSurface>
+create_wing()
+{
+    shared_ptr<LiftingSurface> wing(new LiftingSurface("main"));
+    
+    LiftingSurfaceBuilder surface_builder(*wing);
+    
+    const int n_points_per_airfoil = 16;
+    const int n_airfoils = 6;
+    
+    const double chord = 0.5;
+    const double span = 2.0;
+    
+    int trailing_edge_point_id;
+    vector<int> prev_airfoil_nodes;
+    
+    vector<vector<int> > node_strips;
+    vector<vector<int> > panel_strips;
+    
+    for (int i = 0; i < n_airfoils; i++) {
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> > airfoil_points =
+            NACA4AirfoilGenerator::generate(0, 0, 0.12, true, chord, n_points_per_airfoil, trailing_edge_point_id);
+        for (int j = 0; j < (int) airfoil_points.size(); j++)
+            airfoil_points[j](2) += -span / 2.0 + i * span / (double) (n_airfoils - 1);
+        
+        vector<int> airfoil_nodes = surface_builder.create_nodes_for_points(airfoil_points);
+        node_strips.push_back(airfoil_nodes);
+        
+        if (i > 0) {
+            vector<int> airfoil_panels = surface_builder.create_panels_between_shapes(airfoil_nodes, prev_airfoil_nodes, trailing_edge_point_id);
+            panel_strips.push_back(airfoil_panels);
+        }
+        
+        prev_airfoil_nodes = airfoil_nodes;
+    }
+    
+    surface_builder.finish(node_strips, panel_strips, trailing_edge_point_id);
+    
+    return wing;
+}
+
+// Read a file into memory:
+static string
+read_file(const string &filename)
+{
+    ifstream f(filename.c_str(), ios::binary);
+    
+    stringstream ss;
+    ss << f.rdbuf();
+    
+    return ss.str();
+}
+
+// Read the big-endian doubles following a section header of a legacy binary VTK file:
+static VectorXd
+read_legacy_array(const string &data, const string &header, int n)
+{
+    VectorXd values(n);
+    
+    size_t begin = data.find(header);
+    if (begin == string::npos)
+        return VectorXd();
+    
+    begin = data.find('\n', begin) + 1;
+    for (int i = 0; i < n; i++) {
+        char bytes[sizeof(double)];
+        memcpy(bytes, &data[begin + i * sizeof(double)], sizeof(double));
+        if (!VTKLegacyBinaryData::host_is_big_endian())
+            reverse(bytes, bytes + sizeof(double));
+        memcpy(&values(i), bytes, sizeof(double));
+    }
+    
+    return values;
+}
+
+// Read the doubles of a named appended data array of a VTK XML file:
+static VectorXd
+read_xml_array(const string &data, const string &name, bool compressed)
+{
+    size_t element = data.find("Name=\"" + name + "\"");
+    if (element == string::npos)
+        return VectorXd();
+    
+    size_t offset_begin = data.find("offset=\"", element) + 8;
+    uint64_t offset = strtoull(data.c_str() + offset_begin, NULL, 10);
+    
+    const char *block = data.c_str() + data.find("_", data.find("<AppendedData")) + 1 + offset;
+    
+    uint64_t header[3];
+    memcpy(header, block, sizeof(header));
+    
+    if (!compressed) {
+        VectorXd values(header[0] / sizeof(double));
+        memcpy(values.data(), block + sizeof(uint64_t), header[0]);
+        
+        return values;
+    }
+    
+    vector<char> raw;
+#ifdef VORTEXJE_HAVE_ZLIB
+    uint64_t n_blocks = header[0];
+    
+    vector<uint64_t> compressed_sizes(n_blocks);
+    memcpy(compressed_sizes.data(), block + 3 * sizeof(uint64_t), n_blocks * sizeof(uint64_t));
+    
+    const char *compressed_data = block + (3 + n_blocks) * sizeof(uint64_t);
+    for (uint64_t i = 0; i < n_blocks; i++) {
+        uLongf size = (i == n_blocks - 1 && header[2] > 0) ? header[2] : header[1];
+        
+        size_t begin = raw.size();
+        raw.resize(begin + size);
+        uncompress((Bytef *) &raw[begin], &size, (const Bytef *) compressed_data, compressed_sizes[i]);
+        
+        compressed_data += compressed_sizes[i];
+    }
+#endif
+
+    VectorXd values(raw.size() / sizeof(double));
+    memcpy(values.data(), raw.data(), raw.size());
+    
+    return values;
+}
+
+// Report a mismatch between written and expected values:
+static bool
+check(const VectorXd &values, const VectorXd &values_ref, const string &description)
+{
+    if (values.size() != values_ref.size() || (values - values_ref).cwiseAbs().maxCoeff() > TEST_TOLERANCE) {
+        cerr << " *** TEST FAILED *** " << endl;
+        cerr << " " << description << endl;
+        cerr << " size = " << values.size() << ", expected " << values_ref.size() << endl;
+        cerr << " ******************* " << endl;
+        
+        return false;
+    }
+    
+    return true;
+}
+
+int
+main (int argc, char **argv)
+{
+    shared_ptr<LiftingSurface> wing = create_wing();
+    
+    // Panel data.  The vectors are a block of rows of a larger array, as the solver passes them:
+    MatrixXd scalars = MatrixXd::Random(wing->n_panels(), 1);
+    MatrixXd vectors = MatrixXd::Random(wing->n_panels() + 4, 3);
+    
+    vector<string> view_names;
+    vector<SurfaceWriter::ViewData> view_data;
+    
+    view_names.push_back("Scalar");
+    view_data.push_back(SurfaceWriter::ViewData(scalars.data(), wing->n_panels(), 1, OuterStride<>(wing->n_panels())));
+    
+    view_names.push_back("Vector");
+    view_data.push_back(SurfaceWriter::ViewData(vectors.data() + 2, wing->n_panels(), 3, OuterStride<>(vectors.outerStride())));
+    
+    VectorXd points_ref(3 * wing->n_nodes());
+    for (int i = 0; i < wing->n_nodes(); i++)
+        points_ref.segment<3>(3 * i) = wing->nodes[i];
+    
+    Matrix<double, Dynamic, Dynamic, RowMajor> vector_ref = vectors.middleRows(2, wing->n_panels());
+    
+    // Legacy binary surface file:
+    VTKBinarySurfaceWriter binary_surface_writer;
+    binary_surface_writer.write(wing, "wing.vtk", 0, 0, view_names, view_data);
+    
+    string data = read_file("wing.vtk");
+    if (!check(read_legacy_array(data, "POINTS", 3 * wing->n_nodes()), points_ref, "Binary VTK surface points"))
+        return 1;
+    if (!check(read_legacy_array(data, "LOOKUP_TABLE", wing->n_panels()), scalars, "Binary VTK surface scalars"))
+        return 1;
+    if (!check(read_legacy_array(data, "VECTORS Vector", 3 * wing->n_panels()), Map<VectorXd>(vector_ref.data(), vector_ref.size()), "Binary VTK surface vectors"))
+        return 1;
+    
+    // XML surface files, raw and compressed:
+    for (int compress = 0; compress < 2; compress++) {
+        VTKXMLSurfaceWriter xml_surface_writer(compress);
+        xml_surface_writer.write(wing, "wing.vtu", 0, 0, view_names, view_data);
+        
+        data = read_file("wing.vtu");
+        
+        bool compressed = data.find("vtkZLibDataCompressor") != string::npos;
+        
+        if (!check(read_xml_array(data, "Points", compressed), points_ref, "XML surface points"))
+            return 1;
+        if (!check(read_xml_array(data, "Scalar", compressed), scalars, "XML surface scalars"))
+            return 1;
+        if (!check(read_xml_array(data, "Vector", compressed), Map<VectorXd>(vector_ref.data(), vector_ref.size()), "XML surface vectors"))
+            return 1;
+    }
+    
+    // Field files.  Without bodies, the velocity is the freestream velocity:
+    Solver solver("vtk-writers-log");
+    
+    Vector3d freestream_velocity(1.0, 2.0, 3.0);
+    solver.set_freestream_velocity(freestream_velocity);
+    
+    const int nx = 4, ny = 3, nz = 5;
+    
+    VectorXd velocities_ref(3 * nx * ny * nz);
+    VectorXd velocity_potentials_ref(nx * ny * nz);
+    for (int i = 0; i < nx * ny * nz; i++) {
+        Vector3d x(i % (nx * ny) % nx * 0.5, i % (nx * ny) / nx * 0.5, i / (nx * ny) * 0.5);
+        
+        velocities_ref.segment<3>(3 * i) = freestream_velocity;
+        velocity_potentials_ref(i)       = freestream_velocity.dot(x);
+    }
+    
+    VTKBinaryFieldWriter binary_field_writer;
+    binary_field_writer.write_velocity_and_velocity_potential_field(solver, "field.vtk", 0, 1.5, 0, 1, 0, 2, 0.5, 0.5, 0.5);
+    
+    data = read_file("field.vtk");
+    if (!check(read_legacy_array(data, "VECTORS Velocity", 3 * nx * ny * nz), velocities_ref, "Binary VTK velocity field"))
+        return 1;
+    if (!check(read_legacy_array(data, "LOOKUP_TABLE", nx * ny * nz), velocity_potentials_ref, "Binary VTK velocity potential field"))
+        return 1;
+    
+    for (int compress = 0; compress < 2; compress++) {
+        VTKXMLFieldWriter xml_field_writer(compress);
+        xml_field_writer.write_velocity_and_velocity_potential_field(solver, "field.vti", 0, 1.5, 0, 1, 0, 2, 0.5, 0.5, 0.5);
+        
+        data = read_file("field.vti");
+        
+        bool compressed = data.find("vtkZLibDataCompressor") != string::npos;
+        
+        if (!check(read_xml_array(data, "Velocity", compressed), velocities_ref, "XML velocity field"))
+            return 1;
+        if (!check(read_xml_array(data, "VelocityPotential", compressed), velocity_potentials_ref, "XML velocity potential field"))
+            return 1;
+    }
+    
+    // Collection file:
+    VTKCollectionWriter collection_writer;
+    collection_writer.add_dataset(0.0, "wing.vtu");
+    collection_writer.add_dataset(0.1, "wing.vtu");
+    if (!collection_writer.write("wing.pvd"))
+        return 1;
+    
+    data = read_file("wing.pvd");
+    if (data.find("timestep=\"0.1\" part=\"0\" file=\"wing.vtu\"") == string::npos) {
+        cerr << " *** TEST FAILED *** " << endl;
+        cerr << " VTK collection file" << endl;
+        cerr << " ******************* " << endl;
+        
+        return 1;
+    }
+    
+    return 0;
+}
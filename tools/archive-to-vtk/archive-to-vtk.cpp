@@ -0,0 +1,58 @@
+//
+// Vortexje -- Convert a surface archive into VTK files.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <iostream>
+#include <string>
+
+#include <vortexje/surface-archive-reader.hpp>
+#include <vortexje/surface-writers/vtk-surface-writer.hpp>
+#include <vortexje/surface-writers/vtk-xml-surface-writer.hpp>
+
+using namespace std;
+using namespace Vortexje;
+
+int
+main (int argc, char **argv)
+{
+    if (argc < 2 || argc > 4) {
+        cerr << "Usage: " << argv[0] << " ARCHIVE [PREFIX] [vtk|vtu]" << endl;
+        
+        return 1;
+    }
+    
+    string prefix;
+    if (argc >= 3)
+        prefix = argv[2];
+    
+    string format = "vtu";
+    if (argc >= 4)
+        format = argv[3];
+    
+    SurfaceArchiveReader reader;
+    if (!reader.open(argv[1]))
+        return 1;
+    
+    cout << "archive-to-vtk: " << reader.n_entries() << " steps in " << reader.n_streams() << " streams." << endl;
+    
+    bool success;
+    if (format == "vtk") {
+        VTKSurfaceWriter writer;
+        success = reader.convert(writer, prefix);
+    
+    } else if (format == "vtu") {
+        VTKXMLSurfaceWriter writer(true);
+        success = reader.convert(writer, prefix);
+    
+    } else {
+        cerr << "archive-to-vtk: Unknown format " << format << "." << endl;
+        
+        return 1;
+    }
+    
+    return success ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+//
+// Vortexje -- Anderson acceleration of fixed-point iterations.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <algorithm>
+
+#include <Eigen/QR>
+
+#include <vortexje/anderson-acceleration.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+/**
+   Constructs an Anderson acceleration scheme of depth 1, with an empty history.
+*/
+AndersonAcceleration::AndersonAcceleration() : depth(1)
+{
+}
+
+/**
+   Sets the number of previous iterates that are combined with the latest one.  The history is discarded.
+   
+   @param[in]   depth   Number of previous iterates.
+*/
+void
+AndersonAcceleration::set_depth(int depth)
+{
+    this->depth = max(depth, 0);
+    
+    reset();
+}
+
+/**
+   Discards the history of iterates.
+*/
+void
+AndersonAcceleration::reset()
+{
+    images.clear();
+    residuals.clear();
+}
+
+/**
+   Computes the next iterate, given the latest iterate x and its image G(x).  Both are added to the history.
+   
+   @param[in]   x   Latest iterate.
+   @param[in]   g   Image G(x) of the latest iterate.
+   
+   @returns Next iterate.
+*/
+Eigen::VectorXd
+AndersonAcceleration::next_iterate(const Eigen::VectorXd &x, const Eigen::VectorXd &g)
+{
+    // Discard the history when the dimension changes:
+    if (!images.empty() && images.back().size() != g.size())
+        reset();
+        
+    images.push_back(g);
+    residuals.push_back(g - x);
+    
+    if ((int) images.size() > depth + 1) {
+        images.erase(images.begin());
+        residuals.erase(residuals.begin());
+    }
+    
+    int m = images.size() - 1;
+    if (m == 0)
+        return g;
+        
+    // Minimize the norm of f_k - dF gamma, where the columns of dF are differences of subsequent residuals:
+    MatrixXd dF(g.size(), m), dG(g.size(), m);
+    for (int i = 0; i < m; i++) {
+        dF.col(i) = residuals[i + 1] - residuals[i];
+        dG.col(i) = images[i + 1] - images[i];
+    }
+    
+    VectorXd gamma = dF.colPivHouseholderQr().solve(residuals.back());
+    
+    VectorXd x_next = g - dG * gamma;
+    
+    // Fall back to the plain fixed-point iteration if the least squares problem is degenerate:
+    if (!x_next.allFinite())
+        return g;
+        
+    return x_next;
+}
@@ -0,0 +1,51 @@
+//
+// Vortexje -- Anderson acceleration of fixed-point iterations.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __ANDERSON_ACCELERATION_HPP__
+#define __ANDERSON_ACCELERATION_HPP__
+
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+namespace Vortexje
+{
+
+/**
+   Anderson acceleration of a fixed-point iteration x = G(x).
+   
+   Rather than continuing from G(x_k), the next iterate is the combination of the latest images G(x_k), ..., G(x_{k-m}) that
+   minimizes the norm of the corresponding combination of residuals G(x_i) - x_i.
+   
+   @note See H. F. Walker and P. Ni, Anderson Acceleration for Fixed-Point Iterations, SIAM Journal on Numerical Analysis 49(4), 
+   2011.
+   
+   @brief Anderson acceleration.
+*/
+class AndersonAcceleration
+{
+public:
+    AndersonAcceleration();
+    
+    void set_depth(int depth);
+    
+    void reset();
+    
+    Eigen::VectorXd next_iterate(const Eigen::VectorXd &x, const Eigen::VectorXd &g);
+    
+private:
+    int depth;
+    
+    std::vector<Eigen::VectorXd, Eigen::aligned_allocator<Eigen::VectorXd> > images;
+    std::vector<Eigen::VectorXd, Eigen::aligned_allocator<Eigen::VectorXd> > residuals;
+};
+
+};
+
+#endif // __ANDERSON_ACCELERATION_HPP__
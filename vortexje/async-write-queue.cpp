@@ -0,0 +1,120 @@
+//
+// Vortexje -- Bounded queue of writes, executed by a background thread.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <algorithm>
+
+#include <vortexje/async-write-queue.hpp>
+
+using namespace std;
+using namespace Vortexje;
+
+/**
+   Constructs an empty write queue, and starts the I/O thread.
+   
+   @param[in]   max_length   Maximum number of pending jobs, not counting the job being executed.
+*/
+AsyncWriteQueue::AsyncWriteQueue(int max_length) : max_length(max(max_length, 1)), busy(false), stop(false), success(true)
+{
+    thread = std::thread(&AsyncWriteQueue::run, this);
+}
+
+/**
+   Destructor.  Completes all pending jobs, and stops the I/O thread.
+*/
+AsyncWriteQueue::~AsyncWriteQueue()
+{
+    flush();
+    
+    {
+        unique_lock<std::mutex> lock(mutex);
+        
+        stop = true;
+    }
+    
+    job_available.notify_one();
+    
+    thread.join();
+}
+
+/**
+   Appends a job to the queue.  If the queue is full, this blocks until the I/O thread has taken a job off the queue.
+   
+   @param[in]   job   Function performing the write, returning true on success.
+*/
+void
+AsyncWriteQueue::push(const std::function<bool ()> &job)
+{
+    {
+        unique_lock<std::mutex> lock(mutex);
+        
+        while ((int) jobs.size() >= max_length)
+            space_available.wait(lock);
+        
+        jobs.push_back(job);
+    }
+    
+    job_available.notify_one();
+}
+
+/**
+   Waits until all pending jobs have been completed.
+   
+   @returns true if all jobs completed since the previous flush succeeded.
+*/
+bool
+AsyncWriteQueue::flush()
+{
+    unique_lock<std::mutex> lock(mutex);
+    
+    while (!jobs.empty() || busy)
+        job_done.wait(lock);
+    
+    bool result = success;
+    
+    success = true;
+    
+    return result;
+}
+
+// Main loop of the I/O thread:
+void
+AsyncWriteQueue::run()
+{
+    unique_lock<std::mutex> lock(mutex);
+    
+    while (true) {
+        while (jobs.empty() && !stop)
+            job_available.wait(lock);
+        
+        if (jobs.empty())
+            break;
+        
+        std::function<bool ()> job = std::move(jobs.front());
+        jobs.pop_front();
+        
+        busy = true;
+        
+        space_available.notify_one();
+        
+        // Execute the job without holding the lock, so that new jobs can be pushed in the meantime.  The job, and any
+        // data it holds, is released before the lock is taken again:
+        lock.unlock();
+        
+        bool job_success = job();
+        
+        job = nullptr;
+        
+        lock.lock();
+        
+        busy = false;
+        if (!job_success)
+            success = false;
+        
+        job_done.notify_all();
+    }
+}
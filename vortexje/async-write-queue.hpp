@@ -0,0 +1,65 @@
+//
+// Vortexje -- Bounded queue of writes, executed by a background thread.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __ASYNC_WRITE_QUEUE_HPP__
+#define __ASYNC_WRITE_QUEUE_HPP__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Vortexje
+{
+
+/**
+   Bounded queue of write jobs, executed in order by a single background I/O thread.
+   
+   Pushing a job onto a full queue blocks until the I/O thread has taken a job off the queue.  This bounds the memory
+   held by pending writes, and slows the producer down to the rate at which the disk can keep up.
+   
+   @brief Asynchronous write queue.
+*/
+class AsyncWriteQueue
+{
+public:
+    AsyncWriteQueue(int max_length);
+    
+    ~AsyncWriteQueue();
+    
+    void push(const std::function<bool ()> &job);
+    
+    bool flush();
+
+private:
+    int max_length;
+    
+    std::deque<std::function<bool ()> > jobs;
+    
+    bool busy;
+    bool stop;
+    bool success;
+    
+    std::mutex mutex;
+    std::condition_variable job_available;
+    std::condition_variable space_available;
+    std::condition_variable job_done;
+    
+    std::thread thread;
+    
+    void run();
+    
+    // Write queues cannot be copied:
+    AsyncWriteQueue(const AsyncWriteQueue &);
+    AsyncWriteQueue &operator=(const AsyncWriteQueue &);
+};
+
+};
+
+#endif // __ASYNC_WRITE_QUEUE_HPP__
@@ -109,7 +109,7 @@ Body::panel_neighbors(const std::shared_ptr<Surface> &surface, int panel) const
     
     // List in-surface neighbors:
     for (int i = 0; i < (int) surface->panel_nodes[panel].size(); i++) {
-        vector<pair<int, int> > &edge_neighbors = surface->panel_neighbors[panel][i];
+        vector<pair<int, int> > &edge_neighbors = (*surface->panel_neighbors)[panel][i];
         vector<pair<int, int> >::const_iterator it;
         for (it = edge_neighbors.begin(); it != edge_neighbors.end(); it++)
             neighbors.push_back(SurfacePanelEdge(surface, it->first, it->second));    
@@ -147,7 +147,7 @@ Body::panel_neighbors(const std::shared_ptr<Surface> &surface, int panel, int ed
     
     // List in-surface neighbors:
     {
-        vector<pair<int, int> > &edge_neighbors = surface->panel_neighbors[panel][edge];
+        vector<pair<int, int> > &edge_neighbors = (*surface->panel_neighbors)[panel][edge];
         vector<pair<int, int> >::const_iterator it;
         for (it = edge_neighbors.begin(); it != edge_neighbors.end(); it++)
             neighbors.push_back(SurfacePanelEdge(surface, it->first, it->second));
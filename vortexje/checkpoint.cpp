@@ -0,0 +1,415 @@
+//
+// Vortexje -- Binary checkpoint data.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <vortexje/checkpoint.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+const char CheckpointWriter::checkpoint_magic[8] = { 'V', 'X', 'J', 'C', 'H', 'K', 'P', 'T' };
+
+const uint32_t CheckpointWriter::checkpoint_version = 1;
+
+// Byte order mark:
+static const uint32_t byte_order_mark = 0x01020304;
+
+// Size of the checkpoint header:  identifier, version, and byte order mark.
+static const size_t checkpoint_header_size = sizeof(CheckpointWriter::checkpoint_magic) + 2 * sizeof(uint32_t);
+
+/**
+   Constructs a checkpoint buffer, containing only the file header.
+*/
+CheckpointWriter::CheckpointWriter()
+{
+    buffer.resize(checkpoint_header_size);
+    
+    memcpy(&buffer[0], checkpoint_magic, sizeof(checkpoint_magic));
+    memcpy(&buffer[sizeof(checkpoint_magic)], &checkpoint_version, sizeof(uint32_t));
+    memcpy(&buffer[sizeof(checkpoint_magic) + sizeof(uint32_t)], &byte_order_mark, sizeof(uint32_t));
+}
+
+/**
+   Appends an integer.
+   
+   @param[in]   value   Value to append.
+*/
+void
+CheckpointWriter::write_int(int value)
+{
+    int32_t stored_value = value;
+    
+    buffer.insert(buffer.end(), (const char *) &stored_value, (const char *) &stored_value + sizeof(int32_t));
+}
+
+/**
+   Appends a floating point number.
+   
+   @param[in]   value   Value to append.
+*/
+void
+CheckpointWriter::write_double(double value)
+{
+    write_doubles(&value, 1);
+}
+
+/**
+   Appends a string, preceded by its length.
+   
+   @param[in]   value   Value to append.
+*/
+void
+CheckpointWriter::write_string(const std::string &value)
+{
+    write_int(value.size());
+    
+    buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+/**
+   Appends an array of floating point numbers.  The length of the array is not stored.
+   
+   @param[in]   values     Values to append.
+   @param[in]   n_values   Number of values.
+*/
+void
+CheckpointWriter::write_doubles(const double *values, size_t n_values)
+{
+    buffer.insert(buffer.end(), (const char *) values, (const char *) (values + n_values));
+}
+
+/**
+   Appends a list of points.  The number of points is not stored.
+   
+   @param[in]   points   Points to append.
+*/
+void
+CheckpointWriter::write_points(const std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > &points)
+{
+    for (int i = 0; i < (int) points.size(); i++)
+        write_doubles(points[i].data(), 3);
+}
+
+/**
+   Appends a vector, preceded by its length.
+   
+   @param[in]   vector   Vector to append.
+*/
+void
+CheckpointWriter::write_vector(const Eigen::VectorXd &vector)
+{
+    write_int(vector.size());
+    
+    write_doubles(vector.data(), vector.size());
+}
+
+/**
+   Appends a matrix, preceded by its dimensions.  The entries are stored in column-major order.
+   
+   @param[in]   matrix   Matrix to append.
+*/
+void
+CheckpointWriter::write_matrix(const Eigen::MatrixXd &matrix)
+{
+    write_int(matrix.rows());
+    write_int(matrix.cols());
+    
+    write_doubles(matrix.data(), matrix.size());
+}
+
+/**
+   Writes the checkpoint to a file.  The checkpoint is first written to a temporary file, which then replaces the given file.
+   An existing checkpoint is therefore only lost once the new checkpoint has been written completely.
+   
+   @param[in]   filename   Destination filename.
+   
+   @returns true on success.
+*/
+bool
+CheckpointWriter::save(const std::string &filename) const
+{
+    string temporary_filename = filename + ".tmp";
+    
+    ofstream f;
+    f.open(temporary_filename.c_str(), ios::binary | ios::trunc);
+    if (!f.is_open()) {
+        cerr << "CheckpointWriter: Unable to create " << temporary_filename << "." << endl;
+        
+        return false;
+    }
+    
+    f.write(buffer.data(), buffer.size());
+    
+    f.close();
+    
+    if (!f) {
+        cerr << "CheckpointWriter: Unable to write " << temporary_filename << "." << endl;
+        
+        remove(temporary_filename.c_str());
+        
+        return false;
+    }
+
+#ifdef _WIN32
+    remove(filename.c_str());
+#endif
+
+    if (rename(temporary_filename.c_str(), filename.c_str()) != 0) {
+        cerr << "CheckpointWriter: Unable to rename " << temporary_filename << " to " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+   Constructs an empty, invalid, checkpoint reader.
+*/
+CheckpointReader::CheckpointReader() : position(0), is_valid(false)
+{
+}
+
+/**
+   Reads a checkpoint file into memory, and verifies its header.
+   
+   @param[in]   filename   Checkpoint filename.
+   
+   @returns true on success.
+*/
+bool
+CheckpointReader::load(const std::string &filename)
+{
+    buffer.clear();
+    position = 0;
+    is_valid = false;
+    
+    ifstream f;
+    f.open(filename.c_str(), ios::binary);
+    if (!f.is_open()) {
+        cerr << "CheckpointReader: Unable to open " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    f.seekg(0, ios::end);
+    streamoff size = f.tellg();
+    f.seekg(0, ios::beg);
+    
+    if (size < (streamoff) checkpoint_header_size) {
+        cerr << "CheckpointReader: " << filename << " is not a checkpoint." << endl;
+        
+        return false;
+    }
+    
+    buffer.resize(size);
+    f.read(buffer.data(), size);
+    if (!f) {
+        cerr << "CheckpointReader: Unable to read " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    if (memcmp(buffer.data(), CheckpointWriter::checkpoint_magic, sizeof(CheckpointWriter::checkpoint_magic)) != 0) {
+        cerr << "CheckpointReader: " << filename << " is not a checkpoint." << endl;
+        
+        return false;
+    }
+    
+    uint32_t version, stored_byte_order_mark;
+    memcpy(&version, &buffer[sizeof(CheckpointWriter::checkpoint_magic)], sizeof(uint32_t));
+    memcpy(&stored_byte_order_mark, &buffer[sizeof(CheckpointWriter::checkpoint_magic) + sizeof(uint32_t)], sizeof(uint32_t));
+    
+    if (stored_byte_order_mark != byte_order_mark) {
+        cerr << "CheckpointReader: " << filename << " was written on a host of different byte order." << endl;
+        
+        return false;
+    }
+    
+    if (version != CheckpointWriter::checkpoint_version) {
+        cerr << "CheckpointReader: " << filename << " has unsupported version " << version << "." << endl;
+        
+        return false;
+    }
+    
+    position = checkpoint_header_size;
+    is_valid = true;
+    
+    return true;
+}
+
+/**
+   Returns true if all reads so far succeeded.
+   
+   @returns true if all reads so far succeeded.
+*/
+bool
+CheckpointReader::valid() const
+{
+    return is_valid;
+}
+
+/**
+   Returns true if the entire checkpoint has been read.
+   
+   @returns true if the entire checkpoint has been read.
+*/
+bool
+CheckpointReader::at_end() const
+{
+    return position == buffer.size();
+}
+
+// Copies raw bytes out of the checkpoint, or invalidates the reader if there are not enough bytes left:
+bool
+CheckpointReader::read_bytes(char *data, size_t size)
+{
+    if (!is_valid || size > buffer.size() - position) {
+        is_valid = false;
+        
+        memset(data, 0, size);
+        
+        return false;
+    }
+    
+    memcpy(data, &buffer[position], size);
+    position += size;
+    
+    return true;
+}
+
+/**
+   Reads an integer.
+   
+   @returns Value read.
+*/
+int
+CheckpointReader::read_int()
+{
+    int32_t value;
+    read_bytes((char *) &value, sizeof(int32_t));
+    
+    return value;
+}
+
+/**
+   Reads a floating point number.
+   
+   @returns Value read.
+*/
+double
+CheckpointReader::read_double()
+{
+    double value;
+    read_doubles(&value, 1);
+    
+    return value;
+}
+
+/**
+   Reads a string, preceded by its length.
+   
+   @returns Value read.
+*/
+std::string
+CheckpointReader::read_string()
+{
+    int size = read_int();
+    if (!is_valid || size < 0 || (size_t) size > buffer.size() - position) {
+        is_valid = false;
+        
+        return string();
+    }
+    
+    string value(&buffer[position], size);
+    position += size;
+    
+    return value;
+}
+
+/**
+   Reads an array of floating point numbers.
+   
+   @param[out]  values     Values read.
+   @param[in]   n_values   Number of values.
+*/
+void
+CheckpointReader::read_doubles(double *values, size_t n_values)
+{
+    read_bytes((char *) values, n_values * sizeof(double));
+}
+
+/**
+   Reads a list of points.
+   
+   @param[out]  points     Points read.
+   @param[in]   n_points   Number of points.
+*/
+void
+CheckpointReader::read_points(std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > &points, int n_points)
+{
+    if (!is_valid || n_points < 0 || (size_t) n_points > (buffer.size() - position) / (3 * sizeof(double))) {
+        is_valid = false;
+        
+        points.clear();
+        
+        return;
+    }
+    
+    points.resize(n_points);
+    for (int i = 0; i < n_points; i++)
+        read_doubles(points[i].data(), 3);
+}
+
+/**
+   Reads a vector, preceded by its length.
+   
+   @param[out]  vector   Vector read.
+*/
+void
+CheckpointReader::read_vector(Eigen::VectorXd &vector)
+{
+    int size = read_int();
+    if (!is_valid || size < 0 || (size_t) size > (buffer.size() - position) / sizeof(double)) {
+        is_valid = false;
+        
+        vector.resize(0);
+        
+        return;
+    }
+    
+    vector.resize(size);
+    read_doubles(vector.data(), size);
+}
+
+/**
+   Reads a matrix, preceded by its dimensions.
+   
+   @param[out]  matrix   Matrix read.
+*/
+void
+CheckpointReader::read_matrix(Eigen::MatrixXd &matrix)
+{
+    int rows = read_int();
+    int cols = read_int();
+    if (!is_valid || rows < 0 || cols < 0 || (cols > 0 && (size_t) rows > (buffer.size() - position) / sizeof(double) / cols)) {
+        is_valid = false;
+        
+        matrix.resize(0, 0);
+        
+        return;
+    }
+    
+    matrix.resize(rows, cols);
+    read_doubles(matrix.data(), matrix.size());
+}
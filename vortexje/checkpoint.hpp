@@ -0,0 +1,111 @@
+//
+// Vortexje -- Binary checkpoint data.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __CHECKPOINT_HPP__
+#define __CHECKPOINT_HPP__
+
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+namespace Vortexje
+{
+
+/**
+   Buffer to which the state of a solver is serialized, before it is written to a checkpoint file in one go.
+   
+   Values are stored in the byte order of the host.  A byte order mark in the file header allows the CheckpointReader to
+   reject checkpoints written on a host of different byte order.
+   
+   @brief Checkpoint writer.
+*/
+class CheckpointWriter
+{
+public:
+    /**
+       Checkpoint file identifier.
+    */
+    static const char checkpoint_magic[8];
+    
+    /**
+       Checkpoint format version.
+    */
+    static const uint32_t checkpoint_version;
+    
+    CheckpointWriter();
+    
+    void write_int(int value);
+    
+    void write_double(double value);
+    
+    void write_string(const std::string &value);
+    
+    void write_doubles(const double *values, size_t n_values);
+    
+    void write_points(const std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > &points);
+    
+    void write_vector(const Eigen::VectorXd &vector);
+    
+    void write_matrix(const Eigen::MatrixXd &matrix);
+    
+    bool save(const std::string &filename) const;
+
+private:
+    std::vector<char> buffer;
+};
+
+/**
+   Reader for checkpoint files written by the CheckpointWriter.
+   
+   Reading past the end of the checkpoint, or reading a malformed size, invalidates the reader.  Once invalid, all reads
+   return zeros, so that callers need only check valid() after a sequence of reads.
+   
+   @brief Checkpoint reader.
+*/
+class CheckpointReader
+{
+public:
+    CheckpointReader();
+    
+    bool load(const std::string &filename);
+    
+    bool valid() const;
+    
+    bool at_end() const;
+    
+    int read_int();
+    
+    double read_double();
+    
+    std::string read_string();
+    
+    void read_doubles(double *values, size_t n_values);
+    
+    void read_points(std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > &points, int n_points);
+    
+    void read_vector(Eigen::VectorXd &vector);
+    
+    void read_matrix(Eigen::MatrixXd &matrix);
+
+private:
+    std::vector<char> buffer;
+    
+    size_t position;
+    
+    bool is_valid;
+    
+    bool read_bytes(char *data, size_t size);
+};
+
+};
+
+#endif // __CHECKPOINT_HPP__
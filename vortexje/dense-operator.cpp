@@ -0,0 +1,117 @@
+//
+// Vortexje -- Dense linear operator.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <vortexje/dense-operator.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+/**
+   Constructs a linear operator for a dense matrix.  The matrix is not copied, and must outlive the operator.
+   
+   @param[in]   A   Square matrix.
+*/
+DenseOperator::DenseOperator(const Eigen::MatrixXd &A) : A(A)
+{
+}
+
+/**
+   Returns the number of rows.
+   
+   @returns Number of rows.
+*/
+Eigen::Index
+DenseOperator::rows() const
+{
+    return A.rows();
+}
+
+/**
+   Returns the number of columns.
+   
+   @returns Number of columns.
+*/
+Eigen::Index
+DenseOperator::cols() const
+{
+    return A.cols();
+}
+
+/**
+   Computes the matrix-vector product y = A x, using all threads.
+   
+   @param[in]   x   Vector.
+   @param[out]  y   Product.
+*/
+void
+DenseOperator::multiply(const Eigen::VectorXd &x, Eigen::VectorXd &y) const
+{
+    y.resize(A.rows());
+    
+    multiply(A, x, y);
+}
+
+/**
+   Returns the diagonal.
+   
+   @returns Diagonal.
+*/
+Eigen::VectorXd
+DenseOperator::diagonal() const
+{
+    return A.diagonal();
+}
+
+/**
+   Computes the matrix-vector product y = A x for a general dense matrix, using all threads.  Every thread multiplies the 
+   rows assigned to it by thread_rows().  When called from within a parallel region, the product is computed by the calling 
+   thread only.
+   
+   @param[in]   A   Matrix.
+   @param[in]   x   Vector.
+   @param[out]  y   Product, of the correct size.
+*/
+void
+DenseOperator::multiply(const Eigen::Ref<const Eigen::MatrixXd> &A, const Eigen::VectorXd &x, Eigen::Ref<Eigen::VectorXd> y)
+{
+    #pragma omp parallel
+    {
+        int begin, end;
+        thread_rows(A.rows(), begin, end);
+        
+        // For a column-major matrix, the block of rows is read as a sequence of contiguous column segments, which the 
+        // hardware prefetcher follows without further help:
+        y.segment(begin, end - begin).noalias() = A.middleRows(begin, end - begin) * x;
+    }
+}
+
+/**
+   Returns the block of rows assigned to the calling thread, when partitioning a matrix among the threads of the current
+   team.  The rows are divided as evenly as possible, in thread order.
+   
+   @param[in]   rows    Number of rows of the matrix.
+   @param[out]  begin   Index of the first row.
+   @param[out]  end     Index of the row after the last row.
+*/
+void
+DenseOperator::thread_rows(int rows, int &begin, int &end)
+{
+    int thread = 0, n_threads = 1;
+#ifdef _OPENMP
+    thread    = omp_get_thread_num();
+    n_threads = omp_get_num_threads();
+#endif
+
+    begin = (int) ((long) rows * thread / n_threads);
+    end   = (int) ((long) rows * (thread + 1) / n_threads);
+}
@@ -0,0 +1,53 @@
+//
+// Vortexje -- Dense linear operator.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __DENSE_OPERATOR_HPP__
+#define __DENSE_OPERATOR_HPP__
+
+#include <Eigen/Core>
+
+#include <vortexje/linear-operator.hpp>
+
+namespace Vortexje
+{
+
+/**
+   Linear operator wrapping a dense, in-core, matrix.  The matrix-vector product is computed by all threads, each of which
+   multiplies a contiguous block of rows.
+   
+   The rows are partitioned among the threads as by thread_rows().  For a column-major matrix, a block of rows is a contiguous
+   segment of every column.  When every thread zeroes its own block of rows first, as is done for the matrices of influence
+   coefficients, the segments are placed on the NUMA node of the thread that multiplies them, apart from the pages on which
+   the segments of two threads meet.
+   
+   @brief Dense linear operator.
+*/
+class DenseOperator : public LinearOperator
+{
+public:
+    DenseOperator(const Eigen::MatrixXd &A);
+    
+    Eigen::Index rows() const;
+    
+    Eigen::Index cols() const;
+    
+    void multiply(const Eigen::VectorXd &x, Eigen::VectorXd &y) const;
+    
+    Eigen::VectorXd diagonal() const;
+    
+    static void multiply(const Eigen::Ref<const Eigen::MatrixXd> &A, const Eigen::VectorXd &x, Eigen::Ref<Eigen::VectorXd> y);
+    
+    static void thread_rows(int rows, int &begin, int &end);
+    
+private:
+    const Eigen::MatrixXd &A;
+};
+
+};
+
+#endif // __DENSE_OPERATOR_HPP__
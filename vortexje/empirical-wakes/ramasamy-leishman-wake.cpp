@@ -7,6 +7,7 @@
 //
 
 #include <cmath>
+#include <iostream>
 
 #include <vortexje/empirical-wakes/ramasamy-leishman-wake.hpp>
 #include <vortexje/parameters.hpp>
@@ -99,6 +100,10 @@ RamasamyLeishmanWake::add_layer()
                 edge_lengths.push_back(edge.norm());
             }
             base_edge_lengths.push_back(edge_lengths);
+            
+            // Add core profile coefficients:
+            core_coefficients.push_back(CoreCoefficients());
+            update_core_coefficients(panel);
         }
     }
 }
@@ -122,57 +127,8 @@ RamasamyLeishmanWake::vortex_ring_unit_velocity(const Eigen::Vector3d &x, int th
         return this->Surface::vortex_ring_unit_velocity(x, this_panel);
     }
      
-    // Compute vortex Reynolds number:                          
-    double vortex_reynolds_number = doublet_coefficients[this_panel] / RamasamyLeishmanWake::Parameters::fluid_kinematic_viscosity;
-    
-    // Interpolate Ramasamy-Leishman series values piecewise-linearly:
-    int less_than_idx;
-    for (less_than_idx = 0; less_than_idx < 12; less_than_idx++) {
-        ramasamy_leishman_data_row &row = ramasamy_leishman_data[less_than_idx];
-        
-        if (vortex_reynolds_number < row.vortex_reynolds_number)
-            break;
-    }
-    
-    double a[3];
-    double b[3];
-    if (less_than_idx == 0) {
-        a[0] = ramasamy_leishman_data[0].a_1;
-        a[1] = ramasamy_leishman_data[0].a_2;
-        
-        b[0] = ramasamy_leishman_data[0].b_1;
-        b[1] = ramasamy_leishman_data[0].b_2;
-        b[2] = ramasamy_leishman_data[0].b_3;
-    } else if (less_than_idx == 12) {
-        a[0] = ramasamy_leishman_data[11].a_1;
-        a[1] = ramasamy_leishman_data[11].a_2;
-        
-        b[0] = ramasamy_leishman_data[11].b_1;
-        b[1] = ramasamy_leishman_data[11].b_2;
-        b[2] = ramasamy_leishman_data[11].b_3;
-    } else {
-        double one_over_delta_vortex_reynolds_number =
-            1.0 / (ramasamy_leishman_data[less_than_idx].vortex_reynolds_number - ramasamy_leishman_data[less_than_idx - 1].vortex_reynolds_number);
-        double x = vortex_reynolds_number - ramasamy_leishman_data[less_than_idx - 1].vortex_reynolds_number;
-        double slope;
-        
-        slope = (ramasamy_leishman_data[less_than_idx].a_1 - ramasamy_leishman_data[less_than_idx - 1].a_1) * one_over_delta_vortex_reynolds_number;
-        a[0] = ramasamy_leishman_data[less_than_idx - 1].a_1 + slope * x;
-        
-        slope = (ramasamy_leishman_data[less_than_idx].a_2 - ramasamy_leishman_data[less_than_idx - 1].a_2) * one_over_delta_vortex_reynolds_number;
-        a[1] = ramasamy_leishman_data[less_than_idx - 1].a_2 + slope * x;
-        
-        slope = (ramasamy_leishman_data[less_than_idx].b_1 - ramasamy_leishman_data[less_than_idx - 1].b_1) * one_over_delta_vortex_reynolds_number;
-        b[0] = ramasamy_leishman_data[less_than_idx - 1].b_1 + slope * x;
-        
-        slope = (ramasamy_leishman_data[less_than_idx].b_2 - ramasamy_leishman_data[less_than_idx - 1].b_2) * one_over_delta_vortex_reynolds_number;
-        b[1] = ramasamy_leishman_data[less_than_idx - 1].b_2 + slope * x;
-        
-        slope = (ramasamy_leishman_data[less_than_idx].b_3 - ramasamy_leishman_data[less_than_idx - 1].b_3) * one_over_delta_vortex_reynolds_number;
-        b[2] = ramasamy_leishman_data[less_than_idx - 1].b_3 + slope * x;
-    }
-    
-    a[2] = 1 - a[0] - a[1];
+    // Look up the core profile coefficients:
+    const CoreCoefficients &coefficients = core_coefficients[this_panel];
     
     // Compute velocity:
     Vector3d velocity(0, 0, 0);
@@ -187,36 +143,64 @@ RamasamyLeishmanWake::vortex_ring_unit_velocity(const Eigen::Vector3d &x, int th
         const Vector3d &node_a = nodes[panel_nodes[this_panel][previous_idx]];
         const Vector3d &node_b = nodes[panel_nodes[this_panel][i]];
         
-        Vector3d r_0 = node_b - node_a;
-        Vector3d r_1 = node_a - x;
-        Vector3d r_2 = node_b - x;
-        
-        double r_0_norm = r_0.norm();
-        double r_1_norm = r_1.norm();
-        double r_2_norm = r_2.norm();
-        
-        Vector3d r_1xr_2 = r_1.cross(r_2);
-        double r_1xr_2_sqnorm = r_1xr_2.squaredNorm();
-        double r_1xr_2_norm = sqrt(r_1xr_2_sqnorm);
+        RamasamyLeishmanVortexCore core_model(coefficients.a, coefficients.b, coefficients.one_over_core_radius_squared[i]);
         
-        if (r_0_norm < Vortexje::Parameters::zero_threshold ||
-            r_1_norm < Vortexje::Parameters::zero_threshold ||
-            r_2_norm < Vortexje::Parameters::zero_threshold ||
-            r_1xr_2_sqnorm < Vortexje::Parameters::zero_threshold)
+        velocity += vortex_filament_velocity(x, node_a, node_b, core_model);
+    }
+
+    return one_over_4pi * velocity;
+}
+
+/**
+   Computes the velocities induced by the vortex sheet formed by the Ramasamy-Leishman vortex rings, for a batch of points.
+   
+   The vortex core radii are maintained per vortex ring edge, and the core profile depends on the strength of the vortex
+   ring.  Filaments shared by adjacent rings can therefore not be merged, and the rings are evaluated individually.
+   
+   @param[in]   points                 Points at which the velocity is evaluated, one per column.
+   @param[in]   doublet_coefficients   Strengths of the vortex rings.  Panels beyond the length of this vector have zero strength.
+   @param[out]  velocities             Velocities induced by the vortex sheet, one per column.
+*/
+void
+RamasamyLeishmanWake::vortex_sheet_velocities(const Eigen::Ref<const Eigen::Matrix3Xd> &points, const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients,
+                                              Eigen::Ref<Eigen::Matrix3Xd> velocities) const
+{
+    velocities.setZero();
+    
+    int n_old_panels = n_panels() - lifting_surface->n_spanwise_panels();
+    
+    for (int i = 0; i < doublet_coefficients.size(); i++) {
+        if (doublet_coefficients(i) == 0.0)
             continue;
             
-        double d = r_1xr_2_norm / r_0_norm;
+        const CoreCoefficients &coefficients = core_coefficients[i];
         
-        double dr = pow(d / vortex_core_radii[this_panel][i], 2);
+        for (int j = 0; j < (int) panel_nodes[i].size(); j++) {
+            int previous_j;
+            if (j == 0)
+                previous_j = panel_nodes[i].size() - 1;
+            else
+                previous_j = j - 1;
+                
+            const Vector3d &node_a = nodes[panel_nodes[i][previous_j]];
+            const Vector3d &node_b = nodes[panel_nodes[i][j]];
             
-        double sum = 0;
-        for (int j = 0; j < 3; j++)
-            sum += a[j] * exp(-b[j] * dr);
-
-        velocity += (1 - sum) * r_1xr_2 / r_1xr_2_sqnorm * r_0.dot(r_1 / r_1_norm - r_2 / r_2_norm);
+            if (i >= n_old_panels) {
+                // This panel is contained in the latest row of wake panels.  To satisfy the Kutta condition
+                // exactly, we use the unmodified vortex ring unit velocity here.
+                for (int k = 0; k < points.cols(); k++)
+                    velocities.col(k) += vortex_filament_velocity(points.col(k), node_a, node_b, FreeVortexCore()) * doublet_coefficients(i);
+                    
+            } else {
+                RamasamyLeishmanVortexCore core_model(coefficients.a, coefficients.b, coefficients.one_over_core_radius_squared[j]);
+                
+                for (int k = 0; k < points.cols(); k++)
+                    velocities.col(k) += vortex_filament_velocity(points.col(k), node_a, node_b, core_model) * doublet_coefficients(i);
+            }
+        }
     }
-
-    return one_over_4pi * velocity;
+    
+    velocities *= one_over_4pi;
 }
 
 /**
@@ -273,7 +257,142 @@ RamasamyLeishmanWake::update_properties(double dt)
     #pragma omp parallel
     {
         #pragma omp for schedule(dynamic, 1)
-        for (i = 0; i < n_panels(); i++)
+        for (i = 0; i < n_panels(); i++) {
             update_vortex_ring_radii(i, dt);
+            
+            update_core_coefficients(i);
+        }
+    }
+}
+
+/**
+   Appends the state of this wake to a checkpoint.  In addition to the state of the wake, this comprises the vortex core radii,
+   the base edge lengths, and the core profile coefficients.
+   
+   @param[in]   checkpoint   Checkpoint to append to.
+*/
+void
+RamasamyLeishmanWake::save_state(CheckpointWriter &checkpoint) const
+{
+    this->Wake::save_state(checkpoint);
+    
+    for (int i = 0; i < n_panels(); i++) {
+        checkpoint.write_doubles(vortex_core_radii[i].data(), 4);
+        checkpoint.write_doubles(base_edge_lengths[i].data(), 4);
+        
+        const CoreCoefficients &coefficients = core_coefficients[i];
+        checkpoint.write_doubles(coefficients.a, 3);
+        checkpoint.write_doubles(coefficients.b, 3);
+        checkpoint.write_doubles(coefficients.one_over_core_radius_squared, 4);
     }
 }
+
+/**
+   Restores the state of this wake from a checkpoint written by save_state().
+   
+   The core profile coefficients of the latest row of panels date from the time the row was added, and are not recomputed
+   from the current doublet distribution.  They are therefore restored as stored.
+   
+   @param[in]   checkpoint   Checkpoint to read from.
+   
+   @returns true on success.
+*/
+bool
+RamasamyLeishmanWake::load_state(CheckpointReader &checkpoint)
+{
+    if (!this->Wake::load_state(checkpoint))
+        return false;
+        
+    vortex_core_radii.assign(n_panels(), vector<double>(4));
+    base_edge_lengths.assign(n_panels(), vector<double>(4));
+    core_coefficients.resize(n_panels());
+    
+    for (int i = 0; i < n_panels(); i++) {
+        checkpoint.read_doubles(vortex_core_radii[i].data(), 4);
+        checkpoint.read_doubles(base_edge_lengths[i].data(), 4);
+        
+        CoreCoefficients &coefficients = core_coefficients[i];
+        checkpoint.read_doubles(coefficients.a, 3);
+        checkpoint.read_doubles(coefficients.b, 3);
+        checkpoint.read_doubles(coefficients.one_over_core_radius_squared, 4);
+    }
+    
+    if (!checkpoint.valid()) {
+        cerr << "RamasamyLeishmanWake " << id << ": Checkpoint is truncated." << endl;
+        
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+   Updates the Ramasamy-Leishman core profile coefficients of a vortex ring, by interpolating the series data for the vortex
+   Reynolds number of the ring.
+  
+   @param[in]   panel   Panel number.
+   
+   @note See M. Ramasamy and J. G. Leishman, Reynolds Number Based Blade Tip Vortex Model, University of Maryland, 2005.
+*/
+void
+RamasamyLeishmanWake::update_core_coefficients(int panel)
+{
+    CoreCoefficients &coefficients = core_coefficients[panel];
+    
+    // Compute vortex Reynolds number:                          
+    double vortex_reynolds_number = doublet_coefficients[panel] / RamasamyLeishmanWake::Parameters::fluid_kinematic_viscosity;
+    
+    // Interpolate Ramasamy-Leishman series values piecewise-linearly:
+    int less_than_idx;
+    for (less_than_idx = 0; less_than_idx < 12; less_than_idx++) {
+        ramasamy_leishman_data_row &row = ramasamy_leishman_data[less_than_idx];
+        
+        if (vortex_reynolds_number < row.vortex_reynolds_number)
+            break;
+    }
+    
+    double *a = coefficients.a;
+    double *b = coefficients.b;
+    if (less_than_idx == 0) {
+        a[0] = ramasamy_leishman_data[0].a_1;
+        a[1] = ramasamy_leishman_data[0].a_2;
+        
+        b[0] = ramasamy_leishman_data[0].b_1;
+        b[1] = ramasamy_leishman_data[0].b_2;
+        b[2] = ramasamy_leishman_data[0].b_3;
+    } else if (less_than_idx == 12) {
+        a[0] = ramasamy_leishman_data[11].a_1;
+        a[1] = ramasamy_leishman_data[11].a_2;
+        
+        b[0] = ramasamy_leishman_data[11].b_1;
+        b[1] = ramasamy_leishman_data[11].b_2;
+        b[2] = ramasamy_leishman_data[11].b_3;
+    } else {
+        double one_over_delta_vortex_reynolds_number =
+            1.0 / (ramasamy_leishman_data[less_than_idx].vortex_reynolds_number - ramasamy_leishman_data[less_than_idx - 1].vortex_reynolds_number);
+        double x = vortex_reynolds_number - ramasamy_leishman_data[less_than_idx - 1].vortex_reynolds_number;
+        double slope;
+        
+        slope = (ramasamy_leishman_data[less_than_idx].a_1 - ramasamy_leishman_data[less_than_idx - 1].a_1) * one_over_delta_vortex_reynolds_number;
+        a[0] = ramasamy_leishman_data[less_than_idx - 1].a_1 + slope * x;
+        
+        slope = (ramasamy_leishman_data[less_than_idx].a_2 - ramasamy_leishman_data[less_than_idx - 1].a_2) * one_over_delta_vortex_reynolds_number;
+        a[1] = ramasamy_leishman_data[less_than_idx - 1].a_2 + slope * x;
+        
+        slope = (ramasamy_leishman_data[less_than_idx].b_1 - ramasamy_leishman_data[less_than_idx - 1].b_1) * one_over_delta_vortex_reynolds_number;
+        b[0] = ramasamy_leishman_data[less_than_idx - 1].b_1 + slope * x;
+        
+        slope = (ramasamy_leishman_data[less_than_idx].b_2 - ramasamy_leishman_data[less_than_idx - 1].b_2) * one_over_delta_vortex_reynolds_number;
+        b[1] = ramasamy_leishman_data[less_than_idx - 1].b_2 + slope * x;
+        
+        slope = (ramasamy_leishman_data[less_than_idx].b_3 - ramasamy_leishman_data[less_than_idx - 1].b_3) * one_over_delta_vortex_reynolds_number;
+        b[2] = ramasamy_leishman_data[less_than_idx - 1].b_3 + slope * x;
+    }
+    
+    a[2] = 1 - a[0] - a[1];
+    
+    // Store inverse squared core radii:
+    for (int i = 0; i < 4; i++)
+        coefficients.one_over_core_radius_squared[i] = 1.0 / pow(vortex_core_radii[panel][i], 2);
+}
+
@@ -32,7 +32,13 @@ public:
     
     void update_properties(double dt);
     
+    void save_state(CheckpointWriter &checkpoint) const;
+    bool load_state(CheckpointReader &checkpoint);
+    
     Eigen::Vector3d vortex_ring_unit_velocity(const Eigen::Vector3d &x, int this_panel) const;
+    
+    void vortex_sheet_velocities(const Eigen::Ref<const Eigen::Matrix3Xd> &points, const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients,
+                                 Eigen::Ref<Eigen::Matrix3Xd> velocities) const;
 
     /**
        Radii of the vortex filaments forming the vortex rings.
@@ -86,7 +92,39 @@ private:
     */
     std::vector<std::vector<double> > base_edge_lengths;
     
+    /**
+       Ramasamy-Leishman core profile coefficients of a vortex ring, interpolated for its vortex Reynolds number.
+       
+       @brief Core profile coefficients.
+    */
+    class CoreCoefficients
+    {
+    public:
+        /**
+           Series coefficients a_1, a_2, a_3.
+        */
+        double a[3];
+        
+        /**
+           Series coefficients b_1, b_2, b_3.
+        */
+        double b[3];
+        
+        /**
+           Inverse squared core radii of the vortex filaments forming the vortex ring.
+        */
+        double one_over_core_radius_squared[4];
+    };
+    
+    /**
+       Panel number to core profile coefficients map.  The coefficients depend only on the strength and the core radii of the 
+       vortex rings, and are therefore computed once per time step, in update_properties().
+    */
+    std::vector<CoreCoefficients> core_coefficients;
+    
     void update_vortex_ring_radii(int panel, double dt);
+    
+    void update_core_coefficients(int panel);
 };
 
 };
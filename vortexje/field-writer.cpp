@@ -0,0 +1,199 @@
+//
+// Vortexje -- Field writer base class.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <iostream>
+
+#include <vortexje/field-writer.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+/**
+   Logs the velocity vector field for a specified grid.
+   
+   @param[in]   solver     Solver whose state to output.
+   @param[in]   filename   Destination filename.
+   @param[in]   x_min      Minimum X coordinate of grid.
+   @param[in]   x_max      Maximum X coordinate of grid.
+   @param[in]   y_min      Minimum Y coordinate of grid.
+   @param[in]   y_max      Maximum Y coordinate of grid.
+   @param[in]   z_min      Minimum Z coordinate of grid.
+   @param[in]   z_max      Maximum Z coordinate of grid.
+   @param[in]   dx         Grid step size in X-direction.
+   @param[in]   dy         Grid step size in Y-direction.
+   @param[in]   dz         Grid step size in Z-direction.
+   
+   @returns true on success.
+*/
+bool
+FieldWriter::write_velocity_field(const Solver &solver, const std::string &filename,
+                                  double x_min, double x_max,
+                                  double y_min, double y_max,
+                                  double z_min, double z_max,
+                                  double dx, double dy, double dz)
+{
+    int nx = grid_size(x_min, x_max, dx);
+    int ny = grid_size(y_min, y_max, dy);
+    int nz = grid_size(z_min, z_max, dz);
+    
+    // Compute velocity vector field:
+    cout << "FieldWriter: Computing velocity vector field." << endl;
+    
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > velocities;
+    compute_fields(solver, x_min, y_min, z_min, dx, dy, dz, nx, ny, nz, &velocities, NULL);
+    
+    // Save:
+    return write_fields(filename, x_min, y_min, z_min, dx, dy, dz, nx, ny, nz, &velocities, NULL);
+}
+
+/**
+   Logs the velocity potential scalar field for a specified grid.
+   
+   @param[in]   solver     Solver whose state to output.
+   @param[in]   filename   Destination filename.
+   @param[in]   x_min      Minimum X coordinate of grid.
+   @param[in]   x_max      Maximum X coordinate of grid.
+   @param[in]   y_min      Minimum Y coordinate of grid.
+   @param[in]   y_max      Maximum Y coordinate of grid.
+   @param[in]   z_min      Minimum Z coordinate of grid.
+   @param[in]   z_max      Maximum Z coordinate of grid.
+   @param[in]   dx         Grid step size in X-direction.
+   @param[in]   dy         Grid step size in Y-direction.
+   @param[in]   dz         Grid step size in Z-direction.
+   
+   @returns true on success.
+*/
+bool
+FieldWriter::write_velocity_potential_field(const Solver &solver, const std::string &filename,
+                                            double x_min, double x_max,
+                                            double y_min, double y_max,
+                                            double z_min, double z_max,
+                                            double dx, double dy, double dz)
+{
+    int nx = grid_size(x_min, x_max, dx);
+    int ny = grid_size(y_min, y_max, dy);
+    int nz = grid_size(z_min, z_max, dz);
+    
+    // Compute velocity potential field:
+    cout << "FieldWriter: Computing velocity potential field." << endl;
+    
+    vector<double> velocity_potentials;
+    compute_fields(solver, x_min, y_min, z_min, dx, dy, dz, nx, ny, nz, NULL, &velocity_potentials);
+    
+    // Save:
+    return write_fields(filename, x_min, y_min, z_min, dx, dy, dz, nx, ny, nz, NULL, &velocity_potentials);
+}
+
+/**
+   Logs the velocity vector field and the velocity potential scalar field for a specified grid, computing both
+   quantities in a single pass over the grid.
+   
+   @param[in]   solver     Solver whose state to output.
+   @param[in]   filename   Destination filename.
+   @param[in]   x_min      Minimum X coordinate of grid.
+   @param[in]   x_max      Maximum X coordinate of grid.
+   @param[in]   y_min      Minimum Y coordinate of grid.
+   @param[in]   y_max      Maximum Y coordinate of grid.
+   @param[in]   z_min      Minimum Z coordinate of grid.
+   @param[in]   z_max      Maximum Z coordinate of grid.
+   @param[in]   dx         Grid step size in X-direction.
+   @param[in]   dy         Grid step size in Y-direction.
+   @param[in]   dz         Grid step size in Z-direction.
+   
+   @returns true on success.
+*/
+bool
+FieldWriter::write_velocity_and_velocity_potential_field(const Solver &solver, const std::string &filename,
+                                                         double x_min, double x_max,
+                                                         double y_min, double y_max,
+                                                         double z_min, double z_max,
+                                                         double dx, double dy, double dz)
+{
+    int nx = grid_size(x_min, x_max, dx);
+    int ny = grid_size(y_min, y_max, dy);
+    int nz = grid_size(z_min, z_max, dz);
+    
+    // Compute velocity vector and velocity potential fields:
+    cout << "FieldWriter: Computing velocity vector and velocity potential fields." << endl;
+    
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > velocities;
+    vector<double> velocity_potentials;
+    compute_fields(solver, x_min, y_min, z_min, dx, dy, dz, nx, ny, nz, &velocities, &velocity_potentials);
+    
+    // Save:
+    return write_fields(filename, x_min, y_min, z_min, dx, dy, dz, nx, ny, nz, &velocities, &velocity_potentials);
+}
+
+/**
+   Returns the number of grid points along an axis.
+   
+   @param[in]   min    Minimum coordinate of grid.
+   @param[in]   max    Maximum coordinate of grid.
+   @param[in]   step   Grid step size.
+   
+   @returns The number of grid points.
+*/
+int
+FieldWriter::grid_size(double min, double max, double step)
+{
+    return round((max - min) / step) + 1;
+}
+
+/**
+   Evaluates the velocity vector field and/or the velocity potential scalar field on a grid.  The grid points are numbered
+   with the X index running fastest, followed by the Y and Z indices.  If both fields are requested, they are computed
+   together in a single pass.
+  
+   @param[in]   solver                Solver whose state to evaluate.
+   @param[in]   x_min                 Minimum X coordinate of grid.
+   @param[in]   y_min                 Minimum Y coordinate of grid.
+   @param[in]   z_min                 Minimum Z coordinate of grid.
+   @param[in]   dx                    Grid step size in X-direction.
+   @param[in]   dy                    Grid step size in Y-direction.
+   @param[in]   dz                    Grid step size in Z-direction.
+   @param[in]   nx                    Number of grid points in X-direction.
+   @param[in]   ny                    Number of grid points in Y-direction.
+   @param[in]   nz                    Number of grid points in Z-direction.
+   @param[out]  velocities            Velocity vector field, or NULL.
+   @param[out]  velocity_potentials   Velocity potential scalar field, or NULL.
+*/
+void
+FieldWriter::compute_fields(const Solver &solver,
+                            double x_min, double y_min, double z_min,
+                            double dx, double dy, double dz,
+                            int nx, int ny, int nz,
+                            std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > *velocities,
+                            std::vector<double> *velocity_potentials) const
+{
+    if (velocities)
+        velocities->resize(nx * ny * nz);
+    if (velocity_potentials)
+        velocity_potentials->resize(nx * ny * nz);
+    
+    int i;
+    
+    #pragma omp parallel
+    {
+        #pragma omp for schedule(dynamic, 1)
+        for (i = 0; i < nx * ny * nz; i++) {
+            double x, y, z;
+            x = x_min + (i % (nx * ny)) % nx * dx;
+            y = y_min + (i % (nx * ny)) / nx * dy;
+            z = z_min + (i / (nx * ny)) * dz;
+            
+            if (velocities && velocity_potentials)
+                solver.velocity_and_velocity_potential(Vector3d(x, y, z), (*velocities)[i], (*velocity_potentials)[i]);
+            else if (velocities)
+                (*velocities)[i] = solver.velocity(Vector3d(x, y, z));
+            else if (velocity_potentials)
+                (*velocity_potentials)[i] = solver.velocity_potential(Vector3d(x, y, z));
+        }
+    }
+}
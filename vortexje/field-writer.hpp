@@ -1,5 +1,5 @@
 //
-// Vortexje -- Surface writer base class.
+// Vortexje -- Field writer base class.
 //
 // Copyright (C) 2014 Baayen & Heinz GmbH.
 //
@@ -10,6 +10,7 @@
 #define __FIELD_WRITER_HPP__
 
 #include <string>
+#include <vector>
 
 #include <vortexje/solver.hpp>
 
@@ -36,53 +37,62 @@ public:
     */
     virtual const char *file_extension() const = 0;
     
-    /**
-       Logs the velocity vector field for a specified grid. 
-      
-       @param[in]   solver     Solver whose state to output.
-       @param[in]   filename   Destination filename.
-       @param[in]   x_min      Minimum X coordinate of grid.
-       @param[in]   x_max      Maximum X coordinate of grid.
-       @param[in]   y_min      Minimum Y coordinate of grid.
-       @param[in]   y_max      Maximum Y coordinate of grid.
-       @param[in]   z_min      Minimum Z coordinate of grid.
-       @param[in]   z_max      Maximum Z coordinate of grid.
-       @param[in]   dx         Grid step size in X-direction.
-       @param[in]   dy         Grid step size in Y-direction.
-       @param[in]   dz         Grid step size in Z-direction.
-       
-       @returns true on success.
-    */
     virtual bool write_velocity_field(const Solver &solver,
                                       const std::string &filename,
                                       double x_min, double x_max,
                                       double y_min, double y_max,
                                       double z_min, double z_max,
-                                      double dx, double dy, double dz) = 0;
-             
-    /**
-       Logs the velocity potential scalar field for a specified grid.
-      
-       @param[in]   solver     Solver whose state to output.
-       @param[in]   filename   Destination filename.
-       @param[in]   x_min      Minimum X coordinate of grid.
-       @param[in]   x_max      Maximum X coordinate of grid.
-       @param[in]   y_min      Minimum Y coordinate of grid.
-       @param[in]   y_max      Maximum Y coordinate of grid.
-       @param[in]   z_min      Minimum Z coordinate of grid.
-       @param[in]   z_max      Maximum Z coordinate of grid.
-       @param[in]   dx         Grid step size in X-direction.
-       @param[in]   dy         Grid step size in Y-direction.
-       @param[in]   dz         Grid step size in Z-direction.
-       
-       @returns true on success.
-    */
+                                      double dx, double dy, double dz);
+    
     virtual bool write_velocity_potential_field(const Solver &solver,
                                                 const std::string &filename,
                                                 double x_min, double x_max,
                                                 double y_min, double y_max,
                                                 double z_min, double z_max,
-                                                double dx, double dy, double dz) = 0;
+                                                double dx, double dy, double dz);
+    
+    virtual bool write_velocity_and_velocity_potential_field(const Solver &solver,
+                                                             const std::string &filename,
+                                                             double x_min, double x_max,
+                                                             double y_min, double y_max,
+                                                             double z_min, double z_max,
+                                                             double dx, double dy, double dz);
+    
+    /**
+       Saves precomputed fields on a grid.  The grid points are numbered with the X index running fastest, followed by the
+       Y and Z indices.
+       
+       @param[in]   filename              Destination filename.
+       @param[in]   x_min                 Minimum X coordinate of grid.
+       @param[in]   y_min                 Minimum Y coordinate of grid.
+       @param[in]   z_min                 Minimum Z coordinate of grid.
+       @param[in]   dx                    Grid step size in X-direction.
+       @param[in]   dy                    Grid step size in Y-direction.
+       @param[in]   dz                    Grid step size in Z-direction.
+       @param[in]   nx                    Number of grid points in X-direction.
+       @param[in]   ny                    Number of grid points in Y-direction.
+       @param[in]   nz                    Number of grid points in Z-direction.
+       @param[in]   velocities            Velocity vector field, or NULL.
+       @param[in]   velocity_potentials   Velocity potential scalar field, or NULL.
+       
+       @returns true on success.
+    */
+    virtual bool write_fields(const std::string &filename,
+                              double x_min, double y_min, double z_min,
+                              double dx, double dy, double dz,
+                              int nx, int ny, int nz,
+                              const std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > *velocities,
+                              const std::vector<double> *velocity_potentials) = 0;
+    
+protected:
+    static int grid_size(double min, double max, double step);
+    
+    void compute_fields(const Solver &solver,
+                        double x_min, double y_min, double z_min,
+                        double dx, double dy, double dz,
+                        int nx, int ny, int nz,
+                        std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > *velocities,
+                        std::vector<double> *velocity_potentials) const;
 };
 
 };
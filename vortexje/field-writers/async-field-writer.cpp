@@ -0,0 +1,236 @@
+//
+// Vortexje -- Asynchronous field writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <iostream>
+
+#include <vortexje/field-writers/async-field-writer.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+/**
+   Constructs an asynchronous field writer, and starts its I/O thread.
+   
+   @param[in]   writer             Field writer to which the fields are handed.
+   @param[in]   max_queue_length   Maximum number of pending writes.
+*/
+AsyncFieldWriter::AsyncFieldWriter(FieldWriter &writer, int max_queue_length) : writer(writer), queue(max_queue_length)
+{
+}
+
+/**
+   Destructor.  Completes all pending writes.
+*/
+AsyncFieldWriter::~AsyncFieldWriter()
+{
+    queue.flush();
+}
+
+/**
+   Returns the file extension of the wrapped field writer.
+   
+   @returns The file extension.
+*/
+const char *
+AsyncFieldWriter::file_extension() const
+{
+    return writer.file_extension();
+}
+
+/**
+   Computes the velocity vector field for a specified grid, and queues it for writing.
+   
+   @param[in]   solver     Solver whose state to output.
+   @param[in]   filename   Destination filename.
+   @param[in]   x_min      Minimum X coordinate of grid.
+   @param[in]   x_max      Maximum X coordinate of grid.
+   @param[in]   y_min      Minimum Y coordinate of grid.
+   @param[in]   y_max      Maximum Y coordinate of grid.
+   @param[in]   z_min      Minimum Z coordinate of grid.
+   @param[in]   z_max      Maximum Z coordinate of grid.
+   @param[in]   dx         Grid step size in X-direction.
+   @param[in]   dy         Grid step size in Y-direction.
+   @param[in]   dz         Grid step size in Z-direction.
+   
+   @returns true.  Errors are reported by flush().
+*/
+bool
+AsyncFieldWriter::write_velocity_field(const Solver &solver, const std::string &filename,
+                                       double x_min, double x_max,
+                                       double y_min, double y_max,
+                                       double z_min, double z_max,
+                                       double dx, double dy, double dz)
+{
+    return compute_and_queue(solver, filename, x_min, x_max, y_min, y_max, z_min, z_max, dx, dy, dz, true, false);
+}
+
+/**
+   Computes the velocity potential scalar field for a specified grid, and queues it for writing.
+   
+   @param[in]   solver     Solver whose state to output.
+   @param[in]   filename   Destination filename.
+   @param[in]   x_min      Minimum X coordinate of grid.
+   @param[in]   x_max      Maximum X coordinate of grid.
+   @param[in]   y_min      Minimum Y coordinate of grid.
+   @param[in]   y_max      Maximum Y coordinate of grid.
+   @param[in]   z_min      Minimum Z coordinate of grid.
+   @param[in]   z_max      Maximum Z coordinate of grid.
+   @param[in]   dx         Grid step size in X-direction.
+   @param[in]   dy         Grid step size in Y-direction.
+   @param[in]   dz         Grid step size in Z-direction.
+   
+   @returns true.  Errors are reported by flush().
+*/
+bool
+AsyncFieldWriter::write_velocity_potential_field(const Solver &solver, const std::string &filename,
+                                                 double x_min, double x_max,
+                                                 double y_min, double y_max,
+                                                 double z_min, double z_max,
+                                                 double dx, double dy, double dz)
+{
+    return compute_and_queue(solver, filename, x_min, x_max, y_min, y_max, z_min, z_max, dx, dy, dz, false, true);
+}
+
+/**
+   Computes the velocity vector field and the velocity potential scalar field for a specified grid in a single pass, and
+   queues them for writing.
+   
+   @param[in]   solver     Solver whose state to output.
+   @param[in]   filename   Destination filename.
+   @param[in]   x_min      Minimum X coordinate of grid.
+   @param[in]   x_max      Maximum X coordinate of grid.
+   @param[in]   y_min      Minimum Y coordinate of grid.
+   @param[in]   y_max      Maximum Y coordinate of grid.
+   @param[in]   z_min      Minimum Z coordinate of grid.
+   @param[in]   z_max      Maximum Z coordinate of grid.
+   @param[in]   dx         Grid step size in X-direction.
+   @param[in]   dy         Grid step size in Y-direction.
+   @param[in]   dz         Grid step size in Z-direction.
+   
+   @returns true.  Errors are reported by flush().
+*/
+bool
+AsyncFieldWriter::write_velocity_and_velocity_potential_field(const Solver &solver, const std::string &filename,
+                                                              double x_min, double x_max,
+                                                              double y_min, double y_max,
+                                                              double z_min, double z_max,
+                                                              double dx, double dy, double dz)
+{
+    return compute_and_queue(solver, filename, x_min, x_max, y_min, y_max, z_min, z_max, dx, dy, dz, true, true);
+}
+
+/**
+   Queues precomputed fields for writing.  The fields are copied, and may be modified as soon as this function returns.
+   
+   @param[in]   filename              Destination filename.
+   @param[in]   x_min                 Minimum X coordinate of grid.
+   @param[in]   y_min                 Minimum Y coordinate of grid.
+   @param[in]   z_min                 Minimum Z coordinate of grid.
+   @param[in]   dx                    Grid step size in X-direction.
+   @param[in]   dy                    Grid step size in Y-direction.
+   @param[in]   dz                    Grid step size in Z-direction.
+   @param[in]   nx                    Number of grid points in X-direction.
+   @param[in]   ny                    Number of grid points in Y-direction.
+   @param[in]   nz                    Number of grid points in Z-direction.
+   @param[in]   velocities            Velocity vector field, or NULL.
+   @param[in]   velocity_potentials   Velocity potential scalar field, or NULL.
+   
+   @returns true.  Errors are reported by flush().
+*/
+bool
+AsyncFieldWriter::write_fields(const std::string &filename,
+                               double x_min, double y_min, double z_min,
+                               double dx, double dy, double dz,
+                               int nx, int ny, int nz,
+                               const std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > *velocities,
+                               const std::vector<double> *velocity_potentials)
+{
+    shared_ptr<Job> job = create_job(filename, x_min, y_min, z_min, dx, dy, dz, nx, ny, nz, velocities != NULL, velocity_potentials != NULL);
+    if (velocities)
+        job->velocities = *velocities;
+    if (velocity_potentials)
+        job->velocity_potentials = *velocity_potentials;
+    
+    queue.push(std::bind(&AsyncFieldWriter::write_job, this, job));
+    
+    return true;
+}
+
+/**
+   Waits until all queued fields have been written.
+   
+   @returns true if all writes since the previous flush succeeded.
+*/
+bool
+AsyncFieldWriter::flush()
+{
+    return queue.flush();
+}
+
+// Create a job without field data:
+shared_ptr<AsyncFieldWriter::Job>
+AsyncFieldWriter::create_job(const std::string &filename,
+                             double x_min, double y_min, double z_min,
+                             double dx, double dy, double dz,
+                             int nx, int ny, int nz,
+                             bool write_velocities, bool write_velocity_potentials) const
+{
+    shared_ptr<Job> job = make_shared<Job>();
+    job->filename                  = filename;
+    job->x_min                     = x_min;
+    job->y_min                     = y_min;
+    job->z_min                     = z_min;
+    job->dx                        = dx;
+    job->dy                        = dy;
+    job->dz                        = dz;
+    job->nx                        = nx;
+    job->ny                        = ny;
+    job->nz                        = nz;
+    job->write_velocities          = write_velocities;
+    job->write_velocity_potentials = write_velocity_potentials;
+    
+    return job;
+}
+
+// Compute the requested fields directly into a new job, and queue it:
+bool
+AsyncFieldWriter::compute_and_queue(const Solver &solver, const std::string &filename,
+                                    double x_min, double x_max,
+                                    double y_min, double y_max,
+                                    double z_min, double z_max,
+                                    double dx, double dy, double dz,
+                                    bool write_velocities, bool write_velocity_potentials)
+{
+    int nx = grid_size(x_min, x_max, dx);
+    int ny = grid_size(y_min, y_max, dy);
+    int nz = grid_size(z_min, z_max, dz);
+    
+    shared_ptr<Job> job = create_job(filename, x_min, y_min, z_min, dx, dy, dz, nx, ny, nz, write_velocities, write_velocity_potentials);
+    
+    cout << "AsyncFieldWriter: Computing fields." << endl;
+    
+    compute_fields(solver, x_min, y_min, z_min, dx, dy, dz, nx, ny, nz,
+                   write_velocities ? &job->velocities : NULL, write_velocity_potentials ? &job->velocity_potentials : NULL);
+    
+    queue.push(std::bind(&AsyncFieldWriter::write_job, this, job));
+    
+    return true;
+}
+
+// Hand the fields to the wrapped writer.  Runs on the I/O thread:
+bool
+AsyncFieldWriter::write_job(const std::shared_ptr<Job> &job)
+{
+    return writer.write_fields(job->filename,
+                               job->x_min, job->y_min, job->z_min,
+                               job->dx, job->dy, job->dz,
+                               job->nx, job->ny, job->nz,
+                               job->write_velocities ? &job->velocities : NULL,
+                               job->write_velocity_potentials ? &job->velocity_potentials : NULL);
+}
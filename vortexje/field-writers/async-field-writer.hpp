@@ -0,0 +1,114 @@
+//
+// Vortexje -- Asynchronous field writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __ASYNC_FIELD_WRITER_HPP__
+#define __ASYNC_FIELD_WRITER_HPP__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <vortexje/field-writer.hpp>
+#include <vortexje/async-write-queue.hpp>
+
+namespace Vortexje
+{
+
+/**
+   Field writer which hands fields to another field writer, running on a background I/O thread.
+   
+   The fields are evaluated on the calling thread, as this requires the current state of the solver.  Formatting and
+   writing the fields is left to the I/O thread, and overlaps with the computation of the next time step.  If the queue
+   is full, the write functions block until the I/O thread catches up.
+   
+   The wrapped field writer is called from the I/O thread only, and must not be used directly while this writer is
+   alive.
+   
+   @brief Asynchronous field writer.
+*/
+class AsyncFieldWriter : public FieldWriter
+{
+public:
+    AsyncFieldWriter(FieldWriter &writer, int max_queue_length = 4);
+    
+    ~AsyncFieldWriter();
+    
+    const char *file_extension() const;
+    
+    bool write_velocity_field(const Solver &solver,
+                              const std::string &filename,
+                              double x_min, double x_max,
+                              double y_min, double y_max,
+                              double z_min, double z_max,
+                              double dx, double dy, double dz);
+    
+    bool write_velocity_potential_field(const Solver &solver,
+                                        const std::string &filename,
+                                        double x_min, double x_max,
+                                        double y_min, double y_max,
+                                        double z_min, double z_max,
+                                        double dx, double dy, double dz);
+    
+    bool write_velocity_and_velocity_potential_field(const Solver &solver,
+                                                     const std::string &filename,
+                                                     double x_min, double x_max,
+                                                     double y_min, double y_max,
+                                                     double z_min, double z_max,
+                                                     double dx, double dy, double dz);
+    
+    bool write_fields(const std::string &filename,
+                      double x_min, double y_min, double z_min,
+                      double dx, double dy, double dz,
+                      int nx, int ny, int nz,
+                      const std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > *velocities,
+                      const std::vector<double> *velocity_potentials);
+    
+    bool flush();
+
+private:
+    FieldWriter &writer;
+    
+    class Job
+    {
+    public:
+        std::string filename;
+        
+        double x_min, y_min, z_min;
+        double dx, dy, dz;
+        int nx, ny, nz;
+        
+        bool write_velocities;
+        bool write_velocity_potentials;
+        
+        std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > velocities;
+        std::vector<double> velocity_potentials;
+    };
+    
+    // The queue is declared last, so that it is flushed before the other members are destroyed:
+    AsyncWriteQueue queue;
+    
+    std::shared_ptr<Job> create_job(const std::string &filename,
+                                    double x_min, double y_min, double z_min,
+                                    double dx, double dy, double dz,
+                                    int nx, int ny, int nz,
+                                    bool write_velocities, bool write_velocity_potentials) const;
+    
+    bool compute_and_queue(const Solver &solver,
+                           const std::string &filename,
+                           double x_min, double x_max,
+                           double y_min, double y_max,
+                           double z_min, double z_max,
+                           double dx, double dy, double dz,
+                           bool write_velocities, bool write_velocity_potentials);
+    
+    bool write_job(const std::shared_ptr<Job> &job);
+};
+
+};
+
+#endif // __ASYNC_FIELD_WRITER_HPP__
@@ -0,0 +1,119 @@
+//
+// Vortexje -- VTK binary field writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+#include <vortexje/vtk-binary-data.hpp>
+#include <vortexje/field-writers/vtk-binary-field-writer.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+/**
+   Returns the VTK file extension (".vtk").
+   
+   @returns The VTK file extension (".vtk").
+*/
+const char *
+VTKBinaryFieldWriter::file_extension() const
+{
+    return ".vtk";
+}
+
+/**
+   Saves precomputed fields into a binary VTK file.  The file is assembled in memory, and written to disk in one go.
+  
+   @param[in]   filename              Destination filename.
+   @param[in]   x_min                 Minimum X coordinate of grid.
+   @param[in]   y_min                 Minimum Y coordinate of grid.
+   @param[in]   z_min                 Minimum Z coordinate of grid.
+   @param[in]   dx                    Grid step size in X-direction.
+   @param[in]   dy                    Grid step size in Y-direction.
+   @param[in]   dz                    Grid step size in Z-direction.
+   @param[in]   nx                    Number of grid points in X-direction.
+   @param[in]   ny                    Number of grid points in Y-direction.
+   @param[in]   nz                    Number of grid points in Z-direction.
+   @param[in]   velocities            Velocity vector field, or NULL.
+   @param[in]   velocity_potentials   Velocity potential scalar field, or NULL.
+   
+   @returns true on success.
+*/
+bool
+VTKBinaryFieldWriter::write_fields(const std::string &filename,
+                                   double x_min, double y_min, double z_min,
+                                   double dx, double dy, double dz,
+                                   int nx, int ny, int nz,
+                                   const std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > *velocities,
+                                   const std::vector<double> *velocity_potentials)
+{
+    // Assemble output in binary VTK format:
+    VTKLegacyBinaryData data;
+    
+    data.append("# vtk DataFile Version 2.0\n");
+    data.append("FieldData\n");
+    data.append("BINARY\n");
+    data.append("DATASET RECTILINEAR_GRID\n");
+    
+    stringstream ss;
+    ss << "DIMENSIONS " << nx << " " << ny << " " << nz << "\n";
+    data.append(ss.str());
+    
+    const char *axes[3]     = { "X", "Y", "Z" };
+    const int n[3]          = { nx, ny, nz };
+    const double origin[3]  = { x_min, y_min, z_min };
+    const double spacing[3] = { dx, dy, dz };
+    for (int k = 0; k < 3; k++) {
+        vector<double> coordinates(n[k]);
+        for (int i = 0; i < n[k]; i++)
+            coordinates[i] = origin[k] + i * spacing[k];
+            
+        ss.str(string());
+        ss << axes[k] << "_COORDINATES " << n[k] << " double\n";
+        data.append(ss.str());
+        data.append(coordinates.data(), coordinates.size());
+        data.append("\n");
+    }
+    
+    ss.str(string());
+    ss << "POINT_DATA " << nx * ny * nz << "\n";
+    data.append(ss.str());
+    
+    if (velocities) {
+        data.append("VECTORS Velocity double\n");
+        data.append((*velocities)[0].data(), 3 * velocities->size());
+        data.append("\n");
+    }
+    
+    if (velocity_potentials) {
+        data.append("SCALARS VelocityPotential double 1\n");
+        data.append("LOOKUP_TABLE default\n");
+        data.append(velocity_potentials->data(), velocity_potentials->size());
+        data.append("\n");
+    }
+    
+    // Save to disk:
+    cout << "VTKBinaryFieldWriter: Saving fields to " << filename << "." << endl;
+    
+    ofstream f;
+    f.open(filename.c_str(), ios::binary);
+    
+    if (!data.write(f)) {
+        cerr << "VTKBinaryFieldWriter: Unable to save to " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    f.close();
+    
+    // Done:
+    return true;
+}
@@ -0,0 +1,40 @@
+//
+// Vortexje -- VTK binary field writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __VTK_BINARY_FIELD_WRITER_HPP__
+#define __VTK_BINARY_FIELD_WRITER_HPP__
+
+#include <string>
+#include <vector>
+
+#include <vortexje/field-writer.hpp>
+
+namespace Vortexje
+{
+
+/**
+   Legacy VTK field file writer, using the binary data format.
+   
+   @brief VTK binary field writer.
+*/
+class VTKBinaryFieldWriter : public FieldWriter
+{
+public:
+    const char *file_extension() const;
+    
+    bool write_fields(const std::string &filename,
+                      double x_min, double y_min, double z_min,
+                      double dx, double dy, double dz,
+                      int nx, int ny, int nz,
+                      const std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > *velocities,
+                      const std::vector<double> *velocity_potentials);
+};
+
+};
+
+#endif // __VTK_BINARY_FIELD_WRITER_HPP__
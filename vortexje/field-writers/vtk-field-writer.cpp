@@ -28,146 +28,61 @@ VTKFieldWriter::file_extension() const
 }
 
 /**
-   Logs the velocity vector field into a VTK file.  The grid is the smallest
-   box encompassing all nodes of all surfaces, expanded in the X, Y, and Z
-   directions by the given margins.
+   Saves precomputed fields into a VTK file.
   
-   @param[in]   solver     Solver whose state to output.
-   @param[in]   filename   Destination filename.
-   @param[in]   x_min      Minimum X coordinate of grid.
-   @param[in]   x_max      Maximum X coordinate of grid.
-   @param[in]   y_min      Minimum Y coordinate of grid.
-   @param[in]   y_max      Maximum Y coordinate of grid.
-   @param[in]   z_min      Minimum Z coordinate of grid.
-   @param[in]   z_max      Maximum Z coordinate of grid.
-   @param[in]   dx         Grid step size in X-direction.
-   @param[in]   dy         Grid step size in Y-direction.
-   @param[in]   dz         Grid step size in Z-direction.
+   @param[in]   filename              Destination filename.
+   @param[in]   x_min                 Minimum X coordinate of grid.
+   @param[in]   y_min                 Minimum Y coordinate of grid.
+   @param[in]   z_min                 Minimum Z coordinate of grid.
+   @param[in]   dx                    Grid step size in X-direction.
+   @param[in]   dy                    Grid step size in Y-direction.
+   @param[in]   dz                    Grid step size in Z-direction.
+   @param[in]   nx                    Number of grid points in X-direction.
+   @param[in]   ny                    Number of grid points in Y-direction.
+   @param[in]   nz                    Number of grid points in Z-direction.
+   @param[in]   velocities            Velocity vector field, or NULL.
+   @param[in]   velocity_potentials   Velocity potential scalar field, or NULL.
    
    @returns true on success.
 */
 bool
-VTKFieldWriter::write_velocity_field(const Solver &solver, const std::string &filename,
-                                     double x_min, double x_max,
-                                     double y_min, double y_max,
-                                     double z_min, double z_max,
-                                     double dx, double dy, double dz)
+VTKFieldWriter::write_fields(const std::string &filename,
+                             double x_min, double y_min, double z_min,
+                             double dx, double dy, double dz,
+                             int nx, int ny, int nz,
+                             const std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > *velocities,
+                             const std::vector<double> *velocity_potentials)
 {
-    int nx = round((x_max - x_min) / dx) + 1;
-    int ny = round((y_max - y_min) / dy) + 1;
-    int nz = round((z_max - z_min) / dz) + 1;
-
-    // Compute velocity vector field:
-    cout << "VTKFieldWriter: Computing velocity vector field." << endl;
-
-    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > velocities;
-    velocities.resize(nx * ny * nz);
-    
-    int i;
-    
-    #pragma omp parallel
-    {
-        #pragma omp for schedule(dynamic, 1)
-        for (i = 0; i < nx * ny * nz; i++) {
-            double x, y, z;
-            x = x_min + (i % (nx * ny)) % nx * dx;
-            y = y_min + (i % (nx * ny)) / nx * dy;
-            z = z_min + (i / (nx * ny)) * dz;
-            velocities[i] = solver.velocity(Vector3d(x, y, z));
-        }
-    }
-
     // Write output in VTK format:
-    cout << "VTKFieldWriter: Saving velocity vector field to " << filename << "." << endl;
+    cout << "VTKFieldWriter: Saving fields to " << filename << "." << endl;
     
     ofstream f;
     f.open(filename.c_str());
     
     write_preamble(f, x_min, y_min, z_min, dx, dy, dz, nx, ny, nz);
     
-    // Velocity vector field;    
-    f << "VECTORS Velocity double" << endl;
-    
-    vector<Vector3d, Eigen::aligned_allocator<Vector3d> >::const_iterator it;
-    for (it = velocities.begin(); it != velocities.end(); it++) {
-        Vector3d v = *it;
-        f << v(0) << " " << v(1) << " " << v(2) << endl;
-    }
-    
-    // Close file:
-    f.close();
-    
-    // Done:
-    return true;
-}
-
-/**
-   Logs the velocity potential scalar field into a VTK file.  The grid is the 
-   smallest box encompassing all nodes of all surfaces, expanded in the X, Y,
-   and Z directions by the given margins.
-  
-   @param[in]   solver     Solver whose state to output.
-   @param[in]   filename   Destination filename.
-   @param[in]   x_min      Minimum X coordinate of grid.
-   @param[in]   x_max      Maximum X coordinate of grid.
-   @param[in]   y_min      Minimum Y coordinate of grid.
-   @param[in]   y_max      Maximum Y coordinate of grid.
-   @param[in]   z_min      Minimum Z coordinate of grid.
-   @param[in]   z_max      Maximum Z coordinate of grid.
-   @param[in]   dx         Grid step size in X-direction.
-   @param[in]   dy         Grid step size in Y-direction.
-   @param[in]   dz         Grid step size in Z-direction.
-   
-   @returns true on success.
-*/
-bool
-VTKFieldWriter::write_velocity_potential_field(const Solver &solver, const std::string &filename,
-                                               double x_min, double x_max,
-                                               double y_min, double y_max,
-                                               double z_min, double z_max,
-                                               double dx, double dy, double dz)
-{
-    int nx = round((x_max - x_min) / dx) + 1;
-    int ny = round((y_max - y_min) / dy) + 1;
-    int nz = round((z_max - z_min) / dz) + 1;
-
-    // Compute velocity vector field:
-    cout << "VTKFieldWriter: Computing velocity potential field." << endl;
-
-    vector<double> velocity_potentials;
-    velocity_potentials.resize(nx * ny * nz);
-    
-    int i;
-    
-    #pragma omp parallel
-    {
-        #pragma omp for schedule(dynamic, 1)
-        for (i = 0; i < nx * ny * nz; i++) {
-            double x, y, z;
-            x = x_min + (i % (nx * ny)) % nx * dx;
-            y = y_min + (i % (nx * ny)) / nx * dy;
-            z = z_min + (i / (nx * ny)) * dz;
-            velocity_potentials[i] = solver.velocity_potential(Vector3d(x, y, z));
+    // Velocity vector field;
+    if (velocities) {
+        f << "VECTORS Velocity double" << endl;
+        
+        vector<Vector3d, Eigen::aligned_allocator<Vector3d> >::const_iterator it;
+        for (it = velocities->begin(); it != velocities->end(); it++) {
+            Vector3d v = *it;
+            f << v(0) << " " << v(1) << " " << v(2) << '\n';
         }
     }
-
-    // Write output in VTK format:
-    cout << "VTKFieldWriter: Saving velocity potential field to " << filename << "." << endl;
-    
-    ofstream f;
-    f.open(filename.c_str());
     
-    write_preamble(f, x_min, y_min, z_min, dx, dy, dz, nx, ny, nz);
-    
-    // Velocity potential field:    
-    f << "SCALARS VelocityPotential double 1" << endl;
-    f << "LOOKUP_TABLE default" << endl;
-    
-    vector<double>::const_iterator it;
-    for (it = velocity_potentials.begin(); it != velocity_potentials.end(); it++) {
-        double p = *it;
+    // Velocity potential field:
+    if (velocity_potentials) {
+        f << "SCALARS VelocityPotential double 1" << endl;
+        f << "LOOKUP_TABLE default" << endl;
         
-        f << p << endl;
+        vector<double>::const_iterator it;
+        for (it = velocity_potentials->begin(); it != velocity_potentials->end(); it++) {
+            double p = *it;
+            
+            f << p << '\n';
+        }
     }
     
     // Close file:
@@ -27,20 +27,13 @@ class VTKFieldWriter : public FieldWriter
 public:
     const char *file_extension() const;
     
-    bool write_velocity_field(const Solver &solver,
-                              const std::string &filename,
-                              double x_min, double x_max,
-                              double y_min, double y_max,
-                              double z_min, double z_max,
-                              double dx, double dy, double dz);
-                              
-    bool write_velocity_potential_field(const Solver &solver,
-                                        const std::string &filename,
-                                        double x_min, double x_max,
-                                        double y_min, double y_max,
-                                        double z_min, double z_max,
-                                        double dx, double dy, double dz);
-                                        
+    bool write_fields(const std::string &filename,
+                      double x_min, double y_min, double z_min,
+                      double dx, double dy, double dz,
+                      int nx, int ny, int nz,
+                      const std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > *velocities,
+                      const std::vector<double> *velocity_potentials);
+    
 private:
     void write_preamble(std::ofstream &f,
                         double x_min, double y_min, double z_min,
@@ -0,0 +1,116 @@
+//
+// Vortexje -- VTK XML field writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+#include <vortexje/vtk-binary-data.hpp>
+#include <vortexje/field-writers/vtk-xml-field-writer.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+/**
+   Constructs a VTK XML field writer.
+   
+   @param[in]   compress   Compress the data arrays with zlib.
+*/
+VTKXMLFieldWriter::VTKXMLFieldWriter(bool compress) : compress(compress)
+{
+}
+
+/**
+   Returns the VTK XML image data file extension (".vti").
+   
+   @returns The VTK XML image data file extension (".vti").
+*/
+const char *
+VTKXMLFieldWriter::file_extension() const
+{
+    return ".vti";
+}
+
+/**
+   Saves precomputed fields into a VTK XML file.  The file is assembled in memory, and written to disk in one go.
+  
+   @param[in]   filename              Destination filename.
+   @param[in]   x_min                 Minimum X coordinate of grid.
+   @param[in]   y_min                 Minimum Y coordinate of grid.
+   @param[in]   z_min                 Minimum Z coordinate of grid.
+   @param[in]   dx                    Grid step size in X-direction.
+   @param[in]   dy                    Grid step size in Y-direction.
+   @param[in]   dz                    Grid step size in Z-direction.
+   @param[in]   nx                    Number of grid points in X-direction.
+   @param[in]   ny                    Number of grid points in Y-direction.
+   @param[in]   nz                    Number of grid points in Z-direction.
+   @param[in]   velocities            Velocity vector field, or NULL.
+   @param[in]   velocity_potentials   Velocity potential scalar field, or NULL.
+   
+   @returns true on success.
+*/
+bool
+VTKXMLFieldWriter::write_fields(const std::string &filename,
+                                double x_min, double y_min, double z_min,
+                                double dx, double dy, double dz,
+                                int nx, int ny, int nz,
+                                const std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > *velocities,
+                                const std::vector<double> *velocity_potentials)
+{
+    // Assemble data arrays:
+    VTKAppendedData data(compress);
+    
+    uint64_t velocities_offset = 0, velocity_potentials_offset = 0;
+    if (velocities)
+        velocities_offset = data.append((*velocities)[0].data(), 3 * velocities->size());
+    if (velocity_potentials)
+        velocity_potentials_offset = data.append(velocity_potentials->data(), velocity_potentials->size());
+    
+    // Save to disk:
+    cout << "VTKXMLFieldWriter: Saving fields to " << filename << "." << endl;
+    
+    ofstream f;
+    f.open(filename.c_str(), ios::binary);
+    
+    stringstream extent;
+    extent << "0 " << nx - 1 << " 0 " << ny - 1 << " 0 " << nz - 1;
+    
+    f << "<?xml version=\"1.0\"?>\n";
+    f << "<VTKFile type=\"ImageData\" version=\"1.0\" byte_order=\"" << data.byte_order() << "\" header_type=\"UInt64\"";
+    if (data.compressed())
+        f << " compressor=\"vtkZLibDataCompressor\"";
+    f << ">\n";
+    f << " <ImageData WholeExtent=\"" << extent.str() << "\" Origin=\"" << x_min << " " << y_min << " " << z_min
+      << "\" Spacing=\"" << dx << " " << dy << " " << dz << "\">\n";
+    f << "  <Piece Extent=\"" << extent.str() << "\">\n";
+    f << "   <PointData>\n";
+    if (velocities)
+        f << "    <DataArray type=\"Float64\" Name=\"Velocity\" NumberOfComponents=\"3\" format=\"appended\" offset=\"" << velocities_offset << "\"/>\n";
+    if (velocity_potentials)
+        f << "    <DataArray type=\"Float64\" Name=\"VelocityPotential\" format=\"appended\" offset=\"" << velocity_potentials_offset << "\"/>\n";
+    f << "   </PointData>\n";
+    f << "  </Piece>\n";
+    f << " </ImageData>\n";
+    
+    bool data_written = data.write(f);
+    
+    f << "</VTKFile>\n";
+    
+    if (!data_written || !f.good()) {
+        cerr << "VTKXMLFieldWriter: Unable to save to " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    f.close();
+    
+    // Done:
+    return true;
+}
@@ -0,0 +1,46 @@
+//
+// Vortexje -- VTK XML field writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __VTK_XML_FIELD_WRITER_HPP__
+#define __VTK_XML_FIELD_WRITER_HPP__
+
+#include <string>
+#include <vector>
+
+#include <vortexje/field-writer.hpp>
+
+namespace Vortexje
+{
+
+/**
+   VTK XML image data (.vti) field file writer.  All data arrays are stored in a single appended binary data section,
+   optionally compressed with zlib.
+   
+   @brief VTK XML field writer.
+*/
+class VTKXMLFieldWriter : public FieldWriter
+{
+public:
+    VTKXMLFieldWriter(bool compress = false);
+    
+    const char *file_extension() const;
+    
+    bool write_fields(const std::string &filename,
+                      double x_min, double y_min, double z_min,
+                      double dx, double dy, double dz,
+                      int nx, int ny, int nz,
+                      const std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > *velocities,
+                      const std::vector<double> *velocity_potentials);
+    
+private:
+    bool compress;
+};
+
+};
+
+#endif // __VTK_XML_FIELD_WRITER_HPP__
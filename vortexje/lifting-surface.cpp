@@ -6,6 +6,8 @@
 // Authors: Jorn Baayen <jorn.baayen@baayen-heinz.com>
 //
 
+#include <iostream>
+
 #include <vortexje/lifting-surface.hpp>
 #include <vortexje/parameters.hpp>
 
@@ -216,3 +218,47 @@ LiftingSurface::wake_emission_velocity(const Eigen::Vector3d &apparent_velocity,
     // Done:
     return wake_emission_velocity;
 }
+
+/**
+   Appends the time-dependent state of this lifting surface to a checkpoint.  In addition to the state of the surface, this
+   comprises the trailing edge bisectors and wake normals, which are transformed along with the surface.
+   
+   @param[in]   checkpoint   Checkpoint to append to.
+*/
+void
+LiftingSurface::save_state(CheckpointWriter &checkpoint) const
+{
+    this->Surface::save_state(checkpoint);
+    
+    checkpoint.write_matrix(trailing_edge_bisectors);
+    checkpoint.write_matrix(wake_normals);
+}
+
+/**
+   Restores the time-dependent state of this lifting surface from a checkpoint written by save_state().
+   
+   @param[in]   checkpoint   Checkpoint to read from.
+   
+   @returns true on success.
+*/
+bool
+LiftingSurface::load_state(CheckpointReader &checkpoint)
+{
+    if (!this->Surface::load_state(checkpoint))
+        return false;
+        
+    MatrixXd stored_trailing_edge_bisectors, stored_wake_normals;
+    checkpoint.read_matrix(stored_trailing_edge_bisectors);
+    checkpoint.read_matrix(stored_wake_normals);
+    
+    if (!checkpoint.valid() || stored_trailing_edge_bisectors.rows() != trailing_edge_bisectors.rows() || stored_wake_normals.rows() != wake_normals.rows()) {
+        cerr << "LiftingSurface " << id << ": Checkpoint does not match the trailing edge of the surface." << endl;
+        
+        return false;
+    }
+    
+    trailing_edge_bisectors = stored_trailing_edge_bisectors;
+    wake_normals            = stored_wake_normals;
+    
+    return true;
+}
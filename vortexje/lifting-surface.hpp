@@ -74,6 +74,9 @@ public:
     
     virtual Eigen::Vector3d wake_emission_velocity(const Eigen::Vector3d &apparent_velocity, int node_index) const;
     
+    virtual void save_state(CheckpointWriter &checkpoint) const;
+    virtual bool load_state(CheckpointReader &checkpoint);
+    
 private:
     /**
        Cached list of trailing edge bisector vectors.
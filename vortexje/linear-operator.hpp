@@ -0,0 +1,186 @@
+//
+// Vortexje -- Linear operator.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __LINEAR_OPERATOR_HPP__
+#define __LINEAR_OPERATOR_HPP__
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+namespace Vortexje
+{
+
+class LinearOperator;
+
+};
+
+namespace Eigen
+{
+
+namespace internal
+{
+
+// Linear operators are matrix-free, and are treated like sparse matrices by Eigen:
+template<>
+struct traits<Vortexje::LinearOperator> : public traits<SparseMatrix<double> >
+{
+};
+
+};
+
+};
+
+namespace Vortexje
+{
+
+/**
+   Square matrix that is only accessed by means of matrix-vector products.  Linear operators may be passed to the iterative
+   solvers of Eigen, in combination with LinearOperator::Preconditioner.
+   
+   @brief Linear operator.
+*/
+class LinearOperator : public Eigen::EigenBase<LinearOperator>
+{
+public:
+    typedef double Scalar;
+    typedef double RealScalar;
+    typedef int    StorageIndex;
+    
+    enum {
+        ColsAtCompileTime    = Eigen::Dynamic,
+        MaxColsAtCompileTime = Eigen::Dynamic,
+        IsRowMajor           = false
+    };
+    
+    /**
+       Destructor.
+    */
+    virtual ~LinearOperator() {};
+    
+    /**
+       Returns the number of rows.
+       
+       @returns Number of rows.
+    */
+    virtual Eigen::Index rows() const = 0;
+    
+    /**
+       Returns the number of columns.
+       
+       @returns Number of columns.
+    */
+    virtual Eigen::Index cols() const = 0;
+    
+    /**
+       Computes the matrix-vector product y = A x.
+       
+       @param[in]   x   Vector.
+       @param[out]  y   Product.
+    */
+    virtual void multiply(const Eigen::VectorXd &x, Eigen::VectorXd &y) const = 0;
+    
+    /**
+       Returns the diagonal.
+       
+       @returns Diagonal.
+    */
+    virtual Eigen::VectorXd diagonal() const = 0;
+    
+    /**
+       Returns an expression for the product with a vector, for use by the iterative solvers of Eigen.
+       
+       @param[in]   x   Vector.
+       
+       @returns Product expression.
+    */
+    template<typename Rhs>
+    Eigen::Product<LinearOperator, Rhs, Eigen::AliasFreeProduct> operator*(const Eigen::MatrixBase<Rhs> &x) const
+    {
+        return Eigen::Product<LinearOperator, Rhs, Eigen::AliasFreeProduct>(*this, x.derived());
+    }
+    
+    /**
+       Diagonal (Jacobi) preconditioner for linear operators, for use by the iterative solvers of Eigen.
+       
+       @brief Diagonal preconditioner.
+    */
+    class Preconditioner
+    {
+    public:
+        template<typename MatrixType>
+        Preconditioner &analyzePattern(const MatrixType &)
+        {
+            return *this;
+        }
+        
+        template<typename MatrixType>
+        Preconditioner &factorize(const MatrixType &A)
+        {
+            inverse_diagonal = A.diagonal();
+            for (int i = 0; i < inverse_diagonal.size(); i++) {
+                if (inverse_diagonal(i) != 0.0)
+                    inverse_diagonal(i) = 1.0 / inverse_diagonal(i);
+                else
+                    inverse_diagonal(i) = 1.0;
+            }
+            
+            return *this;
+        }
+        
+        template<typename MatrixType>
+        Preconditioner &compute(const MatrixType &A)
+        {
+            return factorize(A);
+        }
+        
+        template<typename Rhs>
+        Eigen::VectorXd solve(const Eigen::MatrixBase<Rhs> &b) const
+        {
+            return inverse_diagonal.cwiseProduct(b);
+        }
+        
+        Eigen::ComputationInfo info()
+        {
+            return Eigen::Success;
+        }
+        
+    private:
+        Eigen::VectorXd inverse_diagonal;
+    };
+};
+
+};
+
+namespace Eigen
+{
+
+namespace internal
+{
+
+// Evaluate products of linear operators with vectors using LinearOperator::multiply():
+template<typename Rhs>
+struct generic_product_impl<Vortexje::LinearOperator, Rhs, SparseShape, DenseShape, GemvProduct>
+    : generic_product_impl_base<Vortexje::LinearOperator, Rhs, generic_product_impl<Vortexje::LinearOperator, Rhs> >
+{
+    typedef typename Product<Vortexje::LinearOperator, Rhs>::Scalar Scalar;
+    
+    template<typename Dest>
+    static void scaleAndAddTo(Dest &dst, const Vortexje::LinearOperator &lhs, const Rhs &rhs, const Scalar &alpha)
+    {
+        VectorXd y;
+        lhs.multiply(rhs, y);
+        
+        dst.noalias() += alpha * y;
+    }
+};
+
+};
+
+};
+
+#endif // __LINEAR_OPERATOR_HPP__
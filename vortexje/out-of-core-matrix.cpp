@@ -0,0 +1,294 @@
+//
+// Vortexje -- Out-of-core matrix.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <vortexje/out-of-core-matrix.hpp>
+#include <vortexje/dense-operator.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+/**
+   Constructs an empty out-of-core matrix.
+*/
+OutOfCoreMatrix::OutOfCoreMatrix() : n(0), block_size(1), block_stride(0), size(0), data(NULL)
+{
+}
+
+/**
+   Destructor.
+*/
+OutOfCoreMatrix::~OutOfCoreMatrix()
+{
+    deallocate();
+}
+
+/**
+   Allocates an uninitialized n x n matrix.  Any previous contents are discarded.
+   
+   @param[in]   n                   Number of rows and columns.
+   @param[in]   block_size          Number of rows per block.
+   @param[in]   scratch_directory   Directory in which to create the scratch file.
+   
+   @returns true on success.
+*/
+bool
+OutOfCoreMatrix::allocate(int n, int block_size, const std::string &scratch_directory)
+{
+    deallocate();
+    
+    this->n          = n;
+    this->block_size = max(block_size, 1);
+    
+#ifdef _WIN32
+    cerr << "OutOfCoreMatrix: Memory-mapped scratch files are not supported on this platform.  Keeping the matrix in memory." << endl;
+    
+    block_stride = (size_t) this->block_size * n * sizeof(double);
+    size         = block_stride * n_blocks();
+    
+    data = (char *) malloc(size);
+    if (data == NULL && size > 0) {
+        cerr << "OutOfCoreMatrix: Unable to allocate " << size << " bytes." << endl;
+        
+        return false;
+    }
+#else
+    // Align every block to a page boundary, so that blocks can be prefetched and released independently:
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    
+    block_stride = ((size_t) this->block_size * n * sizeof(double) + page_size - 1) / page_size * page_size;
+    size         = block_stride * n_blocks();
+    
+    if (size == 0)
+        return true;
+    
+    string path_template = scratch_directory + "/vortexje-XXXXXX";
+    vector<char> path(path_template.begin(), path_template.end());
+    path.push_back('\0');
+    
+    int fd = mkstemp(&path[0]);
+    if (fd < 0) {
+        cerr << "OutOfCoreMatrix: Unable to create scratch file " << path_template << ": " << strerror(errno) << endl;
+        
+        return false;
+    }
+    
+    // Remove the file name right away.  The disk space is reclaimed once the file is unmapped:
+    unlink(&path[0]);
+    
+    if (ftruncate(fd, size) != 0) {
+        cerr << "OutOfCoreMatrix: Unable to resize scratch file to " << size << " bytes: " << strerror(errno) << endl;
+        
+        close(fd);
+        
+        return false;
+    }
+    
+    void *address = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    
+    close(fd);
+    
+    if (address == MAP_FAILED) {
+        cerr << "OutOfCoreMatrix: Unable to map scratch file: " << strerror(errno) << endl;
+        
+        return false;
+    }
+    
+    data = (char *) address;
+#endif
+
+    return true;
+}
+
+/**
+   Releases the storage of this matrix.
+*/
+void
+OutOfCoreMatrix::deallocate()
+{
+    if (data != NULL) {
+#ifdef _WIN32
+        free(data);
+#else
+        munmap(data, size);
+#endif
+    }
+    
+    data = NULL;
+    size = 0;
+    n    = 0;
+}
+
+/**
+   Returns the number of rows.
+   
+   @returns Number of rows.
+*/
+Eigen::Index
+OutOfCoreMatrix::rows() const
+{
+    return n;
+}
+
+/**
+   Returns the number of columns.
+   
+   @returns Number of columns.
+*/
+Eigen::Index
+OutOfCoreMatrix::cols() const
+{
+    return n;
+}
+
+/**
+   Returns the number of blocks of rows.
+   
+   @returns Number of blocks.
+*/
+int
+OutOfCoreMatrix::n_blocks() const
+{
+    return (n + block_size - 1) / block_size;
+}
+
+/**
+   Returns the index of the first row of a block.
+   
+   @param[in]   block   Block number.
+   
+   @returns Index of the first row.
+*/
+int
+OutOfCoreMatrix::block_begin(int block) const
+{
+    return block * block_size;
+}
+
+/**
+   Returns the number of rows of a block.
+   
+   @param[in]   block   Block number.
+   
+   @returns Number of rows.
+*/
+int
+OutOfCoreMatrix::block_rows(int block) const
+{
+    return min(block_size, n - block * block_size);
+}
+
+/**
+   Returns a block of rows, for reading and writing.  The memory is mapped in on demand.
+   
+   @param[in]   block   Block number.
+   
+   @returns Block of rows.
+*/
+Eigen::Map<Eigen::MatrixXd>
+OutOfCoreMatrix::block(int block)
+{
+    return Map<MatrixXd>((double *) (data + block * block_stride), block_rows(block), n);
+}
+
+/**
+   Returns a block of rows, for reading.  The memory is mapped in on demand.
+   
+   @param[in]   block   Block number.
+   
+   @returns Block of rows.
+*/
+Eigen::Map<const Eigen::MatrixXd>
+OutOfCoreMatrix::block(int block) const
+{
+    return Map<const MatrixXd>((const double *) (data + block * block_stride), block_rows(block), n);
+}
+
+/**
+   Starts reading a block of rows into memory in the background.
+   
+   @param[in]   block   Block number.
+*/
+void
+OutOfCoreMatrix::prefetch(int block) const
+{
+#ifndef _WIN32
+    if (block >= 0 && block < n_blocks())
+        madvise(data + block * block_stride, block_stride, MADV_WILLNEED);
+#endif
+}
+
+/**
+   Releases a block of rows from memory.  Any modifications remain stored in the scratch file.
+   
+   @param[in]   block   Block number.
+*/
+void
+OutOfCoreMatrix::release(int block) const
+{
+#ifndef _WIN32
+    if (block >= 0 && block < n_blocks())
+        madvise(data + block * block_stride, block_stride, MADV_DONTNEED);
+#endif
+}
+
+/**
+   Computes the matrix-vector product y = A x, one block of rows at a time.  The next block is prefetched while the current
+   one is being multiplied.
+   
+   @param[in]   x   Vector.
+   @param[out]  y   Product.
+*/
+void
+OutOfCoreMatrix::multiply(const Eigen::VectorXd &x, Eigen::VectorXd &y) const
+{
+    y.resize(n);
+    
+    prefetch(0);
+    
+    for (int k = 0; k < n_blocks(); k++) {
+        prefetch(k + 1);
+        
+        DenseOperator::multiply(block(k), x, y.segment(block_begin(k), block_rows(k)));
+        
+        release(k);
+    }
+}
+
+/**
+   Returns the diagonal.
+   
+   @returns Diagonal.
+*/
+Eigen::VectorXd
+OutOfCoreMatrix::diagonal() const
+{
+    VectorXd d(n);
+    
+    for (int k = 0; k < n_blocks(); k++) {
+        for (int i = 0; i < block_rows(k); i++)
+            d(block_begin(k) + i) = block(k)(i, block_begin(k) + i);
+        
+        release(k);
+    }
+    
+    return d;
+}
@@ -0,0 +1,82 @@
+//
+// Vortexje -- Out-of-core matrix.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __OUT_OF_CORE_MATRIX_HPP__
+#define __OUT_OF_CORE_MATRIX_HPP__
+
+#include <string>
+
+#include <Eigen/Core>
+
+#include <vortexje/linear-operator.hpp>
+
+namespace Vortexje
+{
+
+/**
+   Square dense matrix, stored in a memory-mapped scratch file.
+   
+   The matrix is partitioned into blocks of rows.  Every block is stored contiguously, in column-major order.  Blocks are 
+   accessed one at a time, and released from memory after use.  The matrix-vector product prefetches the next block, while
+   the current one is being multiplied.  The memory footprint of an out-of-core matrix is therefore limited to a few blocks,
+   independently of the size of the matrix.
+   
+   The scratch file is removed as soon as it has been created, so that its disk space is reclaimed when the matrix is destroyed.
+   
+   @brief Out-of-core matrix.
+*/
+class OutOfCoreMatrix : public LinearOperator
+{
+public:
+    OutOfCoreMatrix();
+    
+    ~OutOfCoreMatrix();
+    
+    bool allocate(int n, int block_size, const std::string &scratch_directory);
+    
+    void deallocate();
+    
+    Eigen::Index rows() const;
+    
+    Eigen::Index cols() const;
+    
+    int n_blocks() const;
+    
+    int block_begin(int block) const;
+    
+    int block_rows(int block) const;
+    
+    Eigen::Map<Eigen::MatrixXd> block(int block);
+    
+    Eigen::Map<const Eigen::MatrixXd> block(int block) const;
+    
+    void prefetch(int block) const;
+    
+    void release(int block) const;
+    
+    void multiply(const Eigen::VectorXd &x, Eigen::VectorXd &y) const;
+    
+    Eigen::VectorXd diagonal() const;
+    
+private:
+    int n;
+    int block_size;
+    
+    size_t block_stride;
+    size_t size;
+    
+    char *data;
+    
+    // Out-of-core matrices cannot be copied:
+    OutOfCoreMatrix(const OutOfCoreMatrix &);
+    OutOfCoreMatrix &operator=(const OutOfCoreMatrix &);
+};
+
+};
+
+#endif // __OUT_OF_CORE_MATRIX_HPP__
@@ -19,6 +19,22 @@ int    Parameters::linear_solver_max_iterations       = 20000;
 
 double Parameters::linear_solver_tolerance            = numeric_limits<double>::epsilon();
 
+bool   Parameters::recycle_krylov_subspace            = false;
+
+int    Parameters::gmres_restart                      = 40;
+
+int    Parameters::n_recycled_krylov_vectors          = 10;
+
+int    Parameters::doublet_extrapolation_order        = 0;
+
+bool   Parameters::cache_body_influence_coefficients  = false;
+
+bool   Parameters::out_of_core                        = false;
+int    Parameters::out_of_core_block_size             = 256;
+string Parameters::scratch_directory                  = ".";
+
+int    Parameters::n_threads                          = 0;
+bool   Parameters::bind_threads                       = false;
 bool   Parameters::unsteady_bernoulli                 = true;
 
 bool   Parameters::convect_wake                       = true;
@@ -40,3 +56,5 @@ double Parameters::interpolation_layer_thickness      = 0.0;
 int    Parameters::max_boundary_layer_iterations      = 100;
 
 double Parameters::boundary_layer_iteration_tolerance = numeric_limits<double>::epsilon();
+
+int    Parameters::boundary_layer_acceleration_depth  = 0;
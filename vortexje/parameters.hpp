@@ -9,6 +9,8 @@
 #ifndef __PARAMETERS_HPP__
 #define __PARAMETERS_HPP__
 
+#include <string>
+
 namespace Vortexje
 {
 
@@ -23,15 +25,78 @@ class Parameters
 {
 public:
     /**
-       Maximum number of iterations of BiCGSTAB linear solver.
+       Maximum number of iterations of the linear solver.
     */
     static int    linear_solver_max_iterations;
     
     /**
-       Tolerance of BiCGSTAB linear solver.
+       Tolerance of the linear solver.
     */
     static double linear_solver_tolerance;
     
+    /**
+       Whether to solve for the doublet distribution using GMRES with Krylov subspace recycling (GCRO-DR), rather than BiCGSTAB.  
+       The recycled subspace is carried over from one time step to the next.
+    */
+    static bool   recycle_krylov_subspace;
+    
+    /**
+       Maximum dimension of the GMRES search space, including the recycled subspace.
+    */
+    static int    gmres_restart;
+    
+    /**
+       Dimension of the recycled Krylov subspace.
+    */
+    static int    n_recycled_krylov_vectors;
+    
+    /**
+       Order of the polynomial extrapolation of the doublet distributions of previous time steps, used as the initial guess
+       for the linear solver.  0 uses the previous doublet distribution;  1 and 2 use linear and quadratic extrapolation,
+       respectively.  For smooth motions, extrapolation reduces the number of linear solver iterations per time step.
+    */
+    static int    doublet_extrapolation_order;
+    
+    /**
+       Whether to factorize the matrix of body influence coefficients once, and to account for the Kutta condition by means
+       of a low-rank update.  The factorization is reused for as long as the bodies move as a single rigid body.  This replaces
+       the BiCGSTAB solver, and requires two dense matrices of influence coefficients to be kept in memory.
+    */
+    static bool   cache_body_influence_coefficients;
+    
+    /**
+       Whether to store the matrix of doublet influence coefficients in a memory-mapped scratch file, rather than in memory.
+       The matrix is assembled, and applied by the iterative solver, one block of rows at a time.  This allows for problems
+       whose matrix of influence coefficients exceeds the available memory.  Does not apply to the cyclic symmetry and cached 
+       low-rank solvers.
+    */
+    static bool   out_of_core;
+    
+    /**
+       Number of rows per block of an out-of-core matrix of influence coefficients.  Larger blocks make for more efficient
+       disk access, at the expense of a larger memory footprint.
+    */
+    static int    out_of_core_block_size;
+    
+    /**
+       Directory in which out-of-core matrices are stored.
+    */
+    static std::string scratch_directory;
+    
+    /**
+       Number of threads used by the solver.  0 uses the OpenMP default, which may be set using the OMP_NUM_THREADS 
+       environment variable.
+    */
+    static int    n_threads;
+    
+    /**
+       Whether to bind every solver thread to a single processor, spreading the threads evenly over the processors of the 
+       OpenMP places.  Combined with the parallel first-touch allocation of the dense matrices, this keeps every thread close
+       to the rows of the matrices it multiplies on NUMA systems.  Requires thread affinity to be enabled by setting the 
+       OMP_PROC_BIND environment variable, and optionally OMP_PLACES.  Supported on Linux only.
+    */
+    static bool   bind_threads;
+    
     /**
        Whether or not to apply the unsteady Bernoulli equation.
     */
@@ -107,6 +172,14 @@ public:
        Boundary layer iteration tolerance.
     */
     static double boundary_layer_iteration_tolerance;
+    
+    /**
+       Number of previous iterates used by Anderson acceleration of the boundary layer iteration.  The source distribution is
+       then extrapolated from the history of iterates, rather than taken from the latest boundary layer solution.  This
+       speeds up slowly converging, or oscillating, boundary layer iterations.  A depth of 1 yields a secant method, related 
+       to Aitken's delta-squared process.  0 disables acceleration.
+    */
+    static int    boundary_layer_acceleration_depth;
 };
 
 };
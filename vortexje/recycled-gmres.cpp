@@ -0,0 +1,414 @@
+//
+// Vortexje -- GMRES with Krylov subspace recycling.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <algorithm>
+#include <complex>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <Eigen/QR>
+#include <Eigen/LU>
+#include <Eigen/Eigenvalues>
+
+#include <vortexje/recycled-gmres.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+// Helper to compute a thin QR decomposition:
+static void
+thin_qr(const MatrixXd &X, MatrixXd &Q, MatrixXd &R)
+{
+    HouseholderQR<MatrixXd> qr(X);
+
+    Q = qr.householderQ() * MatrixXd::Identity(X.rows(), X.cols());
+    R = qr.matrixQR().topRows(X.cols()).triangularView<Upper>();
+}
+
+// Helper to sort eigenvalues by magnitude:
+class CompareEigenvalueMagnitude
+{
+public:
+    CompareEigenvalueMagnitude(const VectorXcd &eigenvalues) : eigenvalues(eigenvalues) {}
+
+    const VectorXcd &eigenvalues;
+
+    bool operator()(int a, int b) const
+    {
+        return abs(eigenvalues(a)) < abs(eigenvalues(b));
+    }
+};
+
+/**
+   Constructs a GMRES solver with an empty recycled subspace.
+*/
+RecycledGMRES::RecycledGMRES() :
+    max_iterations(1000), tolerance(numeric_limits<double>::epsilon()), restart(40), n_recycled_vectors(10),
+    n_iterations(0), estimated_error(0.0)
+{
+}
+
+/**
+   Sets the maximum number of iterations.
+
+   @param[in]   max_iterations   Maximum number of iterations.
+*/
+void
+RecycledGMRES::set_max_iterations(int max_iterations)
+{
+    this->max_iterations = max_iterations;
+}
+
+/**
+   Sets the tolerance on the relative residual.
+
+   @param[in]   tolerance   Tolerance.
+*/
+void
+RecycledGMRES::set_tolerance(double tolerance)
+{
+    this->tolerance = tolerance;
+}
+
+/**
+   Sets the maximum dimension of the search space, and the dimension of the recycled subspace.
+
+   @param[in]   restart              Maximum dimension of the search space, including the recycled subspace.
+   @param[in]   n_recycled_vectors   Dimension of the recycled subspace.
+*/
+void
+RecycledGMRES::set_restart(int restart, int n_recycled_vectors)
+{
+    this->restart            = max(restart, 2);
+    this->n_recycled_vectors = max(min(n_recycled_vectors, this->restart - 1), 0);
+}
+
+/**
+   Discards the recycled subspace.
+*/
+void
+RecycledGMRES::reset()
+{
+    U.resize(0, 0);
+}
+
+/**
+   Returns the basis of the recycled subspace, one vector per column.
+
+   @returns Basis of the recycled subspace.
+*/
+const Eigen::MatrixXd &
+RecycledGMRES::recycled_subspace() const
+{
+    return U;
+}
+
+/**
+   Sets the recycled subspace, as when resuming a sequence of solves from a checkpoint.
+
+   @param[in]   U   Basis of the recycled subspace, one vector per column.
+*/
+void
+RecycledGMRES::set_recycled_subspace(const Eigen::MatrixXd &U)
+{
+    this->U = U;
+}
+
+/**
+   Returns the number of iterations used by the last call to solve().
+
+   @returns Number of iterations.
+*/
+int
+RecycledGMRES::iterations() const
+{
+    return n_iterations;
+}
+
+/**
+   Returns the relative residual |b - A x| / |b| of the solution returned by the last call to solve().
+
+   @returns Relative residual.
+*/
+double
+RecycledGMRES::error() const
+{
+    return estimated_error;
+}
+
+/**
+   Solves the linear system A x = b.  The recycled subspace is retained for subsequent calls.
+
+   @param[in]       A   System matrix, accessed by means of matrix-vector products only.
+   @param[in]       b   Right-hand side.
+   @param[in,out]   x   On input, the initial guess;  on output, the solution.
+
+   @returns true on convergence.
+*/
+bool
+RecycledGMRES::solve(const LinearOperator &A, const Eigen::VectorXd &b, Eigen::VectorXd &x)
+{
+    int n = b.size();
+
+    n_iterations = 0;
+
+    if (x.size() != n)
+        x = VectorXd::Zero(n);
+
+    double b_norm = b.norm();
+    if (b_norm == 0.0) {
+        x.setZero();
+
+        estimated_error = 0.0;
+
+        return true;
+    }
+
+    // Discard recycled subspaces of different dimension:
+    if (U.rows() != n)
+        U.resize(n, 0);
+
+    VectorXd r;
+    A.multiply(x, r);
+    r = b - r;
+
+    estimated_error = r.norm() / b_norm;
+    if (estimated_error <= tolerance)
+        return true;
+
+    // Adapt the recycled subspace to the new matrix, such that C = A U has orthonormal columns, and project the residual:
+    MatrixXd C;
+    if (U.cols() > 0) {
+        MatrixXd AU(n, U.cols());
+        for (int i = 0; i < U.cols(); i++) {
+            VectorXd Au;
+            A.multiply(U.col(i), Au);
+            AU.col(i) = Au;
+        }
+
+        MatrixXd R;
+        thin_qr(AU, C, R);
+
+        if (R.diagonal().cwiseAbs().minCoeff() <= numeric_limits<double>::epsilon() * R.diagonal().cwiseAbs().maxCoeff()) {
+            U.resize(n, 0);
+
+        } else {
+            U = R.triangularView<Upper>().solve<OnTheRight>(U);
+
+            VectorXd c = C.transpose() * r;
+
+            x += U * c;
+
+            A.multiply(x, r);
+            r = b - r;
+
+            estimated_error = r.norm() / b_norm;
+            if (estimated_error <= tolerance)
+                return true;
+        }
+    }
+
+    // Restart cycles:
+    while (n_iterations < max_iterations) {
+        int k = U.cols();
+        int m = restart - k;
+
+        // Arnoldi process for (I - C C^T) A:
+        MatrixXd V = MatrixXd::Zero(n, m + 1);
+        MatrixXd H = MatrixXd::Zero(m + 1, m);
+        MatrixXd B = MatrixXd::Zero(k, m);
+
+        // Least squares problem, reduced to upper triangular form by Givens rotations:
+        MatrixXd H_rotated = MatrixXd::Zero(m + 1, m);
+        VectorXd g = VectorXd::Zero(m + 1);
+        VectorXd cs(m), sn(m);
+
+        double beta = r.norm();
+
+        V.col(0) = r / beta;
+        g(0) = beta;
+
+        bool converged = false;
+        bool breakdown = false;
+
+        int j = 0;
+        while (j < m && n_iterations < max_iterations) {
+            VectorXd w;
+            A.multiply(V.col(j), w);
+
+            if (k > 0) {
+                B.col(j) = C.transpose() * w;
+                w -= C * B.col(j);
+            }
+
+            for (int i = 0; i <= j; i++) {
+                H(i, j) = V.col(i).dot(w);
+                w -= H(i, j) * V.col(i);
+            }
+
+            H(j + 1, j) = w.norm();
+
+            // Apply previous rotations to the new column, and compute a new rotation:
+            H_rotated.col(j) = H.col(j);
+            for (int i = 0; i < j; i++) {
+                double temp            =  cs(i) * H_rotated(i, j) + sn(i) * H_rotated(i + 1, j);
+                H_rotated(i + 1, j)    = -sn(i) * H_rotated(i, j) + cs(i) * H_rotated(i + 1, j);
+                H_rotated(i, j)        = temp;
+            }
+
+            double rho = sqrt(pow(H_rotated(j, j), 2) + pow(H_rotated(j + 1, j), 2));
+            cs(j) = H_rotated(j, j) / rho;
+            sn(j) = H_rotated(j + 1, j) / rho;
+
+            H_rotated(j, j)     = rho;
+            H_rotated(j + 1, j) = 0.0;
+
+            g(j + 1) = -sn(j) * g(j);
+            g(j)     =  cs(j) * g(j);
+
+            j++;
+            n_iterations++;
+
+            // Store the new basis vector before checking for convergence, since the recycled subspace is built from it:
+            if (H(j, j - 1) != 0.0)
+                V.col(j) = w / H(j, j - 1);
+            else
+                breakdown = true;
+
+            estimated_error = fabs(g(j)) / b_norm;
+            if (estimated_error <= tolerance || breakdown) {
+                converged = true;
+                break;
+            }
+        }
+
+        // Update solution.  Since C^T r = 0, the coefficients of the recycled subspace follow from those of the new Krylov
+        // subspace:
+        VectorXd y = H_rotated.topLeftCorner(j, j).triangularView<Upper>().solve(g.head(j));
+
+        x += V.leftCols(j) * y;
+        if (k > 0)
+            x -= U * (B.leftCols(j) * y);
+
+        A.multiply(x, r);
+        r = b - r;
+
+        estimated_error = r.norm() / b_norm;
+
+        // Update the recycled subspace, using the harmonic Ritz vectors of smallest magnitude.  After a breakdown, the last
+        // row of the Hessenberg matrix vanishes, and there is no new basis vector:
+        int n_rows = breakdown ? j : j + 1;
+
+        int k_new = min(n_recycled_vectors, j);
+        if (k_new > 0) {
+            MatrixXd W_hat, V_hat, G_bar;
+
+            if (k == 0) {
+                W_hat = V.leftCols(j);
+                V_hat = V.leftCols(n_rows);
+                G_bar = H.topLeftCorner(n_rows, j);
+
+            } else {
+                VectorXd d = U.colwise().norm().cwiseInverse();
+
+                W_hat.resize(n, k + j);
+                W_hat << U * d.asDiagonal(), V.leftCols(j);
+
+                V_hat.resize(n, k + n_rows);
+                V_hat << C, V.leftCols(n_rows);
+
+                G_bar = MatrixXd::Zero(k + n_rows, k + j);
+                G_bar.topLeftCorner(k, k)          = d.asDiagonal();
+                G_bar.topRightCorner(k, j)         = B.leftCols(j);
+                G_bar.bottomRightCorner(n_rows, j) = H.topLeftCorner(n_rows, j);
+            }
+
+            // Generalized eigenvalue problem G^T G z = theta G^T V_hat^T W_hat z:
+            MatrixXd lhs = G_bar.transpose() * G_bar;
+            MatrixXd rhs = G_bar.transpose() * (V_hat.transpose() * W_hat);
+
+            MatrixXd P = smallest_eigenvectors(rhs.fullPivLu().solve(lhs), k_new);
+
+            MatrixXd Q, R;
+            thin_qr(G_bar * P, Q, R);
+
+            MatrixXd C_new = V_hat * Q;
+            MatrixXd U_new = R.triangularView<Upper>().solve<OnTheRight>(MatrixXd(W_hat * P));
+
+            if (C_new.allFinite() && U_new.allFinite()) {
+                C = C_new;
+                U = U_new;
+
+                // Project the residual before the next cycle.  In exact arithmetic, it is orthogonal to C already.  A converged
+                // solution is left alone;  the new subspace only serves the next call to solve():
+                if (!converged) {
+                    VectorXd c = C.transpose() * r;
+
+                    x += U * c;
+
+                    A.multiply(x, r);
+                    r = b - r;
+
+                    estimated_error = r.norm() / b_norm;
+                }
+            }
+        }
+
+        if (converged || estimated_error <= tolerance)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+   Returns an orthonormal basis for the space spanned by the eigenvectors of M associated with the k eigenvalues of smallest
+   magnitude.  Complex conjugate eigenvector pairs are represented by their real and imaginary parts.
+
+   @param[in]   M   Square matrix.
+   @param[in]   k   Number of eigenvectors.
+
+   @returns Orthonormal basis.
+*/
+Eigen::MatrixXd
+RecycledGMRES::smallest_eigenvectors(const Eigen::MatrixXd &M, int k) const
+{
+    EigenSolver<MatrixXd> eigen_solver(M);
+
+    const VectorXcd &eigenvalues  = eigen_solver.eigenvalues();
+    const MatrixXcd eigenvectors = eigen_solver.eigenvectors();
+
+    vector<int> order;
+    for (int i = 0; i < (int) eigenvalues.size(); i++)
+        order.push_back(i);
+
+    sort(order.begin(), order.end(), CompareEigenvalueMagnitude(eigenvalues));
+
+    MatrixXd P(M.rows(), k);
+
+    int n_vectors = 0;
+    for (int i = 0; i < (int) order.size() && n_vectors < k; i++) {
+        complex<double> eigenvalue = eigenvalues(order[i]);
+
+        // The conjugate of the previous eigenvalue does not add anything:
+        if (i > 0 && eigenvalue.imag() != 0.0 && eigenvalue == conj(eigenvalues(order[i - 1])))
+            continue;
+
+        P.col(n_vectors++) = eigenvectors.col(order[i]).real();
+
+        if (eigenvalue.imag() != 0.0 && n_vectors < k)
+            P.col(n_vectors++) = eigenvectors.col(order[i]).imag();
+    }
+
+    MatrixXd Q, R;
+    thin_qr(P.leftCols(n_vectors), Q, R);
+
+    return Q;
+}
@@ -0,0 +1,71 @@
+//
+// Vortexje -- GMRES with Krylov subspace recycling.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __RECYCLED_GMRES_HPP__
+#define __RECYCLED_GMRES_HPP__
+
+#include <Eigen/Core>
+
+#include <vortexje/linear-operator.hpp>
+
+namespace Vortexje
+{
+
+/**
+   Restarted GMRES with deflated restarting and Krylov subspace recycling (GCRO-DR).
+
+   A subspace of approximate eigenvectors, associated with the eigenvalues of smallest magnitude, is retained between restarts
+   and between subsequent calls to solve().  When solving a sequence of slowly changing linear systems, as arises in time-stepping,
+   the recycled subspace accelerates the convergence of every system in the sequence.
+
+   @note See M. L. Parks, E. de Sturler, G. Mackey, D. D. Johnson, and S. Maiti, Recycling Krylov Subspaces for Sequences of
+   Linear Systems, SIAM Journal on Scientific Computing 28(5), 2006.
+
+   @brief GMRES with Krylov subspace recycling.
+*/
+class RecycledGMRES
+{
+public:
+    RecycledGMRES();
+
+    void set_max_iterations(int max_iterations);
+
+    void set_tolerance(double tolerance);
+
+    void set_restart(int restart, int n_recycled_vectors);
+
+    bool solve(const LinearOperator &A, const Eigen::VectorXd &b, Eigen::VectorXd &x);
+
+    void reset();
+
+    const Eigen::MatrixXd &recycled_subspace() const;
+
+    void set_recycled_subspace(const Eigen::MatrixXd &U);
+
+    int iterations() const;
+
+    double error() const;
+
+private:
+    int max_iterations;
+    double tolerance;
+
+    int restart;
+    int n_recycled_vectors;
+
+    int n_iterations;
+    double estimated_error;
+
+    Eigen::MatrixXd U;
+
+    Eigen::MatrixXd smallest_eigenvectors(const Eigen::MatrixXd &M, int k) const;
+};
+
+};
+
+#endif // __RECYCLED_GMRES_HPP__
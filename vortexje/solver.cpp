@@ -12,14 +12,25 @@
 
 #include <iostream>
 #include <limits>
+#include <chrono>
+#include <functional>
 #include <typeinfo>
 
 #ifdef _WIN32
 #include <direct.h>
 #endif
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <Eigen/Geometry>
 #include <Eigen/SVD>
+#include <Eigen/LU>
 #include <Eigen/IterativeLinearSolvers>
 
 #include <vortexje/solver.hpp>
@@ -30,6 +41,115 @@ using namespace std;
 using namespace Eigen;
 using namespace Vortexje;
 
+static const double pi = 3.141592653589793238462643383279502884;
+
+// Relative tolerance for the detection of cyclic symmetry:
+#define CYCLIC_SYMMETRY_TOLERANCE 1e-9
+#define SYMMETRY_PLANE_TOLERANCE  1e-9
+
+// Relative tolerance for the detection of rigid body motion:
+#define RIGID_MOTION_TOLERANCE    1e-12
+
+// Maximum number of rows and columns of a tile of the matrices of influence coefficients.  Two 64 x 64 tiles fit into a 64 KB
+// L2 cache:
+#define INFLUENCE_TILE_SIZE       64
+
+// Maximum number of panels processed by a single OpenMP task.  This equals the tile size, so that every tile of influence
+// coefficients depends on a single source coefficient task:
+#define PANEL_TASK_SIZE           INFLUENCE_TILE_SIZE
+
+// Perturbation of node positions, relative to the size of the adjacent panels, for the central differences in the adjoint
+// sensitivities:
+#define NODE_PERTURBATION         1e-5
+
+// Applies Parameters::n_threads and Parameters::bind_threads for the lifetime of the object, and restores the previous settings
+// afterwards.  When the threads are bound, the original CPU mask of every thread of the team is saved, and restored by a team
+// of the same size.
+//
+// The binding is set once, in a parallel region of its own, and must therefore hold in every later parallel region of the same
+// size.  This relies on OpenMP thread number i being executed by the same OS thread in all of these regions, which OpenMP only
+// guarantees when thread affinity is enabled.  The threads are therefore only bound when OMP_PROC_BIND is set, and are spread
+// over the processors of the places given by OMP_PLACES:
+class ThreadSettings
+{
+public:
+    ThreadSettings()
+    {
+#ifdef _OPENMP
+        previous_n_threads = omp_get_max_threads();
+        if (Parameters::n_threads > 0)
+            omp_set_num_threads(Parameters::n_threads);
+            
+#ifdef __linux__
+        n_bound_threads = 0;
+        
+        if (Parameters::bind_threads && omp_get_proc_bind() == omp_proc_bind_false) {
+            cerr << "Solver: Parameters::bind_threads requires OMP_PROC_BIND to be set.  Threads are not bound." << endl;
+            
+        } else if (Parameters::bind_threads) {
+            vector<int> cpus;
+            for (int i = 0; i < omp_get_num_places(); i++) {
+                vector<int> place_cpus(omp_get_place_num_procs(i));
+                omp_get_place_proc_ids(i, place_cpus.data());
+                
+                cpus.insert(cpus.end(), place_cpus.begin(), place_cpus.end());
+            }
+            
+            previous_cpus.resize(omp_get_max_threads());
+            
+            if (!cpus.empty()) {
+                #pragma omp parallel
+                {
+                    int thread = omp_get_thread_num();
+                    
+                    #pragma omp single
+                    n_bound_threads = omp_get_num_threads();
+                    
+                    sched_getaffinity(0, sizeof(previous_cpus[thread]), &previous_cpus[thread]);
+                    
+                    int cpu_index = (int) ((long) thread * cpus.size() / omp_get_num_threads());
+                    
+                    cpu_set_t cpu;
+                    CPU_ZERO(&cpu);
+                    CPU_SET(cpus[cpu_index], &cpu);
+                    
+                    sched_setaffinity(0, sizeof(cpu), &cpu);
+                }
+            }
+        }
+#endif
+#endif
+    }
+    
+    ~ThreadSettings()
+    {
+#ifdef _OPENMP
+#ifdef __linux__
+        if (n_bound_threads > 0) {
+            #pragma omp parallel num_threads(n_bound_threads)
+            {
+                int thread = omp_get_thread_num();
+                
+                sched_setaffinity(0, sizeof(previous_cpus[thread]), &previous_cpus[thread]);
+            }
+        }
+#endif
+
+        omp_set_num_threads(previous_n_threads);
+#endif
+    }
+    
+private:
+#ifdef _OPENMP
+    int previous_n_threads;
+    
+#ifdef __linux__
+    int n_bound_threads;
+    vector<cpu_set_t> previous_cpus;
+#endif
+#endif
+};
+
 // String constants:
 #define VIEW_NAME_SOURCE_DISTRIBUTION   "sigma"
 #define VIEW_NAME_DOUBLET_DISTRIBUTION  "mu"
@@ -49,6 +169,14 @@ mkdir_helper(const string folder)
             cerr << "Could not create log folder " << folder << ": " << strerror(errno) << endl;
 }
 
+// View on the rows of a global panel array that belong to a single surface:
+template <class Derived>
+static SurfaceWriter::ViewData
+panel_rows_view(const PlainObjectBase<Derived> &data, int offset, int n_panels)
+{
+    return SurfaceWriter::ViewData(data.data() + offset, n_panels, data.cols(), OuterStride<>(data.outerStride()));
+}
+
 /**
    Construct a solver, logging its output into the given folder.
    
@@ -64,6 +192,12 @@ Solver::Solver(const string &log_folder) : log_folder(log_folder)
     
     // Total number of panels:
     n_non_wake_panels = 0;
+    
+    // No cyclic symmetry by default:
+    n_cyclic_sectors = 0;
+    
+    // No boundary layer iterations yet:
+    n_boundary_layer_iterations = 0;
         
     // Open log files:
     mkdir_helper(log_folder);
@@ -142,6 +276,8 @@ Solver::add_body(std::shared_ptr<Body> body, std::shared_ptr<BoundaryLayer> boun
     
     previous_surface_velocity_potentials.resize(n_non_wake_panels);
     previous_surface_velocity_potentials.setZero();
+    
+    previous_doublet_coefficients.clear();
 
     // Open logs:
     string body_log_folder = log_folder + "/" + body->id;
@@ -195,6 +331,67 @@ Solver::set_fluid_density(double value)
     fluid_density = value;
 }
 
+/**
+   Enables cyclic symmetry for rotors consisting of n identical, equally spaced sectors.
+   
+   The non-wake surfaces are split, in the order in which they were added, into n_sectors consecutive groups of equal size.
+   Every group must be obtained from the previous group by a rotation of 2 pi / n_sectors about the given axis, following the
+   right-hand rule.  Under these conditions the matrix of influence coefficients is block-circulant.  Only the rows belonging to
+   the first sector are assembled, and the linear system is solved as n_sectors independent systems by means of a discrete
+   Fourier transform across the sectors.  If the flow is axisymmetric as well, wake convection velocities are only evaluated
+   for the wakes of the first sector.
+   
+   The symmetry of the geometry is verified on every call to solve().  If it does not hold, the solver falls back to the full
+   system.
+   
+   @param[in]   n_sectors        Number of sectors (blades).  Values less than 2 disable cyclic symmetry.
+   @param[in]   axis_point       A point on the axis of symmetry.
+   @param[in]   axis_direction   Direction of the axis of symmetry.
+*/
+void
+Solver::set_cyclic_symmetry(int n_sectors, const Eigen::Vector3d &axis_point, const Eigen::Vector3d &axis_direction)
+{
+    n_cyclic_sectors = n_sectors;
+    
+    cyclic_axis_point     = axis_point;
+    cyclic_axis_direction = axis_direction.normalized();
+    
+    if (n_sectors > 1)
+        cyclic_sector_rotation = AngleAxis<double>(2 * pi / n_sectors, cyclic_axis_direction).toRotationMatrix();
+    else
+        cyclic_sector_rotation = Matrix3d::Identity();
+}
+
+/**
+   Adds a plane of symmetry.  Only one half of the geometry needs to be modelled; the other half is accounted for by
+   mirror images of all surfaces and wakes, which carry the same source and doublet distributions.  This halves the number of
+   unknowns, and reduces the size of the matrices of influence coefficients by a factor of four.
+   
+   The geometry, the body kinematics, and the freestream velocity must be symmetric with respect to the plane.  Multiple
+   planes may be added, as long as they are mutually perpendicular.
+   
+   Forces and moments reported by the solver are those acting on the modelled half only.
+   
+   @param[in]   point    A point on the plane of symmetry.
+   @param[in]   normal   Normal of the plane of symmetry.
+*/
+void
+Solver::add_symmetry_plane(const Eigen::Vector3d &point, const Eigen::Vector3d &normal)
+{
+    Vector3d n = normal.normalized();
+
+    Transform<double, 3, Affine> reflection;
+    reflection.linear()      = Matrix3d::Identity() - 2 * n * n.transpose();
+    reflection.translation() = 2 * n.dot(point) * n;
+
+    // Combine with the images due to previously added planes:
+    int n_images = (int) symmetry_plane_images.size();
+
+    symmetry_plane_images.push_back(reflection);
+    for (int i = 0; i < n_images; i++)
+        symmetry_plane_images.push_back(reflection * symmetry_plane_images[i]);
+}
+
 /**
    Computes the velocity potential at the given point.
    
@@ -223,6 +420,25 @@ Solver::velocity(const Eigen::Vector3d &x) const
     return compute_velocity_interpolated(x, ignore_set);
 }
 
+/**
+   Computes the total stream velocity and the velocity potential at the given point.  Away from the body, both quantities
+   are obtained from a single evaluation of the panel geometry.
+   
+   @param[in]   x                    Reference point.
+   @param[out]  velocity             Stream velocity.
+   @param[out]  velocity_potential   Velocity potential.
+*/
+void
+Solver::velocity_and_velocity_potential(const Eigen::Vector3d &x, Eigen::Vector3d &velocity, double &velocity_potential) const
+{
+    std::set<int> ignore_set;
+    
+    if (compute_close_velocity(x, ignore_set, velocity))
+        velocity_potential = compute_velocity_potential(x);
+    else
+        compute_velocity_and_velocity_potential(x, velocity, velocity_potential);
+}
+
 /**
    Returns the surface velocity potential for the given panel.
    
@@ -504,8 +720,8 @@ Solver::trace_streamline(const SurfacePanelPoint &start) const
                 next_idx = i + 1;
               
             // Retrieve nodes in panel-local coordinates:  
-            const Vector3d &node_a = cur.surface->panel_transformed_points[cur.panel][i];
-            const Vector3d &node_b = cur.surface->panel_transformed_points[cur.panel][next_idx];
+            const Vector3d &node_a = (*cur.surface->panel_transformed_points)[cur.panel][i];
+            const Vector3d &node_b = (*cur.surface->panel_transformed_points)[cur.panel][next_idx];
             
             // Compute edge:
             Vector3d edge = node_b - node_a;
@@ -641,220 +857,158 @@ Solver::initialize_wakes(double dt)
 bool
 Solver::solve(double dt, bool propagate)
 {
-    int offset;
+    ThreadSettings thread_settings;
+    
+    // Check whether we can exploit cyclic symmetry:
+    bool cyclic_symmetry = false;
+    if (n_cyclic_sectors > 1) {
+        if (!symmetry_plane_images.empty()) {
+            cerr << "Solver: Cyclic symmetry cannot be combined with symmetry planes.  Solving the full system." << endl;
+        } else {
+            cyclic_symmetry = cyclic_symmetric_geometry();
+            if (!cyclic_symmetry)
+                cerr << "Solver: Geometry is not cyclically symmetric.  Solving the full system." << endl;
+        }
+    }
     
     // Iterate inviscid and boundary layer solutions until convergence.
     VectorXd previous_source_coefficients;
-    VectorXd previous_doublet_coefficients;
+    VectorXd initial_doublet_coefficients;
+    
+    // The matrix of doublet influence coefficients does not change during the boundary layer iteration.  For the full
+    // system, it is computed only once:
+    MatrixXd A;
+    OutOfCoreMatrix out_of_core_A;
     
     int boundary_layer_iteration = 0;
     
+    boundary_layer_acceleration.set_depth(Parameters::boundary_layer_acceleration_depth);
+    
     while (true) {
         // Copy state:
-        previous_source_coefficients  = source_coefficients;
-        previous_doublet_coefficients = doublet_coefficients;
+        previous_source_coefficients = source_coefficients;
+        
+        // Set up the initial guess for the doublet distribution.  In the first iteration, extrapolate from previous time steps.
+        if (boundary_layer_iteration == 0)
+            initial_doublet_coefficients = compute_doublet_coefficients_initial_guess();
+        else
+            initial_doublet_coefficients = doublet_coefficients;
         
-        // Compute new source distribution:
+        // Compute new source distribution.  The matrices of influence coefficients do not depend on it, and are computed 
+        // concurrently:
         cout << "Solver: Computing source distribution with wake influence." << endl;
         
-        offset = 0;
+        MatrixXd source_influence_coefficients;
+        VectorXd b;
         
-        vector<shared_ptr<Body::SurfaceData> >::const_iterator si;
-        for (si = non_wake_surfaces.begin(); si != non_wake_surfaces.end(); si++) {
-            const shared_ptr<Body::SurfaceData> &d = *si;
-            int i;
+        MatrixXd wake_influence_coefficients;
+        vector<int> upper_panels, lower_panels;
+        
+        bool factorize = false;
+        if (!cyclic_symmetry && Parameters::cache_body_influence_coefficients)
+            factorize = !body_influence_coefficients_valid();
             
-            const shared_ptr<BodyData> &bd = surface_to_body.find(d->surface)->second;
+        if (cyclic_symmetry) {
+            int n_sector_panels = n_non_wake_panels / n_cyclic_sectors;
             
-            #pragma omp parallel
-            {
-                #pragma omp for schedule(dynamic, 1)
-                for (i = 0; i < d->surface->n_panels(); i++)
-                    source_coefficients(offset + i) = compute_source_coefficient(bd->body, d->surface, i, bd->boundary_layer, true);
-            }
+            first_touch_resize(A, n_sector_panels);
+            first_touch_resize(source_influence_coefficients, n_sector_panels);
             
-            offset += d->surface->n_panels();
+        } else if (Parameters::cache_body_influence_coefficients) {
+            if (factorize) {
+                first_touch_resize(A, n_non_wake_panels);
+                first_touch_resize(body_source_influence_coefficients, n_non_wake_panels);
+            } else
+                A.resize(0, 0);
+            
+        } else if (boundary_layer_iteration == 0) {
+            if (Parameters::out_of_core) {
+                if (!out_of_core_A.allocate(n_non_wake_panels, Parameters::out_of_core_block_size, Parameters::scratch_directory))
+                    return false;
+            } else
+                first_touch_resize(A, n_non_wake_panels);
         }
-      
-        // Populate the matrices of influence coefficients:
-        cout << "Solver: Computing matrices of influence coefficients." << endl;
-        
-        MatrixXd A(n_non_wake_panels, n_non_wake_panels);
-        MatrixXd source_influence_coefficients(n_non_wake_panels, n_non_wake_panels);
-        
-        int offset_row = 0, offset_col = 0;
         
-        vector<shared_ptr<Body::SurfaceData> >::const_iterator si_row;
-        for (si_row = non_wake_surfaces.begin(); si_row != non_wake_surfaces.end(); si_row++) {
-            const shared_ptr<Body::SurfaceData> &d_row = *si_row;
-
-            offset_col = 0;
-     
-            // Influence coefficients between all non-wake surfaces:
-            vector<shared_ptr<Body::SurfaceData> >::const_iterator si_col;
-            for (si_col = non_wake_surfaces.begin(); si_col != non_wake_surfaces.end(); si_col++) {
-                shared_ptr<Body::SurfaceData> d_col = *si_col;
-                int i, j;
+        #pragma omp parallel
+        {
+            #pragma omp single
+            {
+                compute_source_coefficients(true);
                 
-                #pragma omp parallel private(j) 
-                {
-                    #pragma omp for schedule(dynamic, 1)
-                    for (i = 0; i < d_row->surface->n_panels(); i++) {
-                        for (j = 0; j < d_col->surface->n_panels(); j++) {
-                            d_col->surface->source_and_doublet_influence(d_row->surface, i, j,
-                                                                         source_influence_coefficients(offset_row + i, offset_col + j), 
-                                                                         A(offset_row + i, offset_col + j));
-                        }
-                    }
+                if (cyclic_symmetry) {
+                    compute_influence_coefficients(non_wake_surfaces.size() / n_cyclic_sectors, A, source_influence_coefficients);
+                    
+                } else if (Parameters::cache_body_influence_coefficients) {
+                    if (factorize)
+                        compute_body_influence_coefficients(non_wake_surfaces.size(), A, body_source_influence_coefficients);
+                    
+                    compute_kutta_influence_coefficients(non_wake_surfaces.size(), wake_influence_coefficients, upper_panels, lower_panels);
+                    
+                } else if (boundary_layer_iteration == 0) {
+                    if (Parameters::out_of_core)
+                        compute_influence_coefficients(out_of_core_A, b);
+                    else
+                        compute_influence_coefficients(A, b);
                 }
-                
-                offset_col = offset_col + d_col->surface->n_panels();
             }
+        }
+        
+        // From the second iteration onwards, the source distribution follows from the boundary layer solution.  Measure the 
+        // change, and extrapolate from the previous iterates if requested:
+        double delta = 0.0;
+        if (boundary_layer_iteration > 0) {
+            delta = (source_coefficients - previous_source_coefficients).norm();
             
-            // The influence of the new wake panels:
-            int i, j, lifting_surface_offset, wake_panel_offset, pa, pb;
-            vector<shared_ptr<BodyData> >::const_iterator bdi;
-            vector<shared_ptr<Body::SurfaceData> >::const_iterator si;
-            vector<shared_ptr<Body::LiftingSurfaceData> >::const_iterator lsi;
-            shared_ptr<BodyData> bd;
-            shared_ptr<Body::LiftingSurfaceData> d;
+            if (Parameters::boundary_layer_acceleration_depth > 0) {
+                cout << "Solver: Accelerating boundary layer iteration." << endl;
+                
+                source_coefficients = boundary_layer_acceleration.next_iterate(previous_source_coefficients, source_coefficients);
+            }
             
-            #pragma omp parallel private(bdi, si, lsi, lifting_surface_offset, j, wake_panel_offset, pa, pb, bd, d)
-            {
-                #pragma omp for schedule(dynamic, 1)
-                for (i = 0; i < d_row->surface->n_panels(); i++) {
-                    lifting_surface_offset = 0;      
-                    
-                    for (bdi = bodies.begin(); bdi != bodies.end(); bdi++) {
-                        bd = *bdi;
-                        
-                        for (si = bd->body->non_lifting_surfaces.begin(); si != bd->body->non_lifting_surfaces.end(); si++)
-                            lifting_surface_offset += (*si)->surface->n_panels();
-                                      
-                        for (lsi = bd->body->lifting_surfaces.begin(); lsi != bd->body->lifting_surfaces.end(); lsi++) {
-                            d = *lsi;
-                            
-                            wake_panel_offset = d->wake->n_panels() - d->lifting_surface->n_spanwise_panels();
-                            for (j = 0; j < d->lifting_surface->n_spanwise_panels(); j++) {  
-                                pa = d->lifting_surface->trailing_edge_upper_panel(j);
-                                pb = d->lifting_surface->trailing_edge_lower_panel(j);
-                                
-                                // Account for the influence of the new wake panels.  The doublet strength of these panels
-                                // is set according to the Kutta condition.
-                                A(offset_row + i, lifting_surface_offset + pa) += d->wake->doublet_influence(d_row->surface, i, wake_panel_offset + j);
-                                A(offset_row + i, lifting_surface_offset + pb) -= d->wake->doublet_influence(d_row->surface, i, wake_panel_offset + j);
-                            }
-                            
-                            lifting_surface_offset += d->lifting_surface->n_panels();
-                        }
-                    }
+            if (!cyclic_symmetry && !Parameters::cache_body_influence_coefficients) {
+                #pragma omp parallel
+                {
+                    #pragma omp single
+                    compute_right_hand_side(b);
                 }
             }
-                
-            offset_row = offset_row + d_row->surface->n_panels();
         }
-        
+      
         // Compute new doublet distribution:
-        cout << "Solver: Computing doublet distribution." << endl;
-        
-        VectorXd b = source_influence_coefficients * source_coefficients;
-        
-        BiCGSTAB<MatrixXd, DiagonalPreconditioner<double> > solver(A);
-        solver.setMaxIterations(Parameters::linear_solver_max_iterations);
-        solver.setTolerance(Parameters::linear_solver_tolerance);
-
-        doublet_coefficients = solver.solveWithGuess(b, previous_doublet_coefficients);
-        
-        if (solver.info() != Success) {
-            cerr << "Solver: Computing doublet distribution failed (" << solver.iterations();
-            cerr << " iterations with estimated error=" << solver.error() << ")." << endl;
-           
+        bool success;
+        if (cyclic_symmetry)
+            success = compute_doublet_coefficients_cyclic(A, source_influence_coefficients, initial_doublet_coefficients);
+        else if (Parameters::cache_body_influence_coefficients)
+            success = compute_doublet_coefficients_low_rank(A, wake_influence_coefficients, upper_panels, lower_panels);
+        else if (Parameters::out_of_core)
+            success = compute_doublet_coefficients(out_of_core_A, b, initial_doublet_coefficients);
+        else
+            success = compute_doublet_coefficients(DenseOperator(A), b, initial_doublet_coefficients);
+            
+        if (!success)
             return false;
-        }
-        
-        cout << "Solver: Done computing doublet distribution in " << solver.iterations() << " iterations with estimated error " << solver.error() << "." << endl;
 
         // Check for convergence from second iteration onwards.
         bool converged = false;
         if (boundary_layer_iteration > 0) {
-            double delta = (source_coefficients - previous_source_coefficients).norm();
-            
             cout << "Solver: Boundary layer convergence delta = " << delta << endl;
             
             if (delta < Parameters::boundary_layer_iteration_tolerance)
                 converged = true;
         }
         
-        // Set new wake panel doublet coefficients:
+        // Set new wake panel doublet coefficients, and compute the surface velocity distribution.  These are independent:
         cout << "Solver: Updating wake doublet distribution." << endl;
-        
-        offset = 0;
-        
-        vector<shared_ptr<BodyData> >::iterator bdi;
-        for (bdi = bodies.begin(); bdi != bodies.end(); bdi++) {
-            shared_ptr<BodyData> bd = *bdi;
-            
-            vector<shared_ptr<Body::SurfaceData> >::iterator si;
-            for (si = bd->body->non_lifting_surfaces.begin(); si != bd->body->non_lifting_surfaces.end(); si++)
-                offset += (*si)->surface->n_panels();
-            
-            vector<shared_ptr<Body::LiftingSurfaceData> >::iterator lsi;
-            for (lsi = bd->body->lifting_surfaces.begin(); lsi != bd->body->lifting_surfaces.end(); lsi++) {
-                shared_ptr<Body::LiftingSurfaceData> d = *lsi;
-                         
-                // Set panel doublet coefficient:
-                for (int i = 0; i < d->lifting_surface->n_spanwise_panels(); i++) {
-                    double doublet_coefficient_top    = doublet_coefficients(offset + d->lifting_surface->trailing_edge_upper_panel(i));
-                    double doublet_coefficient_bottom = doublet_coefficients(offset + d->lifting_surface->trailing_edge_lower_panel(i));
-                    
-                    // Use the trailing-edge Kutta condition to compute the doublet coefficients of the new wake panels.
-                    double doublet_coefficient = doublet_coefficient_top - doublet_coefficient_bottom;
-                    
-                    int idx = d->wake->n_panels() - d->lifting_surface->n_spanwise_panels() + i;
-                    d->wake->doublet_coefficients[idx] = doublet_coefficient;
-                }
-                
-                // Update offset:
-                offset += d->lifting_surface->n_panels();
-            }
-        }
-        
-        // Compute surface velocity distribution:
         cout << "Solver: Computing surface velocity distribution." << endl;
         
-        offset = 0;
-
-        for (bdi = bodies.begin(); bdi != bodies.end(); bdi++) {
-            shared_ptr<BodyData> bd = *bdi;
-            
-            vector<shared_ptr<Body::SurfaceData> >::const_iterator si;
-            for (si = bd->body->non_lifting_surfaces.begin(); si != bd->body->non_lifting_surfaces.end(); si++) {
-                const shared_ptr<Body::SurfaceData> &d = *si;
-                int i;
-                
-                #pragma omp parallel
-                {
-                    #pragma omp for schedule(dynamic, 1)
-                    for (i = 0; i < d->surface->n_panels(); i++)
-                        surface_velocities.row(offset + i) = compute_surface_velocity(bd->body, d->surface, i);
-                }
-                
-                offset += d->surface->n_panels();   
-            }
-            
-            vector<shared_ptr<Body::LiftingSurfaceData> >::const_iterator lsi;
-            for (lsi = bd->body->lifting_surfaces.begin(); lsi != bd->body->lifting_surfaces.end(); lsi++) {
-                const shared_ptr<Body::LiftingSurfaceData> &d = *lsi;
-                int i;
-                
-                #pragma omp parallel
-                {
-                    #pragma omp for schedule(dynamic, 1)
-                    for (i = 0; i < d->surface->n_panels(); i++)
-                        surface_velocities.row(offset + i) = compute_surface_velocity(bd->body, d->surface, i);
-                }  
+        #pragma omp parallel
+        {
+            #pragma omp single
+            {
+                #pragma omp task
+                compute_wake_doublet_coefficients();
                 
-                offset += d->surface->n_panels();                           
+                compute_surface_velocities();
             }
         }
 
@@ -872,9 +1026,11 @@ Solver::solve(double dt, bool propagate)
         }
         
         // Recompute the boundary layers.
-        offset = 0;
+        int offset = 0;
         
         bool have_boundary_layer = false;
+        
+        vector<shared_ptr<BodyData> >::iterator bdi;
         for (bdi = bodies.begin(); bdi != bodies.end(); bdi++) {
             shared_ptr<BodyData> bd = *bdi;
             
@@ -913,60 +1069,24 @@ Solver::solve(double dt, bool propagate)
         // Increase iteration counter:
         boundary_layer_iteration++;
     }
-
-    if (Parameters::convect_wake) {
-        // Recompute source distribution without wake influence:
-        cout << "Solver: Recomputing source distribution without wake influence." << endl;
-        
-        offset = 0;
-        
-        vector<shared_ptr<Body::SurfaceData> >::const_iterator si;
-        for (si = non_wake_surfaces.begin(); si != non_wake_surfaces.end(); si++) {
-            const shared_ptr<Body::SurfaceData> &d = *si;
-            int i;
-            
-            const shared_ptr<BodyData> &bd = surface_to_body.find(d->surface)->second;
-            
-            #pragma omp parallel
-            {
-                #pragma omp for schedule(dynamic, 1)
-                for (i = 0; i < d->surface->n_panels(); i++)
-                    source_coefficients(offset + i) = compute_source_coefficient(bd->body, d->surface, i, bd->boundary_layer, false);
-            }
-            
-            offset += d->surface->n_panels();
-        }
-    }
-
-    // Compute pressure distribution:
-    cout << "Solver: Computing pressure distribution." << endl;
     
-    offset = 0;
+    n_boundary_layer_iterations = boundary_layer_iteration;
 
-    vector<shared_ptr<Body::SurfaceData> >::const_iterator si;   
-    for (si = non_wake_surfaces.begin(); si != non_wake_surfaces.end(); si++) {
-        const shared_ptr<Body::SurfaceData> &d = *si;
-        int i;
-        
-        const shared_ptr<BodyData> &bd = surface_to_body.find(d->surface)->second;
-        double v_ref_squared = compute_reference_velocity_squared(bd->body);
-        
-        double dphidt;
-            
-        #pragma omp parallel private(dphidt)
+    // Recompute source distribution without wake influence, and compute the pressure distribution.  These are independent:
+    #pragma omp parallel
+    {
+        #pragma omp single
         {
-            #pragma omp for schedule(dynamic, 1)
-            for (i = 0; i < d->surface->n_panels(); i++) {
-                // Velocity potential:
-                surface_velocity_potentials(offset + i) = compute_surface_velocity_potential(d->surface, offset, i);
-                
-                // Pressure coefficient:
-                dphidt = compute_surface_velocity_potential_time_derivative(offset, i, dt);
-                pressure_coefficients(offset + i) = compute_pressure_coefficient(surface_velocities.row(offset + i), dphidt, v_ref_squared);
+            if (Parameters::convect_wake) {
+                cout << "Solver: Recomputing source distribution without wake influence." << endl;
+                
+                compute_source_coefficients(false);
             }
+            
+            cout << "Solver: Computing pressure distribution." << endl;
+            
+            compute_pressure_coefficients(dt);
         }
-        
-        offset += d->surface->n_panels();      
     }
     
     // Propagate solution forward in time, if requested.
@@ -978,31 +1098,471 @@ Solver::solve(double dt, bool propagate)
 }
 
 /**
-   Propagates solution forward in time.  Relevant in unsteady mode only.
-*/
-void
-Solver::propagate()
-{
-    // Store previous values of the surface velocity potentials:
-    previous_surface_velocity_potentials = surface_velocity_potentials;
-}
-
-/**
-   Convects existing wake nodes, and emits a new layer of wake panels.
+   Computes the forces and moments on all bodies for a batch of steady load cases, which differ only in the freestream
+   velocity and in the velocities of the bodies.  The geometry and the wakes are kept fixed.  
    
-   @param[in]   dt   Time step size.
+   The matrices of doublet and source influence coefficients are assembled once.  The matrix of doublet influence 
+   coefficients is factorized once, and the doublet distributions of all load cases are obtained from a single solve with 
+   multiple right-hand sides.  This is much cheaper than calling solve() for every load case, and is intended for the 
+   computation of stability derivatives.
+   
+   The boundary layers are not iterated upon, and the full system is solved in memory, irrespectively of the cyclic 
+   symmetry, low-rank, and out-of-core settings.  On return, the freestream velocity and the body velocities are restored, 
+   whereas the source, doublet, and pressure distributions are those of the last load case.
+   
+   @param[in]   load_cases   Load cases.
+   @param[in]   x            Reference point for the moments.
+   @param[out]  results      Forces and moments on the bodies, one entry per load case.
+   
+   @returns true on success.
 */
-void
-Solver::update_wakes(double dt)
+bool
+Solver::solve_load_cases(const std::vector<LoadCase, Eigen::aligned_allocator<LoadCase> > &load_cases, const Eigen::Vector3d &x,
+                         std::vector<LoadCaseResult> &results)
 {
-    // Do we convect wake panels?
-    if (Parameters::convect_wake) {
-        cout << "Solver: Convecting wakes." << endl;
+    ThreadSettings thread_settings;
+    
+    // Validate load cases:
+    for (int c = 0; c < (int) load_cases.size(); c++) {
+        if ((!load_cases[c].body_velocities.empty() && load_cases[c].body_velocities.size() != bodies.size()) ||
+            (!load_cases[c].body_rotational_velocities.empty() && load_cases[c].body_rotational_velocities.size() != bodies.size())) {
+            cerr << "Solver: Load case " << c << " does not specify the velocities of all bodies." << endl;
+            
+            return false;
+        }
+    }
+    
+    // Store the current kinematic state:
+    LoadCase current_load_case(freestream_velocity);
+    for (int i = 0; i < (int) bodies.size(); i++) {
+        current_load_case.body_velocities.push_back(bodies[i]->body->velocity);
+        current_load_case.body_rotational_velocities.push_back(bodies[i]->body->rotational_velocity);
+    }
+    
+    // Compute the source distributions of all load cases:
+    cout << "Solver: Computing source distributions for " << load_cases.size() << " load cases." << endl;
+    
+    MatrixXd load_case_source_coefficients(n_non_wake_panels, load_cases.size());
+    
+    for (int c = 0; c < (int) load_cases.size(); c++) {
+        set_load_case(load_cases[c]);
         
-        // Compute velocity values at wake nodes, with the wakes in their original state:
-        vector<vector<Vector3d, Eigen::aligned_allocator<Vector3d> >, Eigen::aligned_allocator<vector<Vector3d> > > wake_velocities;
+        #pragma omp parallel
+        {
+            #pragma omp single
+            compute_source_coefficients(true);
+        }
         
-        vector<shared_ptr<BodyData> >::const_iterator bdi;
+        load_case_source_coefficients.col(c) = source_coefficients;
+    }
+    
+    // Compute the matrices of influence coefficients:
+    MatrixXd A, source_influence_coefficients;
+    
+    first_touch_resize(A, n_non_wake_panels);
+    first_touch_resize(source_influence_coefficients, n_non_wake_panels);
+    
+    #pragma omp parallel
+    {
+        #pragma omp single
+        {
+            compute_body_influence_coefficients(non_wake_surfaces.size(), A, source_influence_coefficients);
+            
+            add_kutta_influence_coefficients(non_wake_surfaces.size(), A);
+        }
+    }
+    
+    // Compute the doublet distributions of all load cases:
+    cout << "Solver: Computing doublet distributions for " << load_cases.size() << " load cases." << endl;
+    
+    MatrixXd load_case_doublet_coefficients = A.partialPivLu().solve(source_influence_coefficients * load_case_source_coefficients);
+    
+    if (!load_case_doublet_coefficients.allFinite()) {
+        cerr << "Solver: Computing doublet distributions failed (singular matrix of influence coefficients)." << endl;
+        
+        set_load_case(current_load_case);
+        
+        return false;
+    }
+    
+    // Compute the forces and moments:
+    cout << "Solver: Computing forces and moments for " << load_cases.size() << " load cases." << endl;
+    
+    results.resize(load_cases.size());
+    
+    for (int c = 0; c < (int) load_cases.size(); c++) {
+        set_load_case(load_cases[c]);
+        
+        source_coefficients  = load_case_source_coefficients.col(c);
+        doublet_coefficients = load_case_doublet_coefficients.col(c);
+        
+        #pragma omp parallel
+        {
+            #pragma omp single
+            {
+                #pragma omp task
+                compute_wake_doublet_coefficients();
+                
+                compute_surface_velocities();
+                
+                #pragma omp taskwait
+                
+                if (Parameters::convect_wake)
+                    compute_source_coefficients(false);
+                
+                compute_pressure_coefficients(0.0);
+            }
+        }
+        
+        results[c].forces.clear();
+        results[c].moments.clear();
+        
+        for (int i = 0; i < (int) bodies.size(); i++) {
+            results[c].forces.push_back(force(bodies[i]->body));
+            results[c].moments.push_back(moment(bodies[i]->body, x));
+        }
+    }
+    
+    // Restore the kinematic state:
+    set_load_case(current_load_case);
+    
+    // Done:
+    return true;
+}
+
+/**
+   Computes the sensitivities of an objective function with respect to the node positions of all non-wake surfaces, and with
+   respect to the velocities of all bodies, using the discrete adjoint of the panel equations.  The objective function is
+   
+   J = f . F + m . M,
+   
+   where F and M are the force and the moment on the given body, as computed by force() and moment(), and f and m are weight
+   vectors.  Lift, drag, or moment coefficients are obtained by an appropriate choice of weights.
+   
+   A single adjoint system, with the transpose of the matrix of influence coefficients, is solved, irrespectively of the number
+   of design variables.  The partial derivatives of the panel equations and of the objective function with respect to a
+   node position only involve the panels adjacent to the node, and are evaluated by central differences.  The partial 
+   derivatives with respect to the body velocities are exact.
+   
+   This function must be called after solve().  The sensitivities are those of the steady solution:  The wakes are held 
+   fixed, the time derivative of the velocity potential is not taken into account, and boundary layer friction is treated 
+   as a constant.  If Parameters::cache_body_influence_coefficients is set, and the cached factorization of the matrix of body
+   influence coefficients is still valid, the adjoint system is solved with the transpose of the factorization, and a 
+   low-rank update for the Kutta condition.  Otherwise, the full system is assembled in memory, irrespectively of the cyclic 
+   symmetry and out-of-core settings.
+   
+   @param[in]   body             Body on which the force and moment act.
+   @param[in]   force_weights    Weight vector f for the force.
+   @param[in]   moment_weights   Weight vector m for the moment.
+   @param[in]   x                Reference point for the moment.
+   @param[out]  sensitivities    Derivatives of the objective function.
+   
+   @returns true on success.
+*/
+bool
+Solver::adjoint_sensitivities(const std::shared_ptr<Body> &body, const Eigen::Vector3d &force_weights, const Eigen::Vector3d &moment_weights,
+                              const Eigen::Vector3d &x, Sensitivities &sensitivities)
+{
+    ThreadSettings thread_settings;
+    
+    // The panel equations include the influence of the wakes on the source distribution:
+    VectorXd previous_source_coefficients = source_coefficients;
+    
+    #pragma omp parallel
+    {
+        #pragma omp single
+        compute_source_coefficients(true);
+    }
+    
+    VectorXd sources = source_coefficients;
+    
+    source_coefficients = previous_source_coefficients;
+    
+    // Compute the derivative of the objective function with respect to the doublet distribution:
+    cout << "Solver: Computing adjoint right-hand side." << endl;
+    
+    VectorXd objective_gradient = compute_objective_doublet_gradient(body, force_weights, moment_weights, x);
+    
+    MatrixXd wake_influence_coefficients;
+    vector<int> upper_panels, lower_panels;
+    
+    VectorXd adjoint, adjoint_sources;
+    
+    if (Parameters::cache_body_influence_coefficients && body_influence_coefficients_valid()) {
+        // Reuse the cached factorization of the matrix of body influence coefficients:
+        #pragma omp parallel
+        {
+            #pragma omp single
+            compute_kutta_influence_coefficients(non_wake_surfaces.size(), wake_influence_coefficients, upper_panels, lower_panels);
+        }
+        
+        if (!compute_adjoint_low_rank(objective_gradient, wake_influence_coefficients, upper_panels, lower_panels, adjoint))
+            return false;
+        
+        // The panel equations depend on the body velocities only by means of the source distribution:
+        adjoint_sources = body_source_influence_coefficients.transpose() * adjoint;
+        
+    } else {
+        // Compute the matrices of influence coefficients:
+        MatrixXd A, source_influence_coefficients;
+        
+        first_touch_resize(A, n_non_wake_panels);
+        first_touch_resize(source_influence_coefficients, n_non_wake_panels);
+        
+        #pragma omp parallel
+        {
+            #pragma omp single
+            {
+                compute_body_influence_coefficients(non_wake_surfaces.size(), A, source_influence_coefficients);
+                
+                add_kutta_influence_coefficients(non_wake_surfaces.size(), A);
+            }
+        }
+        
+        // List the trailing edge panels.  Without any rows, no wake influence coefficients are computed:
+        compute_kutta_influence_coefficients(0, wake_influence_coefficients, upper_panels, lower_panels);
+        
+        // Solve the adjoint system:
+        cout << "Solver: Computing adjoint doublet distribution." << endl;
+        
+        A.transposeInPlace();
+        
+        DenseOperator A_transpose(A);
+        BiCGSTAB<LinearOperator, LinearOperator::Preconditioner> solver(A_transpose);
+        solver.setMaxIterations(Parameters::linear_solver_max_iterations);
+        solver.setTolerance(Parameters::linear_solver_tolerance);
+        
+        adjoint = solver.solve(objective_gradient);
+        
+        if (solver.info() != Success) {
+            cerr << "Solver: Computing adjoint doublet distribution failed (" << solver.iterations();
+            cerr << " iterations with estimated error=" << solver.error() << ")." << endl;
+            
+            return false;
+        }
+        
+        cout << "Solver: Done computing adjoint doublet distribution in " << solver.iterations() << " iterations with estimated error " << solver.error() << "." << endl;
+        
+        A.resize(0, 0);
+        
+        // The panel equations depend on the body velocities only by means of the source distribution:
+        adjoint_sources = source_influence_coefficients.transpose() * adjoint;
+    }
+    
+    // Compute the sensitivities with respect to the body velocities.  The objective function is quadratic, and the source 
+    // distribution is linear in the body velocities, so that central differences with a unit step are exact:
+    cout << "Solver: Computing sensitivities with respect to body velocities." << endl;
+    
+    sensitivities.body_velocities.clear();
+    sensitivities.body_rotational_velocities.clear();
+    
+    for (int b = 0; b < (int) bodies.size(); b++) {
+        const shared_ptr<BodyData> &bd = bodies[b];
+        
+        // List the panels of the body:
+        vector<int> body_panels;
+        
+        int offset = 0;
+        for (int k = 0; k < (int) non_wake_surfaces.size(); k++) {
+            const shared_ptr<Surface> &surface = non_wake_surfaces[k]->surface;
+            
+            if (surface_to_body.find(surface)->second == bd) {
+                for (int i = 0; i < surface->n_panels(); i++)
+                    body_panels.push_back(offset + i);
+            }
+            
+            offset += surface->n_panels();
+        }
+        
+        Vector3d velocity            = bd->body->velocity;
+        Vector3d rotational_velocity = bd->body->rotational_velocity;
+        
+        Vector3d velocity_sensitivities, rotational_velocity_sensitivities;
+        
+        for (int rotational = 0; rotational < 2; rotational++) {
+            for (int d = 0; d < 3; d++) {
+                double objective[2], adjoint_residual[2];
+                
+                for (int sign = 0; sign < 2; sign++) {
+                    Vector3d perturbation = Vector3d::Zero();
+                    perturbation(d) = (sign == 0 ? 1.0 : -1.0);
+                    
+                    if (rotational)
+                        bd->body->set_rotational_velocity(rotational_velocity + perturbation);
+                    else
+                        bd->body->set_velocity(velocity + perturbation);
+                    
+                    objective[sign] = compute_objective(body, force_weights, moment_weights, x);
+                    
+                    // The influence of the wakes on the source distribution does not depend on the body velocities:
+                    adjoint_residual[sign] = 0.0;
+                    for (int i = 0; i < (int) body_panels.size(); i++) {
+                        int surface_index, panel;
+                        compute_surface_panel(body_panels[i], surface_index, panel);
+                        
+                        const shared_ptr<Surface> &surface = non_wake_surfaces[surface_index]->surface;
+                        
+                        double source_coefficient = compute_source_coefficient(bd->body, surface, panel, bd->boundary_layer, false);
+                        
+                        adjoint_residual[sign] -= adjoint_sources(body_panels[i]) * source_coefficient;
+                    }
+                }
+                
+                bd->body->set_velocity(velocity);
+                bd->body->set_rotational_velocity(rotational_velocity);
+                
+                double sensitivity = 0.5 * (objective[0] - objective[1]) - 0.5 * (adjoint_residual[0] - adjoint_residual[1]);
+                
+                if (rotational)
+                    rotational_velocity_sensitivities(d) = sensitivity;
+                else
+                    velocity_sensitivities(d) = sensitivity;
+            }
+        }
+        
+        sensitivities.body_velocities.push_back(velocity_sensitivities);
+        sensitivities.body_rotational_velocities.push_back(rotational_velocity_sensitivities);
+    }
+    
+    // Compute the sensitivities with respect to the node positions:
+    cout << "Solver: Computing sensitivities with respect to node positions." << endl;
+    
+    sensitivities.nodes.clear();
+    
+    int offset = 0;
+    for (int k = 0; k < (int) non_wake_surfaces.size(); k++) {
+        const shared_ptr<Surface> &surface = non_wake_surfaces[k]->surface;
+        const shared_ptr<BodyData> &bd = surface_to_body.find(surface)->second;
+        
+        MatrixXd node_sensitivities = MatrixXd::Zero(3, surface->n_nodes());
+        
+        for (int node = 0; node < surface->n_nodes(); node++) {
+            const vector<int> &node_panels = *surface->node_panel_neighbors[node];
+            if (node_panels.empty())
+                continue;
+                
+            // Panels of which the geometry depends on the node:
+            vector<int> panels;
+            for (int i = 0; i < (int) node_panels.size(); i++)
+                panels.push_back(offset + node_panels[i]);
+            
+            // Panels of which the contribution to the objective function depends on the node, by means of their own geometry
+            // or that of their neighbors:
+            set<int> objective_panels;
+            if (bd->body == body) {
+                for (int i = 0; i < (int) node_panels.size(); i++) {
+                    objective_panels.insert(offset + node_panels[i]);
+                    
+                    vector<Body::SurfacePanelEdge> neighbors = body->panel_neighbors(surface, node_panels[i]);
+                    for (int j = 0; j < (int) neighbors.size(); j++)
+                        objective_panels.insert(compute_index(neighbors[j].surface, neighbors[j].panel));
+                }
+            }
+            
+            Vector3d node_position = surface->nodes[node];
+            
+            double h = NODE_PERTURBATION * sqrt(surface->panel_surface_area(node_panels[0]));
+            
+            for (int d = 0; d < 3; d++) {
+                double objective[2], adjoint_residual[2];
+                
+                for (int sign = 0; sign < 2; sign++) {
+                    surface->nodes[node](d) = node_position(d) + (sign == 0 ? h : -h);
+                    for (int i = 0; i < (int) node_panels.size(); i++)
+                        surface->compute_geometry(node_panels[i]);
+                    
+                    objective[sign] = 0.0;
+                    
+                    set<int>::const_iterator it;
+                    for (it = objective_panels.begin(); it != objective_panels.end(); it++) {
+                        int surface_index, panel;
+                        compute_surface_panel(*it, surface_index, panel);
+                        
+                        objective[sign] += compute_panel_objective(body, non_wake_surfaces[surface_index]->surface, panel, force_weights, moment_weights, x);
+                    }
+                    
+                    VectorXd perturbed_sources = sources;
+                    for (int i = 0; i < (int) node_panels.size(); i++)
+                        perturbed_sources(offset + node_panels[i]) = compute_source_coefficient(bd->body, surface, node_panels[i], bd->boundary_layer, true);
+                    
+                    adjoint_residual[sign] = compute_adjoint_residual(adjoint, perturbed_sources, panels, upper_panels, lower_panels);
+                }
+                
+                surface->nodes[node] = node_position;
+                for (int i = 0; i < (int) node_panels.size(); i++)
+                    surface->compute_geometry(node_panels[i]);
+                
+                node_sensitivities(d, node) = (objective[0] - objective[1]) / (2 * h) - (adjoint_residual[0] - adjoint_residual[1]) / (2 * h);
+            }
+        }
+        
+        sensitivities.nodes[surface] = node_sensitivities;
+        
+        offset += surface->n_panels();
+    }
+    
+    // Done:
+    return true;
+}
+
+/**
+   Returns the number of boundary layer iterations performed by the last call to solve().
+   
+   @returns Number of boundary layer iterations.
+*/
+int
+Solver::boundary_layer_iterations() const
+{
+    return n_boundary_layer_iterations;
+}
+
+/**
+   Propagates solution forward in time.  Relevant in unsteady mode only.
+*/
+void
+Solver::propagate()
+{
+    // Store previous values of the surface velocity potentials:
+    previous_surface_velocity_potentials = surface_velocity_potentials;
+    
+    // Store doublet distribution history, for the extrapolation of the initial guess:
+    previous_doublet_coefficients.insert(previous_doublet_coefficients.begin(), doublet_coefficients);
+    if ((int) previous_doublet_coefficients.size() > max(Parameters::doublet_extrapolation_order, 0) + 1)
+        previous_doublet_coefficients.resize(max(Parameters::doublet_extrapolation_order, 0) + 1);
+}
+
+/**
+   Convects existing wake nodes, and emits a new layer of wake panels.
+   
+   @param[in]   dt   Time step size.
+*/
+void
+Solver::update_wakes(double dt)
+{
+    ThreadSettings thread_settings;
+    
+    // Do we convect wake panels?
+    if (Parameters::convect_wake) {
+        cout << "Solver: Convecting wakes." << endl;
+        
+        // With cyclic symmetry, the velocities at the wake nodes of the first sector determine those of all other sectors:
+        bool cyclic_symmetry = false;
+        if (n_cyclic_sectors > 1 && symmetry_plane_images.empty())
+            cyclic_symmetry = cyclic_symmetric_geometry() && cyclic_symmetric_flow();
+            
+        map<shared_ptr<Surface>, int> cyclic_sector_surface_index;
+        if (cyclic_symmetry) {
+            for (int i = 0; i < (int) non_wake_surfaces.size(); i++)
+                cyclic_sector_surface_index[non_wake_surfaces[i]->surface] = i;
+        }
+        
+        int n_sector_surfaces = non_wake_surfaces.size() / max(n_cyclic_sectors, 1);
+        
+        // Compute velocity values at wake nodes, with the wakes in their original state:
+        vector<vector<Vector3d, Eigen::aligned_allocator<Vector3d> >, Eigen::aligned_allocator<vector<Vector3d, Eigen::aligned_allocator<Vector3d> > > > wake_velocities;
+        map<shared_ptr<Surface>, int> wake_velocities_index;
+        
+        vector<shared_ptr<BodyData> >::const_iterator bdi;
         for (bdi = bodies.begin(); bdi != bodies.end(); bdi++) {
             const shared_ptr<BodyData> &bd = *bdi;
                  
@@ -1015,13 +1575,28 @@ Solver::update_wakes(double dt)
                 
                 int i;
                 
-                #pragma omp parallel
-                {
-                    #pragma omp for schedule(dynamic, 1)
+                int surface_index = -1;
+                if (cyclic_symmetry)
+                    surface_index = cyclic_sector_surface_index[d->surface];
+                
+                if (surface_index >= n_sector_surfaces) {
+                    // Rotate the velocities of the corresponding wake in the previous sector:
+                    const shared_ptr<Surface> &prev_surface = non_wake_surfaces[surface_index - n_sector_surfaces]->surface;
+                    const vector<Vector3d, Eigen::aligned_allocator<Vector3d> > &prev_wake_velocities = wake_velocities[wake_velocities_index[prev_surface]];
+                    
                     for (i = 0; i < d->wake->n_nodes(); i++)
-                        local_wake_velocities[i] = velocity(d->wake->nodes[i]);
+                        local_wake_velocities[i] = cyclic_sector_rotation * prev_wake_velocities[i];
+                        
+                } else {
+                    #pragma omp parallel
+                    {
+                        #pragma omp for schedule(dynamic, 1)
+                        for (i = 0; i < d->wake->n_nodes(); i++)
+                            local_wake_velocities[i] = velocity(d->wake->nodes[i]);
+                    }
                 }
                 
+                wake_velocities_index[d->surface] = wake_velocities.size();
                 wake_velocities.push_back(local_wake_velocities);
             }
         }
@@ -1088,148 +1663,1766 @@ Solver::update_wakes(double dt)
                                      - Parameters::static_wake_length * body_apparent_velocity / body_apparent_velocity.norm();
                 }
                 
-                // Need to update geometry:
-                d->wake->compute_geometry();
+                // Need to update geometry:
+                d->wake->compute_geometry();
+            }
+        }
+    }
+}
+
+/**
+   Logs source and doublet distributions, as well as the pressure coefficients, into files in the logging folder
+   tagged with the specified step number.
+   
+   @param[in]   step_number   Step number used to name the output files.
+   @param[in]   writer        SurfaceWriter object to use.
+*/
+void
+Solver::log(int step_number, SurfaceWriter &writer) const
+{   
+    // Log coefficients: 
+    int offset = 0;
+    int save_node_offset = 0;
+    int save_panel_offset = 0;
+    int idx;
+    
+    vector<shared_ptr<BodyData> >::const_iterator bdi;
+    for (bdi = bodies.begin(); bdi != bodies.end(); bdi++) {
+        const shared_ptr<BodyData> &bd = *bdi;
+        
+        // Iterate non-lifting surfaces:
+        idx = 0;
+        
+        vector<shared_ptr<Body::SurfaceData> >::const_iterator si;
+        for (si = bd->body->non_lifting_surfaces.begin(); si != bd->body->non_lifting_surfaces.end(); si++) {
+            const shared_ptr<Body::SurfaceData> &d = *si;
+            
+            // Log non-lifting surface coefficients.  The views refer directly to the global arrays:
+            vector<string> view_names;
+            vector<SurfaceWriter::ViewData> view_data;
+            
+            view_names.push_back(VIEW_NAME_DOUBLET_DISTRIBUTION);
+            view_data.push_back(panel_rows_view(doublet_coefficients, offset, d->surface->n_panels()));
+            
+            view_names.push_back(VIEW_NAME_SOURCE_DISTRIBUTION);
+            view_data.push_back(panel_rows_view(source_coefficients, offset, d->surface->n_panels()));
+            
+            view_names.push_back(VIEW_NAME_PRESSURE_DISTRIBUTION);
+            view_data.push_back(panel_rows_view(pressure_coefficients, offset, d->surface->n_panels()));
+            
+            view_names.push_back(VIEW_NAME_VELOCITY_DISTRIBUTION);
+            view_data.push_back(panel_rows_view(surface_velocities, offset, d->surface->n_panels()));
+            
+            stringstream ss;
+            ss << log_folder << "/" << bd->body->id << "/" << d->surface->id << "/step_" << step_number << writer.file_extension();
+
+            writer.write(d->surface, ss.str(), save_node_offset, save_panel_offset, view_names, view_data);
+            
+            offset += d->surface->n_panels();
+            
+            save_node_offset += d->surface->n_nodes();
+            save_panel_offset += d->surface->n_panels();
+            
+            idx++;
+        }   
+        
+        // Iterate lifting surfaces:
+        idx = 0;
+        
+        vector<shared_ptr<Body::LiftingSurfaceData> >::const_iterator lsi;
+        for (lsi = bd->body->lifting_surfaces.begin(); lsi != bd->body->lifting_surfaces.end(); lsi++) {
+            const shared_ptr<Body::LiftingSurfaceData> &d = *lsi;
+            
+            // Log lifting surface coefficients.  The views refer directly to the global arrays:
+            vector<string> view_names;
+            vector<SurfaceWriter::ViewData> view_data;
+            
+            view_names.push_back(VIEW_NAME_DOUBLET_DISTRIBUTION);
+            view_data.push_back(panel_rows_view(doublet_coefficients, offset, d->lifting_surface->n_panels()));
+            
+            view_names.push_back(VIEW_NAME_SOURCE_DISTRIBUTION);
+            view_data.push_back(panel_rows_view(source_coefficients, offset, d->lifting_surface->n_panels()));
+            
+            view_names.push_back(VIEW_NAME_PRESSURE_DISTRIBUTION);
+            view_data.push_back(panel_rows_view(pressure_coefficients, offset, d->lifting_surface->n_panels()));
+            
+            view_names.push_back(VIEW_NAME_VELOCITY_DISTRIBUTION);
+            view_data.push_back(panel_rows_view(surface_velocities, offset, d->lifting_surface->n_panels()));
+            
+            stringstream ss;
+            ss << log_folder << "/" << bd->body->id << "/" << d->lifting_surface->id << "/step_" << step_number << writer.file_extension();
+
+            writer.write(d->lifting_surface, ss.str(), save_node_offset, save_panel_offset, view_names, view_data);
+            
+            offset += d->lifting_surface->n_panels();
+            
+            save_node_offset += d->lifting_surface->n_nodes();
+            save_panel_offset += d->lifting_surface->n_panels();
+    
+            // Log wake surface and coefficients:
+            view_names.clear();
+            view_data.clear();
+            
+            view_names.push_back(VIEW_NAME_DOUBLET_DISTRIBUTION);
+            view_data.push_back(SurfaceWriter::ViewData(d->wake->doublet_coefficients.data(), d->wake->doublet_coefficients.size(), 1,
+                                                        OuterStride<>(d->wake->doublet_coefficients.size())));
+            
+            stringstream ssw;
+            ssw << log_folder << "/" << bd->body->id << "/" << d->wake->id << "/step_" << step_number << writer.file_extension();
+            
+            writer.write(d->wake, ssw.str(), 0, save_panel_offset, view_names, view_data);
+            
+            save_node_offset += d->wake->n_nodes();
+            save_panel_offset += d->wake->n_panels();
+            
+            idx++;
+        }
+    }
+}
+
+/**
+   Saves the full state of the unsteady solution to a checkpoint file, from which the run can be resumed using 
+   load_checkpoint().
+   
+   The checkpoint contains the kinematic state of the bodies, the node positions and panel geometry of all surfaces, the
+   wake panels with their doublet distributions and any wake model state, and the source, doublet, velocity, and pressure 
+   distributions, including the history required by the unsteady Bernoulli equation, by the extrapolation of the initial
+   guess, and by the recycling of Krylov subspaces.  Resuming a run from a checkpoint therefore reproduces the original run 
+   exactly.  The panel topology of the bodies is not stored.
+   
+   The checkpoint is serialized immediately.  If asynchronous is true, the file is written by a background thread, and this
+   method returns without waiting for the write to complete.  Errors are then reported by flush_checkpoints().  The previous 
+   checkpoint of the same name is only replaced once the new checkpoint has been written completely.
+   
+   @param[in]   filename       Checkpoint filename.
+   @param[in]   asynchronous   Write the checkpoint file in the background.
+   
+   @returns true on success.
+*/
+bool
+Solver::save_checkpoint(const std::string &filename, bool asynchronous)
+{
+    cout << "Solver: Saving checkpoint to " << filename << "." << endl;
+    
+    shared_ptr<CheckpointWriter> checkpoint = make_shared<CheckpointWriter>();
+    
+    // Bodies and their surfaces:
+    checkpoint->write_int(bodies.size());
+    
+    vector<shared_ptr<BodyData> >::const_iterator bdi;
+    for (bdi = bodies.begin(); bdi != bodies.end(); bdi++) {
+        const shared_ptr<BodyData> &bd = *bdi;
+        
+        checkpoint->write_string(bd->body->id);
+        
+        checkpoint->write_doubles(bd->body->position.data(), 3);
+        checkpoint->write_doubles(bd->body->velocity.data(), 3);
+        checkpoint->write_doubles(bd->body->attitude.coeffs().data(), 4);
+        checkpoint->write_doubles(bd->body->rotational_velocity.data(), 3);
+        
+        checkpoint->write_int(bd->body->non_lifting_surfaces.size());
+        checkpoint->write_int(bd->body->lifting_surfaces.size());
+        
+        vector<shared_ptr<Body::SurfaceData> >::const_iterator si;
+        for (si = bd->body->non_lifting_surfaces.begin(); si != bd->body->non_lifting_surfaces.end(); si++) {
+            const shared_ptr<Body::SurfaceData> &d = *si;
+            
+            d->surface->save_state(*checkpoint);
+        }
+        
+        vector<shared_ptr<Body::LiftingSurfaceData> >::const_iterator lsi;
+        for (lsi = bd->body->lifting_surfaces.begin(); lsi != bd->body->lifting_surfaces.end(); lsi++) {
+            const shared_ptr<Body::LiftingSurfaceData> &d = *lsi;
+            
+            d->lifting_surface->save_state(*checkpoint);
+            
+            d->wake->save_state(*checkpoint);
+        }
+    }
+    
+    // Flow and solution:
+    checkpoint->write_doubles(freestream_velocity.data(), 3);
+    checkpoint->write_double(fluid_density);
+    
+    checkpoint->write_vector(source_coefficients);
+    checkpoint->write_vector(doublet_coefficients);
+    checkpoint->write_vector(surface_velocity_potentials);
+    checkpoint->write_matrix(surface_velocities);
+    checkpoint->write_vector(pressure_coefficients);
+    
+    checkpoint->write_vector(previous_surface_velocity_potentials);
+    
+    checkpoint->write_int(previous_doublet_coefficients.size());
+    for (int i = 0; i < (int) previous_doublet_coefficients.size(); i++)
+        checkpoint->write_vector(previous_doublet_coefficients[i]);
+        
+    checkpoint->write_matrix(recycled_gmres.recycled_subspace());
+    
+    checkpoint->write_int(n_boundary_layer_iterations);
+    
+    // Write:
+    if (asynchronous) {
+        if (!checkpoint_queue)
+            checkpoint_queue = make_shared<AsyncWriteQueue>(1);
+            
+        checkpoint_queue->push(bind(&CheckpointWriter::save, checkpoint, filename));
+        
+        return true;
+        
+    } else
+        return checkpoint->save(filename);
+}
+
+/**
+   Restores the state of the unsteady solution from a checkpoint file written by save_checkpoint().  
+   
+   The solver must have been set up with the same bodies, built in the same way, as the solver that saved the checkpoint.  
+   The wakes need not be initialized;  their panels are restored from the checkpoint.  The boundary layer models are not
+   part of the checkpoint.
+   
+   Since the bodies are restored to their saved positions and attitudes, a cached factorization of the matrix of body 
+   influence coefficients is discarded, and recomputed in the next call to solve().  The resumed run then agrees with the
+   original run to within round-off, rather than exactly.
+   
+   If loading fails, the state of the solver is undefined.
+   
+   @param[in]   filename   Checkpoint filename.
+   
+   @returns true on success.
+*/
+bool
+Solver::load_checkpoint(const std::string &filename)
+{
+    // Make sure that a pending write of the same checkpoint has completed:
+    flush_checkpoints();
+    
+    cout << "Solver: Loading checkpoint from " << filename << "." << endl;
+    
+    CheckpointReader checkpoint;
+    if (!checkpoint.load(filename))
+        return false;
+        
+    // Bodies and their surfaces:
+    int n_bodies = checkpoint.read_int();
+    if (!checkpoint.valid() || n_bodies != (int) bodies.size()) {
+        cerr << "Solver: Checkpoint " << filename << " contains " << n_bodies << " bodies instead of " << bodies.size() << "." << endl;
+        
+        return false;
+    }
+    
+    vector<shared_ptr<BodyData> >::iterator bdi;
+    for (bdi = bodies.begin(); bdi != bodies.end(); bdi++) {
+        shared_ptr<BodyData> bd = *bdi;
+        
+        string id = checkpoint.read_string();
+        
+        Vector3d position, velocity, rotational_velocity;
+        Quaterniond attitude;
+        
+        checkpoint.read_doubles(position.data(), 3);
+        checkpoint.read_doubles(velocity.data(), 3);
+        checkpoint.read_doubles(attitude.coeffs().data(), 4);
+        checkpoint.read_doubles(rotational_velocity.data(), 3);
+        
+        int n_non_lifting_surfaces = checkpoint.read_int();
+        int n_lifting_surfaces     = checkpoint.read_int();
+        
+        if (!checkpoint.valid() || id != bd->body->id || 
+            n_non_lifting_surfaces != (int) bd->body->non_lifting_surfaces.size() || n_lifting_surfaces != (int) bd->body->lifting_surfaces.size()) {
+            cerr << "Solver: Checkpoint " << filename << " does not match body " << bd->body->id << "." << endl;
+            
+            return false;
+        }
+        
+        // The node positions and the panel geometry are restored along with the surfaces, so the kinematic state is set directly:
+        bd->body->position            = position;
+        bd->body->velocity            = velocity;
+        bd->body->attitude            = attitude;
+        bd->body->rotational_velocity = rotational_velocity;
+        
+        vector<shared_ptr<Body::SurfaceData> >::iterator si;
+        for (si = bd->body->non_lifting_surfaces.begin(); si != bd->body->non_lifting_surfaces.end(); si++) {
+            shared_ptr<Body::SurfaceData> d = *si;
+            
+            if (!d->surface->load_state(checkpoint))
+                return false;
+        }
+        
+        vector<shared_ptr<Body::LiftingSurfaceData> >::iterator lsi;
+        for (lsi = bd->body->lifting_surfaces.begin(); lsi != bd->body->lifting_surfaces.end(); lsi++) {
+            shared_ptr<Body::LiftingSurfaceData> d = *lsi;
+            
+            if (!d->lifting_surface->load_state(checkpoint))
+                return false;
+                
+            if (!d->wake->load_state(checkpoint))
+                return false;
+        }
+    }
+    
+    // Flow and solution:
+    checkpoint.read_doubles(freestream_velocity.data(), 3);
+    fluid_density = checkpoint.read_double();
+    
+    VectorXd stored_source_coefficients, stored_doublet_coefficients, stored_surface_velocity_potentials, stored_pressure_coefficients;
+    MatrixXd stored_surface_velocities;
+    
+    checkpoint.read_vector(stored_source_coefficients);
+    checkpoint.read_vector(stored_doublet_coefficients);
+    checkpoint.read_vector(stored_surface_velocity_potentials);
+    checkpoint.read_matrix(stored_surface_velocities);
+    checkpoint.read_vector(stored_pressure_coefficients);
+    
+    VectorXd stored_previous_surface_velocity_potentials;
+    checkpoint.read_vector(stored_previous_surface_velocity_potentials);
+    
+    int n_previous_doublet_coefficients = checkpoint.read_int();
+    
+    vector<VectorXd, Eigen::aligned_allocator<VectorXd> > stored_previous_doublet_coefficients;
+    for (int i = 0; i < n_previous_doublet_coefficients && checkpoint.valid(); i++) {
+        VectorXd stored_doublet_coefficients;
+        checkpoint.read_vector(stored_doublet_coefficients);
+        
+        if (stored_doublet_coefficients.size() != n_non_wake_panels) {
+            cerr << "Solver: Checkpoint " << filename << " does not match the number of panels." << endl;
+            
+            return false;
+        }
+        
+        stored_previous_doublet_coefficients.push_back(stored_doublet_coefficients);
+    }
+    
+    MatrixXd recycled_subspace;
+    checkpoint.read_matrix(recycled_subspace);
+    
+    int stored_n_boundary_layer_iterations = checkpoint.read_int();
+    
+    if (!checkpoint.valid() || !checkpoint.at_end()) {
+        cerr << "Solver: Checkpoint " << filename << " is corrupt." << endl;
+        
+        return false;
+    }
+    
+    if (stored_source_coefficients.size() != n_non_wake_panels || stored_doublet_coefficients.size() != n_non_wake_panels ||
+        stored_surface_velocity_potentials.size() != n_non_wake_panels || stored_pressure_coefficients.size() != n_non_wake_panels ||
+        stored_surface_velocities.rows() != n_non_wake_panels || stored_surface_velocities.cols() != 3 ||
+        stored_previous_surface_velocity_potentials.size() != n_non_wake_panels ||
+        (recycled_subspace.cols() > 0 && recycled_subspace.rows() != n_non_wake_panels)) {
+        cerr << "Solver: Checkpoint " << filename << " does not match the number of panels." << endl;
+        
+        return false;
+    }
+    
+    source_coefficients         = stored_source_coefficients;
+    doublet_coefficients        = stored_doublet_coefficients;
+    surface_velocity_potentials = stored_surface_velocity_potentials;
+    surface_velocities          = stored_surface_velocities;
+    pressure_coefficients       = stored_pressure_coefficients;
+    
+    previous_surface_velocity_potentials = stored_previous_surface_velocity_potentials;
+    previous_doublet_coefficients        = stored_previous_doublet_coefficients;
+    
+    recycled_gmres.set_recycled_subspace(recycled_subspace);
+    
+    n_boundary_layer_iterations = stored_n_boundary_layer_iterations;
+    
+    // Discard the cached factorization of the matrix of body influence coefficients:
+    body_influence_coefficients_nodes.resize(3, 0);
+    
+    return true;
+}
+
+/**
+   Waits until all checkpoints saved asynchronously have been written.
+   
+   @returns true if all checkpoints written since the previous call were written successfully.
+*/
+bool
+Solver::flush_checkpoints()
+{
+    if (!checkpoint_queue)
+        return true;
+        
+    return checkpoint_queue->flush();
+}
+ 
+/**
+   Checks whether the non-wake surfaces and their wakes are cyclically symmetric, as configured using set_cyclic_symmetry().
+   
+   @returns true if the geometry is cyclically symmetric.
+*/
+bool
+Solver::cyclic_symmetric_geometry() const
+{
+    if ((int) non_wake_surfaces.size() % n_cyclic_sectors != 0)
+        return false;
+        
+    int n_sector_surfaces = non_wake_surfaces.size() / n_cyclic_sectors;
+    
+    // Establish a length scale for the tolerance:
+    double length_scale = 0.0;
+    for (int i = 0; i < n_sector_surfaces; i++) {
+        const shared_ptr<Surface> &surface = non_wake_surfaces[i]->surface;
+        for (int j = 0; j < surface->n_nodes(); j++)
+            length_scale = max(length_scale, (surface->nodes[j] - cyclic_axis_point).norm());
+    }
+    
+    double tolerance = CYCLIC_SYMMETRY_TOLERANCE * max(length_scale, 1.0);
+    
+    // Compare every sector with its predecessor:
+    for (int k = 1; k < n_cyclic_sectors; k++) {
+        for (int i = 0; i < n_sector_surfaces; i++) {
+            const shared_ptr<Body::SurfaceData> &d_prev = non_wake_surfaces[(k - 1) * n_sector_surfaces + i];
+            const shared_ptr<Body::SurfaceData> &d      = non_wake_surfaces[k * n_sector_surfaces + i];
+            
+            // Compare topology:
+            if (d->surface->n_nodes() != d_prev->surface->n_nodes() || d->surface->n_panels() != d_prev->surface->n_panels())
+                return false;
+                
+            for (int j = 0; j < d->surface->n_panels(); j++) {
+                if (d->surface->panel_nodes[j] != d_prev->surface->panel_nodes[j])
+                    return false;
+            }
+            
+            // Compare geometry:
+            vector<shared_ptr<Surface> > surfaces, prev_surfaces;
+            surfaces.push_back(d->surface);
+            prev_surfaces.push_back(d_prev->surface);
+            
+            shared_ptr<LiftingSurface> lifting_surface      = dynamic_pointer_cast<LiftingSurface>(d->surface);
+            shared_ptr<LiftingSurface> prev_lifting_surface = dynamic_pointer_cast<LiftingSurface>(d_prev->surface);
+            if ((lifting_surface && !prev_lifting_surface) || (!lifting_surface && prev_lifting_surface))
+                return false;
+                
+            if (lifting_surface) {
+                const Body::LiftingSurfaceData *ld      = static_cast<const Body::LiftingSurfaceData *>(d.get());
+                const Body::LiftingSurfaceData *ld_prev = static_cast<const Body::LiftingSurfaceData *>(d_prev.get());
+                
+                for (int j = 0; j < lifting_surface->n_spanwise_panels(); j++) {
+                    if (lifting_surface->trailing_edge_upper_panel(j) != prev_lifting_surface->trailing_edge_upper_panel(j) ||
+                        lifting_surface->trailing_edge_lower_panel(j) != prev_lifting_surface->trailing_edge_lower_panel(j))
+                        return false;
+                }
+                
+                if (ld->wake->n_nodes() != ld_prev->wake->n_nodes())
+                    return false;
+                    
+                surfaces.push_back(ld->wake);
+                prev_surfaces.push_back(ld_prev->wake);
+            }
+            
+            for (int l = 0; l < (int) surfaces.size(); l++) {
+                for (int j = 0; j < surfaces[l]->n_nodes(); j++) {
+                    Vector3d rotated_node = cyclic_axis_point + cyclic_sector_rotation * (prev_surfaces[l]->nodes[j] - cyclic_axis_point);
+                    if ((surfaces[l]->nodes[j] - rotated_node).norm() > tolerance)
+                        return false;
+                }
+            }
+        }
+    }
+    
+    // Done:
+    return true;
+}
+
+/**
+   Checks whether the apparent velocities of all bodies are cyclically symmetric, i.e., whether the apparent velocities are 
+   parallel to the axis of symmetry, and whether all bodies rotate about the axis of symmetry.
+   
+   @returns true if the flow is cyclically symmetric.
+*/
+bool
+Solver::cyclic_symmetric_flow() const
+{
+    vector<shared_ptr<BodyData> >::const_iterator bdi;
+    for (bdi = bodies.begin(); bdi != bodies.end(); bdi++) {
+        const shared_ptr<BodyData> &bd = *bdi;
+        
+        Vector3d apparent_velocity = bd->body->velocity - freestream_velocity;
+        if (apparent_velocity.cross(cyclic_axis_direction).norm() > CYCLIC_SYMMETRY_TOLERANCE * max(apparent_velocity.norm(), 1.0))
+            return false;
+            
+        if (bd->body->rotational_velocity.cross(cyclic_axis_direction).norm() > CYCLIC_SYMMETRY_TOLERANCE * max(bd->body->rotational_velocity.norm(), 1.0))
+            return false;
+            
+        Vector3d arm = bd->body->position - cyclic_axis_point;
+        if (arm.cross(cyclic_axis_direction).norm() > CYCLIC_SYMMETRY_TOLERANCE * max(arm.norm(), 1.0))
+            return false;
+    }
+    
+    return true;
+}
+
+/**
+   Computes the matrices of doublet and source influence coefficients for the collocation points of the first n_row_surfaces
+   non-wake surfaces.  The influence of the newest row of wake panels is added to the doublet influence coefficients of the
+   trailing edge panels, following the Kutta condition.
+   
+   The coefficients are computed by OpenMP tasks.  This function waits for all child tasks of the calling task to complete,
+   including those spawned before it was called.
+   
+   @param[in]   n_row_surfaces                  Number of non-wake surfaces for which to compute the rows.
+   @param[out]  A                               Doublet influence coefficients, of the correct size.
+   @param[out]  source_influence_coefficients   Source influence coefficients, of the correct size.
+*/
+void
+Solver::compute_influence_coefficients(int n_row_surfaces, Eigen::MatrixXd &A, Eigen::MatrixXd &source_influence_coefficients) const
+{
+    compute_body_influence_coefficients(n_row_surfaces, A, source_influence_coefficients);
+    
+    add_kutta_influence_coefficients(n_row_surfaces, A);
+}
+
+/**
+   Computes the matrix of doublet influence coefficients for the collocation points of all non-wake surfaces, together with the
+   right-hand side of the panel equations.  The matrix of source influence coefficients is not stored:  every tile of source
+   influence coefficients is multiplied with the source distribution as soon as it has been computed.  The influence of the
+   newest row of wake panels is added to the doublet influence coefficients of the trailing edge panels, following the Kutta
+   condition.
+   
+   The coefficients are computed by OpenMP tasks.  Every tile waits for the task that computes the source coefficients of its
+   columns, as spawned by compute_source_coefficients().  Every tile stores its contribution to the right-hand side separately,
+   and the contributions are summed in tile order once all tiles are complete, so that the right-hand side does not depend on
+   the order in which the tasks are executed.  This function waits for all child tasks of the calling task to complete, 
+   including those spawned before it was called.
+   
+   @param[out]  A   Doublet influence coefficients, of the correct size.
+   @param[out]  b   Right-hand side.
+*/
+void
+Solver::compute_influence_coefficients(Eigen::MatrixXd &A, Eigen::VectorXd &b) const
+{
+    cout << "Solver: Computing matrix of influence coefficients and right-hand side." << endl;
+    
+    vector<InfluenceTile> tiles = compute_influence_tiles(0, n_non_wake_panels);
+    
+    MatrixXd tile_b(INFLUENCE_TILE_SIZE, tiles.size());
+    for (int t = 0; t < (int) tiles.size(); t++) {
+        const InfluenceTile &tile = tiles[t];
+        
+        #pragma omp task firstprivate(t, tile) shared(A, tile_b) depend(in: source_coefficients.data()[tile.col_offset + tile.col_begin])
+        compute_body_influence_coefficients_tile(tile, A, tile_b.col(t));
+    }
+    
+    add_kutta_influence_coefficients(non_wake_surfaces.size(), A);
+    
+    b.resize(n_non_wake_panels);
+    
+    sum_tile_right_hand_sides(tiles, tile_b, b);
+}
+
+/**
+   Computes the out-of-core matrix of doublet influence coefficients for the collocation points of all non-wake surfaces, 
+   together with the right-hand side of the panel equations.  The matrix is assembled one block of rows at a time.  Every block
+   is released from memory once it is complete.
+   
+   The coefficients are computed by OpenMP tasks.  As for the in-core matrix, the contributions of the tiles to the right-hand
+   side are summed in tile order.  This function waits for all child tasks of the calling task to complete, including those 
+   spawned before it was called.
+   
+   @param[out]  A   Out-of-core doublet influence coefficients, of the correct size.
+   @param[out]  b   Right-hand side.
+*/
+void
+Solver::compute_influence_coefficients(OutOfCoreMatrix &A, Eigen::VectorXd &b) const
+{
+    cout << "Solver: Computing out-of-core matrix of influence coefficients and right-hand side." << endl;
+    
+    b.resize(n_non_wake_panels);
+    
+    // The influence of the new wake panels, and the source distribution, are needed to complete every block:
+    MatrixXd wake_influence_coefficients;
+    vector<int> upper_panels, lower_panels;
+    
+    compute_kutta_influence_coefficients(non_wake_surfaces.size(), wake_influence_coefficients, upper_panels, lower_panels);
+    
+    #pragma omp taskwait
+    
+    for (int k = 0; k < A.n_blocks(); k++) {
+        Map<MatrixXd> A_block = A.block(k);
+        Map<VectorXd> b_block(b.data() + A.block_begin(k), A.block_rows(k));
+        
+        vector<InfluenceTile> tiles = compute_influence_tiles(A.block_begin(k), A.block_begin(k) + A.block_rows(k));
+        
+        MatrixXd tile_b(INFLUENCE_TILE_SIZE, tiles.size());
+        for (int t = 0; t < (int) tiles.size(); t++) {
+            const InfluenceTile &tile = tiles[t];
+            
+            #pragma omp task firstprivate(t, tile) shared(A_block, tile_b)
+            compute_body_influence_coefficients_tile(tile, A_block, tile_b.col(t));
+        }
+        
+        #pragma omp taskwait
+        
+        sum_tile_right_hand_sides(tiles, tile_b, b_block);
+        
+        // Apply the Kutta condition:
+        for (int j = 0; j < (int) upper_panels.size(); j++) {
+            A_block.col(upper_panels[j]) += wake_influence_coefficients.block(A.block_begin(k), j, A.block_rows(k), 1);
+            A_block.col(lower_panels[j]) -= wake_influence_coefficients.block(A.block_begin(k), j, A.block_rows(k), 1);
+        }
+        
+        A.release(k);
+    }
+}
+
+/**
+   Computes the right-hand side of the panel equations for the current source distribution, without storing the matrix of 
+   source influence coefficients.  This is used when the source distribution changes, but the geometry does not.
+   
+   The right-hand side is computed by OpenMP tasks.  This function first waits for all child tasks of the calling task to complete,
+   so that the source distribution is available.  The tasks spawned by it are complete after the next taskwait or barrier.
+   
+   @param[out]  b   Right-hand side.
+*/
+void
+Solver::compute_right_hand_side(Eigen::VectorXd &b) const
+{
+    cout << "Solver: Computing right-hand side." << endl;
+    
+    b.resize(n_non_wake_panels);
+    
+    #pragma omp taskwait
+    
+    int row_offset = 0;
+    for (int s_row = 0; s_row < (int) non_wake_surfaces.size(); s_row++) {
+        for (int row = 0; row < non_wake_surfaces[s_row]->surface->n_panels(); row += PANEL_TASK_SIZE) {
+            int row_end = min(row + PANEL_TASK_SIZE, non_wake_surfaces[s_row]->surface->n_panels());
+            
+            #pragma omp task firstprivate(s_row, row_offset, row, row_end) shared(b)
+            {
+                const shared_ptr<Surface> &row_surface = non_wake_surfaces[s_row]->surface;
+                
+                for (int i = row; i < row_end; i++) {
+                    b(row_offset + i) = 0.0;
+                    
+                    int col_offset = 0;
+                    for (int s_col = 0; s_col < (int) non_wake_surfaces.size(); s_col++) {
+                        const shared_ptr<Surface> &col_surface = non_wake_surfaces[s_col]->surface;
+                        
+                        for (int j = 0; j < col_surface->n_panels(); j++) {
+                            double source_influence = col_surface->source_influence(row_surface, i, j);
+                            
+                            // Add the influence of the mirror images:
+                            for (int k = 0; k < (int) symmetry_plane_images.size(); k++)
+                                source_influence += col_surface->source_influence(symmetry_plane_images[k] * row_surface->panel_collocation_point(i, true), j);
+                                
+                            b(row_offset + i) += source_influence * source_coefficients(col_offset + j);
+                        }
+                        
+                        col_offset += col_surface->n_panels();
+                    }
+                }
+            }
+        }
+        
+        row_offset += non_wake_surfaces[s_row]->surface->n_panels();
+    }
+}
+
+/**
+   Adds the influence of the newest row of wake panels to the doublet influence coefficients of the trailing edge panels, 
+   following the Kutta condition.  This function waits for all child tasks of the calling task to complete, including those 
+   spawned before it was called.
+   
+   @param[in]       n_row_surfaces   Number of non-wake surfaces for which to compute the rows.
+   @param[in,out]   A                Doublet influence coefficients.
+*/
+void
+Solver::add_kutta_influence_coefficients(int n_row_surfaces, Eigen::MatrixXd &A) const
+{
+    // The doublet strength of the new wake panels is set according to the Kutta condition:
+    MatrixXd wake_influence_coefficients;
+    vector<int> upper_panels, lower_panels;
+    
+    compute_kutta_influence_coefficients(n_row_surfaces, wake_influence_coefficients, upper_panels, lower_panels);
+    
+    #pragma omp taskwait
+    
+    for (int j = 0; j < (int) upper_panels.size(); j++) {
+        A.col(upper_panels[j]) += wake_influence_coefficients.col(j);
+        A.col(lower_panels[j]) -= wake_influence_coefficients.col(j);
+    }
+}
+
+/**
+   Partitions the rows row_begin to row_end of the matrices of influence coefficients into tiles of at most INFLUENCE_TILE_SIZE
+   rows and columns.  The tiles do not cross surface boundaries.  The row offsets of the tiles are relative to row_begin.
+   
+   @param[in]   row_begin   Index of the first row.
+   @param[in]   row_end     Index of the row after the last row.
+   
+   @returns List of tiles.
+*/
+vector<Solver::InfluenceTile>
+Solver::compute_influence_tiles(int row_begin, int row_end) const
+{
+    // Compute surface offsets:
+    vector<int> surface_offsets(non_wake_surfaces.size() + 1);
+    
+    surface_offsets[0] = 0;
+    for (int i = 0; i < (int) non_wake_surfaces.size(); i++)
+        surface_offsets[i + 1] = surface_offsets[i] + non_wake_surfaces[i]->surface->n_panels();
+        
+    // List tiles:
+    vector<InfluenceTile> tiles;
+    
+    for (int s_row = 0; s_row < (int) non_wake_surfaces.size(); s_row++) {
+        int surface_row_begin = max(row_begin - surface_offsets[s_row], 0);
+        int surface_row_end   = min(row_end - surface_offsets[s_row], non_wake_surfaces[s_row]->surface->n_panels());
+        
+        for (int row = surface_row_begin; row < surface_row_end; row += INFLUENCE_TILE_SIZE) {
+            for (int s_col = 0; s_col < (int) non_wake_surfaces.size(); s_col++) {
+                for (int col = 0; col < non_wake_surfaces[s_col]->surface->n_panels(); col += INFLUENCE_TILE_SIZE) {
+                    InfluenceTile tile;
+                    tile.row_surface = s_row;
+                    tile.row_offset  = surface_offsets[s_row] - row_begin;
+                    tile.row_begin   = row;
+                    tile.row_end     = min(row + INFLUENCE_TILE_SIZE, surface_row_end);
+                    tile.col_surface = s_col;
+                    tile.col_offset  = surface_offsets[s_col];
+                    tile.col_begin   = col;
+                    tile.col_end     = min(col + INFLUENCE_TILE_SIZE, non_wake_surfaces[s_col]->surface->n_panels());
+                    
+                    tiles.push_back(tile);
+                }
+            }
+        }
+    }
+    
+    return tiles;
+}
+
+/**
+   Resizes a matrix of influence coefficients to the given number of rows and a column for every non-wake panel, and touches its 
+   memory pages in parallel.  Every thread zeroes the block of rows assigned to it by DenseOperator::thread_rows(), which is the 
+   block of rows it multiplies in DenseOperator::multiply().  On NUMA systems, every row block is thus placed on the memory node 
+   of the thread that reads it in the matrix-vector products of the Krylov solvers.
+   
+   As the matrix is stored in column-major order, a row block consists of a contiguous segment of every column.  Only the pages 
+   on which two segments meet are shared between threads, so that the placement is accurate once every thread has at least a 
+   few pages worth of rows.
+   
+   @param[out]  M      Matrix to resize.
+   @param[in]   rows   Number of rows.
+*/
+void
+Solver::first_touch_resize(Eigen::MatrixXd &M, int rows) const
+{
+    M.resize(rows, n_non_wake_panels);
+    
+    #pragma omp parallel
+    {
+        int begin, end;
+        DenseOperator::thread_rows(rows, begin, end);
+        
+        M.middleRows(begin, end - begin).setZero();
+    }
+}
+
+/**
+   Computes the matrices of doublet and source influence coefficients between the collocation points of the first n_row_surfaces
+   non-wake surfaces, and all non-wake panels.  Wakes are not taken into account.
+   
+   The matrices are partitioned into tiles of at most INFLUENCE_TILE_SIZE rows and columns, which do not cross surface
+   boundaries.  Every tile is computed by a separate OpenMP task.  The tasks are complete after the next taskwait or barrier.
+   
+   @param[in]   n_row_surfaces                  Number of non-wake surfaces for which to compute the rows.
+   @param[out]  A                               Doublet influence coefficients, of the correct size.
+   @param[out]  source_influence_coefficients   Source influence coefficients, of the correct size.
+*/
+void
+Solver::compute_body_influence_coefficients(int n_row_surfaces, Eigen::MatrixXd &A, Eigen::MatrixXd &source_influence_coefficients) const
+{
+    cout << "Solver: Computing matrices of influence coefficients." << endl;
+    
+    int n_rows = 0;
+    for (int i = 0; i < n_row_surfaces; i++)
+        n_rows += non_wake_surfaces[i]->surface->n_panels();
+        
+    vector<InfluenceTile> tiles = compute_influence_tiles(0, n_rows);
+    for (int t = 0; t < (int) tiles.size(); t++) {
+        const InfluenceTile &tile = tiles[t];
+        
+        #pragma omp task firstprivate(tile) shared(A, source_influence_coefficients)
+        compute_body_influence_coefficients_tile(tile, A, source_influence_coefficients);
+    }
+}
+
+/**
+   Computes a single tile of the matrices of doublet and source influence coefficients.
+   
+   @param[in]   tile                            Tile to compute.
+   @param[out]  A                               Doublet influence coefficients.
+   @param[out]  source_influence_coefficients   Source influence coefficients.
+*/
+void
+Solver::compute_body_influence_coefficients_tile(const InfluenceTile &tile, Eigen::MatrixXd &A, Eigen::MatrixXd &source_influence_coefficients) const
+{
+    const shared_ptr<Surface> &row_surface = non_wake_surfaces[tile.row_surface]->surface;
+    const shared_ptr<Surface> &col_surface = non_wake_surfaces[tile.col_surface]->surface;
+    
+    for (int i = tile.row_begin; i < tile.row_end; i++) {
+        for (int j = tile.col_begin; j < tile.col_end; j++) {
+            col_surface->source_and_doublet_influence(row_surface, i, j,
+                                                      source_influence_coefficients(tile.row_offset + i, tile.col_offset + j), 
+                                                      A(tile.row_offset + i, tile.col_offset + j));
+        }
+        
+        // Add the influence of the mirror images:
+        for (int k = 0; k < (int) symmetry_plane_images.size(); k++) {
+            Vector3d x = symmetry_plane_images[k] * row_surface->panel_collocation_point(i, true);
+            
+            for (int j = tile.col_begin; j < tile.col_end; j++) {
+                double source_influence, doublet_influence;
+                
+                col_surface->source_and_doublet_influence(x, j, source_influence, doublet_influence);
+                
+                source_influence_coefficients(tile.row_offset + i, tile.col_offset + j) += source_influence;
+                A(tile.row_offset + i, tile.col_offset + j)                             += doublet_influence;
+            }
+        }
+    }
+}
+
+/**
+   Computes a single tile of the matrix of doublet influence coefficients, together with the product of the corresponding tile of
+   source influence coefficients with the source distribution.
+   
+   @param[in]   tile     Tile to compute.
+   @param[out]  A        Doublet influence coefficients, starting at the row that the tile row offset is relative to.
+   @param[out]  tile_b   Contribution of the tile to the right-hand side, starting at the first row of the tile.
+*/
+void
+Solver::compute_body_influence_coefficients_tile(const InfluenceTile &tile, Eigen::Ref<Eigen::MatrixXd> A, Eigen::Ref<Eigen::VectorXd> tile_b) const
+{
+    const shared_ptr<Surface> &row_surface = non_wake_surfaces[tile.row_surface]->surface;
+    const shared_ptr<Surface> &col_surface = non_wake_surfaces[tile.col_surface]->surface;
+    
+    for (int i = tile.row_begin; i < tile.row_end; i++) {
+        double b_i = 0.0;
+        
+        for (int j = tile.col_begin; j < tile.col_end; j++) {
+            double source_influence;
+            
+            col_surface->source_and_doublet_influence(row_surface, i, j, source_influence, A(tile.row_offset + i, tile.col_offset + j));
+            
+            b_i += source_influence * source_coefficients(tile.col_offset + j);
+        }
+        
+        // Add the influence of the mirror images:
+        for (int k = 0; k < (int) symmetry_plane_images.size(); k++) {
+            Vector3d x = symmetry_plane_images[k] * row_surface->panel_collocation_point(i, true);
+            
+            for (int j = tile.col_begin; j < tile.col_end; j++) {
+                double source_influence, doublet_influence;
+                
+                col_surface->source_and_doublet_influence(x, j, source_influence, doublet_influence);
+                
+                A(tile.row_offset + i, tile.col_offset + j) += doublet_influence;
+                
+                b_i += source_influence * source_coefficients(tile.col_offset + j);
+            }
+        }
+        
+        tile_b(i - tile.row_begin) = b_i;
+    }
+}
+
+/**
+   Sums the contributions of the tiles to the right-hand side, in tile order.
+   
+   @param[in]   tiles    List of tiles.
+   @param[in]   tile_b   Contributions of the tiles to the right-hand side, one column per tile.
+   @param[out]  b        Right-hand side, starting at the row that the tile row offsets are relative to.
+*/
+void
+Solver::sum_tile_right_hand_sides(const std::vector<InfluenceTile> &tiles, const Eigen::MatrixXd &tile_b, Eigen::Ref<Eigen::VectorXd> b) const
+{
+    b.setZero();
+    
+    for (int t = 0; t < (int) tiles.size(); t++) {
+        const InfluenceTile &tile = tiles[t];
+        
+        int n_rows = tile.row_end - tile.row_begin;
+        
+        b.segment(tile.row_offset + tile.row_begin, n_rows) += tile_b.col(t).head(n_rows);
+    }
+}
+
+/**
+   Computes the doublet influence coefficients of the newest row of wake panels, for the collocation points of the first
+   n_row_surfaces non-wake surfaces.  Following the Kutta condition, the doublet strength of new wake panel j equals the 
+   difference of the doublet strengths of the trailing edge panels upper_panels[j] and lower_panels[j].  
+   
+   The coefficients are computed by OpenMP tasks, which are complete after the next taskwait or barrier.  The panel index lists
+   are available immediately.
+   
+   @param[in]   n_row_surfaces                Number of non-wake surfaces for which to compute the rows.
+   @param[out]  wake_influence_coefficients   Doublet influence coefficients of the new wake panels.
+   @param[out]  upper_panels                  Indices of the upper trailing edge panels.
+   @param[out]  lower_panels                  Indices of the lower trailing edge panels.
+*/
+void
+Solver::compute_kutta_influence_coefficients(int n_row_surfaces, Eigen::MatrixXd &wake_influence_coefficients, std::vector<int> &upper_panels, std::vector<int> &lower_panels) const
+{
+    // List the new wake panels, together with the trailing edge panels that they are attached to:
+    vector<shared_ptr<Body::LiftingSurfaceData> > lifting_surfaces;
+    
+    upper_panels.clear();
+    lower_panels.clear();
+    
+    int lifting_surface_offset = 0;
+    
+    vector<shared_ptr<BodyData> >::const_iterator bdi;
+    for (bdi = bodies.begin(); bdi != bodies.end(); bdi++) {
+        const shared_ptr<BodyData> &bd = *bdi;
+        
+        vector<shared_ptr<Body::SurfaceData> >::const_iterator si;
+        for (si = bd->body->non_lifting_surfaces.begin(); si != bd->body->non_lifting_surfaces.end(); si++)
+            lifting_surface_offset += (*si)->surface->n_panels();
+                      
+        vector<shared_ptr<Body::LiftingSurfaceData> >::const_iterator lsi;
+        for (lsi = bd->body->lifting_surfaces.begin(); lsi != bd->body->lifting_surfaces.end(); lsi++) {
+            const shared_ptr<Body::LiftingSurfaceData> &d = *lsi;
+            
+            lifting_surfaces.push_back(d);
+            
+            for (int j = 0; j < d->lifting_surface->n_spanwise_panels(); j++) {
+                upper_panels.push_back(lifting_surface_offset + d->lifting_surface->trailing_edge_upper_panel(j));
+                lower_panels.push_back(lifting_surface_offset + d->lifting_surface->trailing_edge_lower_panel(j));
+            }
+            
+            lifting_surface_offset += d->lifting_surface->n_panels();
+        }
+    }
+    
+    int n_rows = 0;
+    for (int i = 0; i < n_row_surfaces; i++)
+        n_rows += non_wake_surfaces[i]->surface->n_panels();
+    
+    wake_influence_coefficients.resize(n_rows, upper_panels.size());
+    
+    // Spawn one task per block of collocation points and wake:
+    int row_offset = 0;
+    for (int s_row = 0; s_row < n_row_surfaces; s_row++) {
+        for (int row = 0; row < non_wake_surfaces[s_row]->surface->n_panels(); row += PANEL_TASK_SIZE) {
+            int row_end = min(row + PANEL_TASK_SIZE, non_wake_surfaces[s_row]->surface->n_panels());
+            
+            int col_offset = 0;
+            for (int k = 0; k < (int) lifting_surfaces.size(); k++) {
+                shared_ptr<Wake> wake = lifting_surfaces[k]->wake;
+                int n_wake_panels = lifting_surfaces[k]->lifting_surface->n_spanwise_panels();
+                
+                #pragma omp task firstprivate(s_row, row_offset, row, row_end, wake, n_wake_panels, col_offset) shared(wake_influence_coefficients)
+                {
+                    const shared_ptr<Surface> &row_surface = non_wake_surfaces[s_row]->surface;
+                    
+                    int wake_panel_offset = wake->n_panels() - n_wake_panels;
+                    
+                    for (int i = row; i < row_end; i++) {
+                        Vector3d x = row_surface->panel_collocation_point(i, true);
+                        
+                        for (int j = 0; j < n_wake_panels; j++) {
+                            double &w = wake_influence_coefficients(row_offset + i, col_offset + j);
+                            
+                            w = wake->doublet_influence(x, wake_panel_offset + j);
+                            
+                            // Add the influence of the mirror images:
+                            for (int l = 0; l < (int) symmetry_plane_images.size(); l++)
+                                w += wake->doublet_influence(symmetry_plane_images[l] * x, wake_panel_offset + j);
+                        }
+                    }
+                }
+                
+                col_offset += n_wake_panels;
+            }
+        }
+        
+        row_offset += non_wake_surfaces[s_row]->surface->n_panels();
+    }
+}
+
+/**
+   Computes the initial guess for the doublet distribution, by polynomial extrapolation of the doublet distributions of the 
+   previous time steps.  The order of the extrapolation is set by Parameters::doublet_extrapolation_order, and is limited by the
+   number of available time steps.
+   
+   @returns Initial guess for the doublet distribution.
+*/
+Eigen::VectorXd
+Solver::compute_doublet_coefficients_initial_guess() const
+{
+    int order = min(Parameters::doublet_extrapolation_order, (int) previous_doublet_coefficients.size() - 1);
+    
+    switch (order) {
+    case 1:
+        cout << "Solver: Extrapolating doublet distribution linearly." << endl;
+        
+        return 2 * previous_doublet_coefficients[0] - previous_doublet_coefficients[1];
+        
+    case 2:
+        cout << "Solver: Extrapolating doublet distribution quadratically." << endl;
+        
+        return 3 * previous_doublet_coefficients[0] - 3 * previous_doublet_coefficients[1] + previous_doublet_coefficients[2];
+        
+    default:
+        return doublet_coefficients;
+    }
+}
+
+/**
+   Computes the doublet distribution by solving the full system of panel equations.  The matrix of influence coefficients
+   is only accessed by means of matrix-vector products.
+   
+   @param[in]   A               Doublet influence coefficients.
+   @param[in]   b               Right-hand side.
+   @param[in]   initial_guess   Initial guess for the doublet distribution.
+   
+   @returns true on success.
+*/
+bool
+Solver::compute_doublet_coefficients(const LinearOperator &A, const Eigen::VectorXd &b, const Eigen::VectorXd &initial_guess)
+{
+    // Compute new doublet distribution:
+    cout << "Solver: Computing doublet distribution." << endl;
+    
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    
+    int iterations;
+    double error;
+    bool success;
+    
+    if (Parameters::recycle_krylov_subspace) {
+        recycled_gmres.set_max_iterations(Parameters::linear_solver_max_iterations);
+        recycled_gmres.set_tolerance(Parameters::linear_solver_tolerance);
+        recycled_gmres.set_restart(Parameters::gmres_restart, Parameters::n_recycled_krylov_vectors);
+        
+        doublet_coefficients = initial_guess;
+        
+        success    = recycled_gmres.solve(A, b, doublet_coefficients);
+        iterations = recycled_gmres.iterations();
+        error      = recycled_gmres.error();
+        
+    } else {
+        BiCGSTAB<LinearOperator, LinearOperator::Preconditioner> solver(A);
+        solver.setMaxIterations(Parameters::linear_solver_max_iterations);
+        solver.setTolerance(Parameters::linear_solver_tolerance);
+
+        doublet_coefficients = solver.solveWithGuess(b, initial_guess);
+        
+        success    = (solver.info() == Success);
+        iterations = solver.iterations();
+        error      = solver.error();
+    }
+    
+    double elapsed_time = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    
+    if (!success) {
+        cerr << "Solver: Computing doublet distribution failed (" << iterations;
+        cerr << " iterations with estimated error=" << error << ")." << endl;
+       
+        return false;
+    }
+    
+    cout << "Solver: Done computing doublet distribution in " << iterations << " iterations with estimated error " << error;
+    cout << " (" << elapsed_time << " s)." << endl;
+    
+    return true;
+}
+
+/**
+   Computes the doublet distribution using a cached factorization of the matrix of body influence coefficients.
+   
+   The matrix of influence coefficients is the sum of the matrix B of body influence coefficients, and the influence
+   W V^T of the new wake panels, which is of rank equal to the number of trailing edge panels.  Here, the columns of W contain
+   the influence coefficients of the new wake panels, and V maps the doublet distribution onto the differences across the
+   trailing edges.  The system is solved using the Sherman-Morrison-Woodbury formula,
+   
+   (B + W V^T)^-1 b = B^-1 b - B^-1 W (I + V^T B^-1 W)^-1 V^T B^-1 b.
+   
+   B is only recomputed, and factorized, when the bodies do not move as a single rigid body.
+   
+   @param[in]   A                             Matrix B of body influence coefficients to factorize, or an empty matrix if the
+                                              cached factorization is still valid.
+   @param[in]   wake_influence_coefficients   Doublet influence coefficients W of the new wake panels.
+   @param[in]   upper_panels                  Indices of the upper trailing edge panels.
+   @param[in]   lower_panels                  Indices of the lower trailing edge panels.
+   
+   @returns true on success.
+*/
+bool
+Solver::compute_doublet_coefficients_low_rank(const Eigen::MatrixXd &A, const Eigen::MatrixXd &wake_influence_coefficients, const std::vector<int> &upper_panels, const std::vector<int> &lower_panels)
+{
+    // Factorize the matrix of body influence coefficients, if it was recomputed:
+    if (A.size() > 0) {
+        cout << "Solver: Factorizing matrix of body influence coefficients." << endl;
+        
+        body_influence_coefficients_lu.compute(A);
+        
+        body_influence_coefficients_nodes = compute_non_wake_nodes();
+    }
+    
+    // Compute new doublet distribution:
+    cout << "Solver: Computing doublet distribution using a low-rank update for the Kutta condition." << endl;
+    
+    VectorXd b = body_source_influence_coefficients * source_coefficients;
+    
+    VectorXd body_doublet_coefficients = body_influence_coefficients_lu.solve(b);
+    
+    if (upper_panels.size() == 0) {
+        doublet_coefficients = body_doublet_coefficients;
+        
+    } else {
+        MatrixXd body_wake_influence_coefficients = body_influence_coefficients_lu.solve(wake_influence_coefficients);
+        
+        // Set up capacitance matrix I + V^T B^-1 W, and V^T B^-1 b:
+        MatrixXd capacitance = MatrixXd::Identity(upper_panels.size(), upper_panels.size());
+        VectorXd c(upper_panels.size());
+        
+        for (int j = 0; j < (int) upper_panels.size(); j++) {
+            capacitance.row(j) += body_wake_influence_coefficients.row(upper_panels[j]) - body_wake_influence_coefficients.row(lower_panels[j]);
+            
+            c(j) = body_doublet_coefficients(upper_panels[j]) - body_doublet_coefficients(lower_panels[j]);
+        }
+        
+        VectorXd y = capacitance.partialPivLu().solve(c);
+        
+        doublet_coefficients = body_doublet_coefficients - body_wake_influence_coefficients * y;
+    }
+    
+    if (!doublet_coefficients.allFinite()) {
+        cerr << "Solver: Computing doublet distribution failed (singular matrix of influence coefficients)." << endl;
+        
+        body_influence_coefficients_nodes.resize(3, 0);
+        
+        return false;
+    }
+    
+    cout << "Solver: Done computing doublet distribution." << endl;
+    
+    return true;
+}
+
+/**
+   Computes the adjoint doublet distribution using the cached factorization of the matrix B of body influence coefficients.
+   
+   The matrix of influence coefficients is B + W V^T, as in compute_doublet_coefficients_low_rank().  The adjoint system is 
+   solved with the transpose of the cached factorization, using the Sherman-Morrison-Woodbury formula for the transpose,
+   
+   (B^T + V W^T)^-1 g = B^-T g - B^-T V (I + W^T B^-T V)^-1 W^T B^-T g.
+   
+   @param[in]   objective_gradient            Derivative g of the objective function with respect to the doublet distribution.
+   @param[in]   wake_influence_coefficients   Doublet influence coefficients W of the new wake panels.
+   @param[in]   upper_panels                  Indices of the upper trailing edge panels.
+   @param[in]   lower_panels                  Indices of the lower trailing edge panels.
+   @param[out]  adjoint                       Adjoint doublet distribution.
+   
+   @returns true on success.
+*/
+bool
+Solver::compute_adjoint_low_rank(const Eigen::VectorXd &objective_gradient, const Eigen::MatrixXd &wake_influence_coefficients, 
+                                 const std::vector<int> &upper_panels, const std::vector<int> &lower_panels, Eigen::VectorXd &adjoint) const
+{
+    cout << "Solver: Computing adjoint doublet distribution using the cached factorization." << endl;
+    
+    VectorXd body_adjoint = body_influence_coefficients_lu.transpose().solve(objective_gradient);
+    
+    if (upper_panels.size() == 0) {
+        adjoint = body_adjoint;
+        
+    } else {
+        // V maps the doublet distribution onto the differences across the trailing edges:
+        MatrixXd V = MatrixXd::Zero(n_non_wake_panels, upper_panels.size());
+        for (int j = 0; j < (int) upper_panels.size(); j++) {
+            V(upper_panels[j], j) += 1.0;
+            V(lower_panels[j], j) -= 1.0;
+        }
+        
+        MatrixXd body_kutta_adjoint = body_influence_coefficients_lu.transpose().solve(V);
+        
+        // Set up capacitance matrix I + W^T B^-T V, and W^T B^-T g:
+        MatrixXd capacitance = MatrixXd::Identity(upper_panels.size(), upper_panels.size()) + wake_influence_coefficients.transpose() * body_kutta_adjoint;
+        VectorXd c = wake_influence_coefficients.transpose() * body_adjoint;
+        
+        VectorXd y = capacitance.partialPivLu().solve(c);
+        
+        adjoint = body_adjoint - body_kutta_adjoint * y;
+    }
+    
+    if (!adjoint.allFinite()) {
+        cerr << "Solver: Computing adjoint doublet distribution failed (singular matrix of influence coefficients)." << endl;
+        
+        return false;
+    }
+    
+    cout << "Solver: Done computing adjoint doublet distribution." << endl;
+    
+    return true;
+}
+
+/**
+   Returns the nodes of all non-wake surfaces.
+   
+   @returns 3 x n matrix of node coordinates.
+*/
+Eigen::MatrixXd
+Solver::compute_non_wake_nodes() const
+{
+    int n_nodes = 0;
+    for (int i = 0; i < (int) non_wake_surfaces.size(); i++)
+        n_nodes += non_wake_surfaces[i]->surface->n_nodes();
+        
+    MatrixXd nodes(3, n_nodes);
+    
+    int offset = 0;
+    for (int i = 0; i < (int) non_wake_surfaces.size(); i++) {
+        const shared_ptr<Surface> &surface = non_wake_surfaces[i]->surface;
+        
+        for (int j = 0; j < surface->n_nodes(); j++)
+            nodes.col(offset + j) = surface->nodes[j];
+            
+        offset += surface->n_nodes();
+    }
+    
+    return nodes;
+}
+
+/**
+   Checks whether the cached factorization of the matrix of body influence coefficients is still valid.  This is the case if 
+   the non-wake surfaces have moved as a single rigid body since the factorization was computed.  If symmetry planes are in use, 
+   the surfaces must not have moved at all.
+   
+   @returns true if the cached factorization may be reused.
+*/
+bool
+Solver::body_influence_coefficients_valid() const
+{
+    MatrixXd nodes = compute_non_wake_nodes();
+    
+    if (nodes.cols() == 0 || nodes.cols() != body_influence_coefficients_nodes.cols())
+        return false;
+        
+    // Find the best fitting rigid transformation:
+    Matrix4d transformation = Matrix4d::Identity();
+    if (symmetry_plane_images.empty())
+        transformation = umeyama(body_influence_coefficients_nodes, nodes, false);
+        
+    MatrixXd residual = (transformation.topLeftCorner<3, 3>() * body_influence_coefficients_nodes).colwise() + transformation.topRightCorner<3, 1>() - nodes;
+    
+    double length_scale = (body_influence_coefficients_nodes.rowwise().maxCoeff() - body_influence_coefficients_nodes.rowwise().minCoeff()).norm();
+    
+    return residual.colwise().norm().maxCoeff() <= RIGID_MOTION_TOLERANCE * max(length_scale, 1.0);
+}
+
+/**
+   Computes the doublet distribution exploiting cyclic symmetry.
+   
+   The matrix of influence coefficients is block-circulant, with blocks C_m coupling the collocation points of the first sector
+   to the panels of sector m.  After a discrete Fourier transform across the sectors, the system decouples into one system
+   per sector mode k, with matrix sum_m C_m exp(2 pi i m k / n).  Since the doublet distribution is real, the modes k and
+   n - k are complex conjugates, and only the modes k <= n / 2 need to be solved for.
+   
+   @param[in]   A                               First block row of the doublet influence coefficients.
+   @param[in]   source_influence_coefficients   First block row of the source influence coefficients.
+   @param[in]   initial_guess                   Initial guess for the doublet distribution.
+   
+   @returns true on success.
+*/
+bool
+Solver::compute_doublet_coefficients_cyclic(const Eigen::MatrixXd &A, const Eigen::MatrixXd &source_influence_coefficients, const Eigen::VectorXd &initial_guess)
+{
+    int n_sector_panels = n_non_wake_panels / n_cyclic_sectors;
+    
+    // Compute new doublet distribution:
+    cout << "Solver: Computing doublet distribution using cyclic symmetry." << endl;
+    
+    // Right-hand side:  b_k = sum_m C_m sigma_{k + m}.
+    VectorXd b = VectorXd::Zero(n_non_wake_panels);
+    for (int k = 0; k < n_cyclic_sectors; k++) {
+        for (int m = 0; m < n_cyclic_sectors; m++) {
+            int l = (k + m) % n_cyclic_sectors;
+            
+            b.segment(k * n_sector_panels, n_sector_panels) += 
+                source_influence_coefficients.block(0, m * n_sector_panels, n_sector_panels, n_sector_panels) * source_coefficients.segment(l * n_sector_panels, n_sector_panels);
+        }
+    }
+    
+    // Solve for every sector mode:
+    vector<VectorXcd, Eigen::aligned_allocator<VectorXcd> > mode_doublet_coefficients(n_cyclic_sectors);
+    
+    for (int k = 0; k <= n_cyclic_sectors / 2; k++) {
+        MatrixXcd A_k = MatrixXcd::Zero(n_sector_panels, n_sector_panels);
+        VectorXcd b_k = VectorXcd::Zero(n_sector_panels);
+        VectorXcd initial_guess_k = VectorXcd::Zero(n_sector_panels);
+        
+        for (int m = 0; m < n_cyclic_sectors; m++) {
+            complex<double> w = polar(1.0, 2 * pi * m * k / n_cyclic_sectors);
+            
+            A_k += w * A.block(0, m * n_sector_panels, n_sector_panels, n_sector_panels).cast<complex<double> >();
+            
+            b_k             += conj(w) * b.segment(m * n_sector_panels, n_sector_panels).cast<complex<double> >();
+            initial_guess_k += conj(w) * initial_guess.segment(m * n_sector_panels, n_sector_panels).cast<complex<double> >();
+        }
+        
+        BiCGSTAB<MatrixXcd, DiagonalPreconditioner<complex<double> > > solver(A_k);
+        solver.setMaxIterations(Parameters::linear_solver_max_iterations);
+        solver.setTolerance(Parameters::linear_solver_tolerance);
+    
+        mode_doublet_coefficients[k] = solver.solveWithGuess(b_k, initial_guess_k);
+        
+        if (solver.info() != Success) {
+            cerr << "Solver: Computing doublet distribution for sector mode " << k << " failed (" << solver.iterations();
+            cerr << " iterations with estimated error=" << solver.error() << ")." << endl;
+           
+            return false;
+        }
+        
+        cout << "Solver: Done computing doublet distribution for sector mode " << k << " in " << solver.iterations() << " iterations with estimated error " << solver.error() << "." << endl;
+        
+        if (k > 0 && k < n_cyclic_sectors - k)
+            mode_doublet_coefficients[n_cyclic_sectors - k] = mode_doublet_coefficients[k].conjugate();
+    }
+    
+    // Transform back:
+    for (int m = 0; m < n_cyclic_sectors; m++) {
+        VectorXcd sector_doublet_coefficients = VectorXcd::Zero(n_sector_panels);
+        for (int k = 0; k < n_cyclic_sectors; k++)
+            sector_doublet_coefficients += polar(1.0, 2 * pi * m * k / n_cyclic_sectors) * mode_doublet_coefficients[k];
+            
+        doublet_coefficients.segment(m * n_sector_panels, n_sector_panels) = sector_doublet_coefficients.real() / n_cyclic_sectors;
+    }
+    
+    return true;
+}
+
+/**
+   Computes the contribution of a single panel to the objective function f . F + m . M, for the current doublet distribution.
+   The time derivative of the velocity potential, and boundary layer friction, are not taken into account.
+   
+   @param[in]   body             Body on which the force and moment act.
+   @param[in]   surface          Surface to which the panel belongs.
+   @param[in]   panel            Panel.
+   @param[in]   force_weights    Weight vector f for the force.
+   @param[in]   moment_weights   Weight vector m for the moment.
+   @param[in]   x                Reference point for the moment.
+   
+   @returns Contribution to the objective function.
+*/
+double
+Solver::compute_panel_objective(const std::shared_ptr<Body> &body, const std::shared_ptr<Surface> &surface, int panel,
+                                const Eigen::Vector3d &force_weights, const Eigen::Vector3d &moment_weights, const Eigen::Vector3d &x) const
+{
+    Vector3d V = compute_surface_velocity(body, surface, panel);
+    
+    double v_ref_squared = compute_reference_velocity_squared(body);
+    
+    // Dynamic pressure:
+    double q = 0.5 * fluid_density * v_ref_squared;
+    
+    // Panel force and moment:
+    Vector3d F = q * surface->panel_surface_area(panel) * compute_pressure_coefficient(V, 0.0, v_ref_squared) * surface->panel_normal(panel);
+    
+    Vector3d r = surface->panel_collocation_point(panel, false) - x;
+    
+    return force_weights.dot(F) + moment_weights.dot(r.cross(F));
+}
+
+/**
+   Computes the objective function f . F + m . M for the given body, for the current doublet distribution.  The time 
+   derivative of the velocity potential, and boundary layer friction, are not taken into account.
+   
+   @param[in]   body             Body on which the force and moment act.
+   @param[in]   force_weights    Weight vector f for the force.
+   @param[in]   moment_weights   Weight vector m for the moment.
+   @param[in]   x                Reference point for the moment.
+   
+   @returns Objective function.
+*/
+double
+Solver::compute_objective(const std::shared_ptr<Body> &body, const Eigen::Vector3d &force_weights, const Eigen::Vector3d &moment_weights, const Eigen::Vector3d &x) const
+{
+    double objective = 0.0;
+    
+    vector<shared_ptr<Body::SurfaceData> >::const_iterator si;
+    for (si = non_wake_surfaces.begin(); si != non_wake_surfaces.end(); si++) {
+        const shared_ptr<Body::SurfaceData> &d = *si;
+        
+        if (surface_to_body.find(d->surface)->second->body == body) {
+            for (int i = 0; i < d->surface->n_panels(); i++)
+                objective += compute_panel_objective(body, d->surface, i, force_weights, moment_weights, x);
+        }
+    }
+    
+    return objective;
+}
+
+/**
+   Computes the derivative of the objective function f . F + m . M with respect to the doublet distribution.  The surface
+   velocity of a panel depends linearly on the doublet coefficients of the panel and its neighbors.  The coefficients of this 
+   dependence are obtained by evaluating the on-body gradient of unit doublet distributions.
+   
+   @param[in]   body             Body on which the force and moment act.
+   @param[in]   force_weights    Weight vector f for the force.
+   @param[in]   moment_weights   Weight vector m for the moment.
+   @param[in]   x                Reference point for the moment.
+   
+   @returns Derivative of the objective function.
+*/
+Eigen::VectorXd
+Solver::compute_objective_doublet_gradient(const std::shared_ptr<Body> &body, const Eigen::Vector3d &force_weights, const Eigen::Vector3d &moment_weights, const Eigen::Vector3d &x) const
+{
+    VectorXd gradient = VectorXd::Zero(n_non_wake_panels);
+    
+    VectorXd unit_doublet_coefficients = VectorXd::Zero(n_non_wake_panels);
+    
+    int offset = 0;
+    
+    vector<shared_ptr<Body::SurfaceData> >::const_iterator si;
+    for (si = non_wake_surfaces.begin(); si != non_wake_surfaces.end(); si++) {
+        const shared_ptr<Body::SurfaceData> &d = *si;
+        
+        if (surface_to_body.find(d->surface)->second->body == body) {
+            for (int i = 0; i < d->surface->n_panels(); i++) {
+                const Vector3d &normal = d->surface->panel_normal(i);
+                
+                Vector3d r = d->surface->panel_collocation_point(i, false) - x;
+                
+                // The pressure force on the panel is 0.5 * rho * area * (v_ref^2 - |V|^2) * normal:
+                double weight = fluid_density * d->surface->panel_surface_area(i) * (force_weights.dot(normal) + moment_weights.dot(r.cross(normal)));
+                
+                Vector3d V = surface_velocities.row(offset + i);
+                
+                vector<int> stencil;
+                stencil.push_back(offset + i);
+                
+                vector<Body::SurfacePanelEdge> neighbors = body->panel_neighbors(d->surface, i);
+                for (int j = 0; j < (int) neighbors.size(); j++)
+                    stencil.push_back(compute_index(neighbors[j].surface, neighbors[j].panel));
+                    
+                for (int j = 0; j < (int) stencil.size(); j++) {
+                    unit_doublet_coefficients(stencil[j]) = 1.0;
+                    
+                    gradient(stencil[j]) += weight * V.dot(compute_scalar_field_gradient(unit_doublet_coefficients, body, d->surface, i));
+                    
+                    unit_doublet_coefficients(stencil[j]) = 0.0;
+                }
+            }
+        }
+        
+        offset += d->surface->n_panels();
+    }
+    
+    return gradient;
+}
+
+/**
+   Computes the inner product of the adjoint doublet distribution with those terms of the panel equations that depend on the 
+   geometry of the given panels.  These are the rows that belong to the given panels, and the columns that belong to the given
+   panels.  Every block of rows is computed by a separate OpenMP task.
+   
+   @param[in]   adjoint        Adjoint doublet distribution.
+   @param[in]   sources        Source distribution, including the influence of the wakes.
+   @param[in]   panels         Indices of the panels.
+   @param[in]   upper_panels   Indices of the upper trailing edge panels.
+   @param[in]   lower_panels   Indices of the lower trailing edge panels.
+   
+   @returns Inner product.
+*/
+double
+Solver::compute_adjoint_residual(const Eigen::VectorXd &adjoint, const Eigen::VectorXd &sources, const std::vector<int> &panels,
+                                 const std::vector<int> &upper_panels, const std::vector<int> &lower_panels) const
+{
+    vector<bool> is_panel(n_non_wake_panels, false);
+    
+    vector<int> panel_surfaces(panels.size()), panel_panels(panels.size());
+    for (int j = 0; j < (int) panels.size(); j++) {
+        is_panel[panels[j]] = true;
+        
+        compute_surface_panel(panels[j], panel_surfaces[j], panel_panels[j]);
+    }
+    
+    // List the lifting surfaces, in the order of the trailing edge panels:
+    vector<shared_ptr<Body::LiftingSurfaceData> > lifting_surfaces;
+    
+    vector<shared_ptr<BodyData> >::const_iterator bdi;
+    for (bdi = bodies.begin(); bdi != bodies.end(); bdi++) {
+        vector<shared_ptr<Body::LiftingSurfaceData> >::const_iterator lsi;
+        for (lsi = (*bdi)->body->lifting_surfaces.begin(); lsi != (*bdi)->body->lifting_surfaces.end(); lsi++)
+            lifting_surfaces.push_back(*lsi);
+    }
+    
+    // One partial sum per block of rows:
+    int n_blocks = 0;
+    for (int s_row = 0; s_row < (int) non_wake_surfaces.size(); s_row++)
+        n_blocks += (non_wake_surfaces[s_row]->surface->n_panels() + PANEL_TASK_SIZE - 1) / PANEL_TASK_SIZE;
+    
+    vector<double> partial_sums(n_blocks);
+    
+    #pragma omp parallel
+    {
+        #pragma omp single
+        {
+            int row_offset = 0;
+            int block = 0;
+            for (int s_row = 0; s_row < (int) non_wake_surfaces.size(); s_row++) {
+                for (int row = 0; row < non_wake_surfaces[s_row]->surface->n_panels(); row += PANEL_TASK_SIZE) {
+                    int row_end = min(row + PANEL_TASK_SIZE, non_wake_surfaces[s_row]->surface->n_panels());
+                    
+                    #pragma omp task firstprivate(s_row, row_offset, row, row_end, block) shared(adjoint, sources, panels, is_panel, panel_surfaces, panel_panels, lifting_surfaces, upper_panels, lower_panels, partial_sums)
+                    {
+                        const shared_ptr<Surface> &row_surface = non_wake_surfaces[s_row]->surface;
+                        
+                        double partial_sum = 0.0;
+                        
+                        for (int i = row; i < row_end; i++) {
+                            double residual = 0.0;
+                            
+                            if (is_panel[row_offset + i]) {
+                                // Full row, including the Kutta condition:
+                                int col_offset = 0;
+                                for (int s_col = 0; s_col < (int) non_wake_surfaces.size(); s_col++) {
+                                    const shared_ptr<Surface> &col_surface = non_wake_surfaces[s_col]->surface;
+                                    
+                                    for (int j = 0; j < col_surface->n_panels(); j++)
+                                        residual += compute_panel_residual(row_surface, i, col_surface, j, doublet_coefficients(col_offset + j), sources(col_offset + j));
+                                    
+                                    col_offset += col_surface->n_panels();
+                                }
+                                
+                                Vector3d x = row_surface->panel_collocation_point(i, true);
+                                
+                                int te = 0;
+                                for (int k = 0; k < (int) lifting_surfaces.size(); k++) {
+                                    const shared_ptr<Wake> &wake = lifting_surfaces[k]->wake;
+                                    
+                                    int n_wake_panels = lifting_surfaces[k]->lifting_surface->n_spanwise_panels();
+                                    int wake_panel_offset = wake->n_panels() - n_wake_panels;
+                                    
+                                    for (int j = 0; j < n_wake_panels; j++) {
+                                        double w = wake->doublet_influence(x, wake_panel_offset + j);
+                                        
+                                        // Add the influence of the mirror images:
+                                        for (int l = 0; l < (int) symmetry_plane_images.size(); l++)
+                                            w += wake->doublet_influence(symmetry_plane_images[l] * x, wake_panel_offset + j);
+                                        
+                                        residual += w * (doublet_coefficients(upper_panels[te]) - doublet_coefficients(lower_panels[te]));
+                                        
+                                        te++;
+                                    }
+                                }
+                                
+                            } else {
+                                // Columns of the given panels only:
+                                for (int j = 0; j < (int) panels.size(); j++) {
+                                    const shared_ptr<Surface> &col_surface = non_wake_surfaces[panel_surfaces[j]]->surface;
+                                    
+                                    residual += compute_panel_residual(row_surface, i, col_surface, panel_panels[j], doublet_coefficients(panels[j]), sources(panels[j]));
+                                }
+                            }
+                            
+                            partial_sum += adjoint(row_offset + i) * residual;
+                        }
+                        
+                        partial_sums[block] = partial_sum;
+                    }
+                    
+                    block++;
+                }
+                
+                row_offset += non_wake_surfaces[s_row]->surface->n_panels();
+            }
+        }
+    }
+    
+    double sum = 0.0;
+    for (int i = 0; i < (int) partial_sums.size(); i++)
+        sum += partial_sums[i];
+        
+    return sum;
+}
+
+/**
+   Computes the contribution of a single panel to the residual of the panel equation of another panel.
+   
+   @param[in]   row_surface          Surface to which the collocation point belongs.
+   @param[in]   row_panel            Panel to which the collocation point belongs.
+   @param[in]   col_surface          Surface to which the influencing panel belongs.
+   @param[in]   col_panel            Influencing panel.
+   @param[in]   doublet_coefficient  Doublet coefficient of the influencing panel.
+   @param[in]   source_coefficient   Source coefficient of the influencing panel.
+   
+   @returns Contribution to the residual.
+*/
+double
+Solver::compute_panel_residual(const std::shared_ptr<Surface> &row_surface, int row_panel, const std::shared_ptr<Surface> &col_surface, int col_panel,
+                               double doublet_coefficient, double source_coefficient) const
+{
+    double source_influence, doublet_influence;
+    col_surface->source_and_doublet_influence(row_surface, row_panel, col_panel, source_influence, doublet_influence);
+    
+    // Add the influence of the mirror images:
+    for (int k = 0; k < (int) symmetry_plane_images.size(); k++) {
+        double image_source_influence, image_doublet_influence;
+        col_surface->source_and_doublet_influence(symmetry_plane_images[k] * row_surface->panel_collocation_point(row_panel, true), col_panel,
+                                                  image_source_influence, image_doublet_influence);
+        
+        source_influence  += image_source_influence;
+        doublet_influence += image_doublet_influence;
+    }
+    
+    return doublet_influence * doublet_coefficient - source_influence * source_coefficient;
+}
+
+/**
+   Sets the freestream velocity and the body velocities of the given load case.
+   
+   @param[in]   load_case   Load case.
+*/
+void
+Solver::set_load_case(const LoadCase &load_case)
+{
+    freestream_velocity = load_case.freestream_velocity;
+    
+    for (int i = 0; i < (int) load_case.body_velocities.size(); i++)
+        bodies[i]->body->set_velocity(load_case.body_velocities[i]);
+        
+    for (int i = 0; i < (int) load_case.body_rotational_velocities.size(); i++)
+        bodies[i]->body->set_rotational_velocity(load_case.body_rotational_velocities[i]);
+}
+
+/**
+   Computes the source distribution.  Every block of panels is computed by a separate OpenMP task.  The tasks are complete 
+   after the next taskwait or barrier.  Tasks that depend on the source coefficients of a block of panels may be spawned
+   later by the same task, with an input dependence on the first coefficient of the block.
+   
+   @param[in]   include_wake_influence   Include the influence of the wake panels.
+*/
+void
+Solver::compute_source_coefficients(bool include_wake_influence)
+{
+    int offset = 0;
+    
+    for (int k = 0; k < (int) non_wake_surfaces.size(); k++) {
+        for (int begin = 0; begin < non_wake_surfaces[k]->surface->n_panels(); begin += PANEL_TASK_SIZE) {
+            int end = min(begin + PANEL_TASK_SIZE, non_wake_surfaces[k]->surface->n_panels());
+            
+            #pragma omp task firstprivate(k, offset, begin, end, include_wake_influence) depend(out: source_coefficients.data()[offset + begin])
+            {
+                const shared_ptr<Surface> &surface = non_wake_surfaces[k]->surface;
+                const shared_ptr<BodyData> &bd = surface_to_body.find(surface)->second;
+                
+                for (int i = begin; i < end; i++)
+                    source_coefficients(offset + i) = compute_source_coefficient(bd->body, surface, i, bd->boundary_layer, include_wake_influence);
             }
         }
+        
+        offset += non_wake_surfaces[k]->surface->n_panels();
     }
 }
 
 /**
-   Logs source and doublet distributions, as well as the pressure coefficients, into files in the logging folder
-   tagged with the specified step number.
-   
-   @param[in]   step_number   Step number used to name the output files.
-   @param[in]   writer        SurfaceWriter object to use.
+   Sets the doublet coefficients of the newest row of wake panels, following the Kutta condition.
 */
 void
-Solver::log(int step_number, SurfaceWriter &writer) const
-{   
-    // Log coefficients: 
+Solver::compute_wake_doublet_coefficients()
+{
     int offset = 0;
-    int save_node_offset = 0;
-    int save_panel_offset = 0;
-    int idx;
     
-    vector<shared_ptr<BodyData> >::const_iterator bdi;
+    vector<shared_ptr<BodyData> >::iterator bdi;
     for (bdi = bodies.begin(); bdi != bodies.end(); bdi++) {
-        const shared_ptr<BodyData> &bd = *bdi;
-        
-        // Iterate non-lifting surfaces:
-        idx = 0;
-        
-        vector<shared_ptr<Body::SurfaceData> >::const_iterator si;
-        for (si = bd->body->non_lifting_surfaces.begin(); si != bd->body->non_lifting_surfaces.end(); si++) {
-            const shared_ptr<Body::SurfaceData> &d = *si;
-            
-            // Log non-lifting surface coefficients:
-            MatrixXd non_lifting_surface_doublet_coefficients(d->surface->n_panels(), 1);
-            MatrixXd non_lifting_surface_source_coefficients(d->surface->n_panels(), 1);
-            MatrixXd non_lifting_surface_pressure_coefficients(d->surface->n_panels(), 1);
-            MatrixXd non_lifting_surface_velocity_vectors(d->surface->n_panels(), 3);
-            for (int i = 0; i < d->surface->n_panels(); i++) {
-                non_lifting_surface_doublet_coefficients(i, 0)  = doublet_coefficients(offset + i);
-                non_lifting_surface_source_coefficients(i, 0)   = source_coefficients(offset + i);
-                non_lifting_surface_pressure_coefficients(i, 0) = pressure_coefficients(offset + i);
-                non_lifting_surface_velocity_vectors.row(i)     = surface_velocities.row(offset + i);
-            }
-            
-            offset += d->surface->n_panels();
-            
-            vector<string> view_names;
-            vector<MatrixXd, Eigen::aligned_allocator<MatrixXd> > view_data;
-            
-            view_names.push_back(VIEW_NAME_DOUBLET_DISTRIBUTION);
-            view_data.push_back(non_lifting_surface_doublet_coefficients);
-            
-            view_names.push_back(VIEW_NAME_SOURCE_DISTRIBUTION);
-            view_data.push_back(non_lifting_surface_source_coefficients);
-            
-            view_names.push_back(VIEW_NAME_PRESSURE_DISTRIBUTION);
-            view_data.push_back(non_lifting_surface_pressure_coefficients);
-            
-            view_names.push_back(VIEW_NAME_VELOCITY_DISTRIBUTION);
-            view_data.push_back(non_lifting_surface_velocity_vectors);
-            
-            stringstream ss;
-            ss << log_folder << "/" << bd->body->id << "/" << d->surface->id << "/step_" << step_number << writer.file_extension();
-
-            writer.write(d->surface, ss.str(), save_node_offset, save_panel_offset, view_names, view_data);
-            
-            save_node_offset += d->surface->n_nodes();
-            save_panel_offset += d->surface->n_panels();
-            
-            idx++;
-        }   
+        shared_ptr<BodyData> bd = *bdi;
         
-        // Iterate lifting surfaces:
-        idx = 0;
+        vector<shared_ptr<Body::SurfaceData> >::iterator si;
+        for (si = bd->body->non_lifting_surfaces.begin(); si != bd->body->non_lifting_surfaces.end(); si++)
+            offset += (*si)->surface->n_panels();
         
-        vector<shared_ptr<Body::LiftingSurfaceData> >::const_iterator lsi;
+        vector<shared_ptr<Body::LiftingSurfaceData> >::iterator lsi;
         for (lsi = bd->body->lifting_surfaces.begin(); lsi != bd->body->lifting_surfaces.end(); lsi++) {
-            const shared_ptr<Body::LiftingSurfaceData> &d = *lsi;
-            
-            // Log lifting surface coefficients:
-            MatrixXd lifting_surface_doublet_coefficients(d->lifting_surface->n_panels(), 1);
-            MatrixXd lifting_surface_source_coefficients(d->lifting_surface->n_panels(), 1);
-            MatrixXd lifting_surface_pressure_coefficients(d->lifting_surface->n_panels(), 1);
-            MatrixXd lifting_surface_velocity_vectors(d->surface->n_panels(), 3);
-            for (int i = 0; i < d->lifting_surface->n_panels(); i++) {
-                lifting_surface_doublet_coefficients(i, 0)  = doublet_coefficients(offset + i);
-                lifting_surface_source_coefficients(i, 0)   = source_coefficients(offset + i);
-                lifting_surface_pressure_coefficients(i, 0) = pressure_coefficients(offset + i);
-                lifting_surface_velocity_vectors.row(i)     = surface_velocities.row(offset + i);
+            shared_ptr<Body::LiftingSurfaceData> d = *lsi;
+                     
+            // Set panel doublet coefficient:
+            for (int i = 0; i < d->lifting_surface->n_spanwise_panels(); i++) {
+                double doublet_coefficient_top    = doublet_coefficients(offset + d->lifting_surface->trailing_edge_upper_panel(i));
+                double doublet_coefficient_bottom = doublet_coefficients(offset + d->lifting_surface->trailing_edge_lower_panel(i));
+                
+                // Use the trailing-edge Kutta condition to compute the doublet coefficients of the new wake panels.
+                double doublet_coefficient = doublet_coefficient_top - doublet_coefficient_bottom;
+                
+                int idx = d->wake->n_panels() - d->lifting_surface->n_spanwise_panels() + i;
+                d->wake->doublet_coefficients[idx] = doublet_coefficient;
             }
             
+            // Update offset:
             offset += d->lifting_surface->n_panels();
-            
-            vector<string> view_names;
-            vector<MatrixXd, Eigen::aligned_allocator<MatrixXd> > view_data;
-            
-            view_names.push_back(VIEW_NAME_DOUBLET_DISTRIBUTION);
-            view_data.push_back(lifting_surface_doublet_coefficients);
-            
-            view_names.push_back(VIEW_NAME_SOURCE_DISTRIBUTION);
-            view_data.push_back(lifting_surface_source_coefficients);
-            
-            view_names.push_back(VIEW_NAME_PRESSURE_DISTRIBUTION);
-            view_data.push_back(lifting_surface_pressure_coefficients);
-            
-            view_names.push_back(VIEW_NAME_VELOCITY_DISTRIBUTION);
-            view_data.push_back(lifting_surface_velocity_vectors);
-            
-            stringstream ss;
-            ss << log_folder << "/" << bd->body->id << "/" << d->lifting_surface->id << "/step_" << step_number << writer.file_extension();
+        }
+    }
+}
 
-            writer.write(d->lifting_surface, ss.str(), save_node_offset, save_panel_offset, view_names, view_data);
-            
-            save_node_offset += d->lifting_surface->n_nodes();
-            save_panel_offset += d->lifting_surface->n_panels();
+/**
+   Computes the surface velocity distribution.  Every block of panels is computed by a separate OpenMP task.  The tasks are 
+   complete after the next taskwait or barrier.
+*/
+void
+Solver::compute_surface_velocities()
+{
+    int offset = 0;
     
-            // Log wake surface and coefficients:
-            MatrixXd wake_doublet_coefficients(d->wake->doublet_coefficients.size(), 1);
-            for (int i = 0; i < (int) d->wake->doublet_coefficients.size(); i++)
-                wake_doublet_coefficients(i, 0) = d->wake->doublet_coefficients[i];
-
-            view_names.clear();
-            view_data.clear();
-            
-            view_names.push_back(VIEW_NAME_DOUBLET_DISTRIBUTION);
-            view_data.push_back(wake_doublet_coefficients);
+    for (int k = 0; k < (int) non_wake_surfaces.size(); k++) {
+        for (int begin = 0; begin < non_wake_surfaces[k]->surface->n_panels(); begin += PANEL_TASK_SIZE) {
+            int end = min(begin + PANEL_TASK_SIZE, non_wake_surfaces[k]->surface->n_panels());
             
-            stringstream ssw;
-            ssw << log_folder << "/" << bd->body->id << "/" << d->wake->id << "/step_" << step_number << writer.file_extension();
-            
-            writer.write(d->wake, ssw.str(), 0, save_panel_offset, view_names, view_data);
-            
-            save_node_offset += d->wake->n_nodes();
-            save_panel_offset += d->wake->n_panels();
+            #pragma omp task firstprivate(k, offset, begin, end)
+            {
+                const shared_ptr<Surface> &surface = non_wake_surfaces[k]->surface;
+                const shared_ptr<BodyData> &bd = surface_to_body.find(surface)->second;
+                
+                for (int i = begin; i < end; i++)
+                    surface_velocities.row(offset + i) = compute_surface_velocity(bd->body, surface, i);
+            }
+        }
+        
+        offset += non_wake_surfaces[k]->surface->n_panels();
+    }
+}
+
+/**
+   Computes the surface velocity potentials and the pressure distribution.  Every block of panels is computed by a separate
+   OpenMP task.  The tasks are complete after the next taskwait or barrier.
+   
+   @param[in]   dt   Time step size.
+*/
+void
+Solver::compute_pressure_coefficients(double dt)
+{
+    int offset = 0;
+    
+    for (int k = 0; k < (int) non_wake_surfaces.size(); k++) {
+        for (int begin = 0; begin < non_wake_surfaces[k]->surface->n_panels(); begin += PANEL_TASK_SIZE) {
+            int end = min(begin + PANEL_TASK_SIZE, non_wake_surfaces[k]->surface->n_panels());
             
-            idx++;
+            #pragma omp task firstprivate(k, offset, begin, end, dt)
+            {
+                const shared_ptr<Surface> &surface = non_wake_surfaces[k]->surface;
+                const shared_ptr<BodyData> &bd = surface_to_body.find(surface)->second;
+                
+                double v_ref_squared = compute_reference_velocity_squared(bd->body);
+                
+                for (int i = begin; i < end; i++) {
+                    // Velocity potential:
+                    surface_velocity_potentials(offset + i) = compute_surface_velocity_potential(surface, offset, i);
+                    
+                    // Pressure coefficient:
+                    double dphidt = compute_surface_velocity_potential_time_derivative(offset, i, dt);
+                    pressure_coefficients(offset + i) = compute_pressure_coefficient(surface_velocities.row(offset + i), dphidt, v_ref_squared);
+                }
+            }
         }
+        
+        offset += non_wake_surfaces[k]->surface->n_panels();
     }
 }
- 
+
 // Compute source coefficient for given surface and panel:
 double
 Solver::compute_source_coefficient(const std::shared_ptr<Body> &body, const std::shared_ptr<Surface> &surface, int panel, const std::shared_ptr<BoundaryLayer> &boundary_layer, bool include_wake_influence) const
@@ -1249,10 +3442,12 @@ Solver::compute_source_coefficient(const std::shared_ptr<Body> &body, const std:
                 
                 // Add influence of old wake panels.  That is, those wake panels which already have a doublet
                 // strength assigned to them.
-                for (int k = 0; k < d->wake->n_panels() - d->lifting_surface->n_spanwise_panels(); k++) {
+                int n_old_wake_panels = d->wake->n_panels() - d->lifting_surface->n_spanwise_panels();
+                if (n_old_wake_panels > 0) {
+                    Map<const VectorXd> wake_doublet_coefficients(d->wake->doublet_coefficients.data(), n_old_wake_panels);
+                    
                     // Use doublet panel - vortex ring equivalence.
-                    velocity -= d->wake->vortex_ring_unit_velocity(surface->panel_collocation_point(panel, true), k)
-                        * d->wake->doublet_coefficients[k];
+                    velocity -= compute_induced_velocity(d->wake, VectorXd(), wake_doublet_coefficients, surface->panel_collocation_point(panel, true));
                 }
             }
         }
@@ -1327,13 +3522,35 @@ Solver::compute_scalar_field_gradient(const Eigen::VectorXd &scalar_field, const
     
     // Retrieve panel neighbors.
     vector<Body::SurfacePanelEdge> neighbors = body->panel_neighbors(surface, panel);
+    
+    // Panels bordering on a plane of symmetry neighbor their own mirror images:
+    vector<Vector3d, Eigen::aligned_allocator<Vector3d> > mirrored_neighbors;
+    for (int i = 0; i < (int) surface->panel_nodes[panel].size(); i++) {
+        int next_idx;
+        if (i == (int) surface->panel_nodes[panel].size() - 1)
+            next_idx = 0;
+        else
+            next_idx = i + 1;
+            
+        const Vector3d &node_a = surface->nodes[surface->panel_nodes[panel][i]];
+        const Vector3d &node_b = surface->nodes[surface->panel_nodes[panel][next_idx]];
+        
+        double tolerance = SYMMETRY_PLANE_TOLERANCE * (node_b - node_a).norm();
+        
+        for (int k = 0; k < (int) symmetry_plane_images.size(); k++) {
+            const Transform<double, 3, Affine> &image = symmetry_plane_images[k];
+            
+            if ((image * node_a - node_a).norm() < tolerance && (image * node_b - node_b).norm() < tolerance)
+                mirrored_neighbors.push_back(image * surface->panel_collocation_point(panel, false));
+        }
+    }
 
     // Set up a transformation such that panel normal becomes unit Z vector:
     Transform<double, 3, Affine> transformation = surface->panel_coordinate_transformation(panel);
     
     // Set up model equations:
-    MatrixXd A(neighbors.size(), 2);
-    VectorXd b(neighbors.size());
+    MatrixXd A(neighbors.size() + mirrored_neighbors.size(), 2);
+    VectorXd b(neighbors.size() + mirrored_neighbors.size());
     
     // The model is centered on panel:
     double panel_value = scalar_field(compute_index(surface, panel));
@@ -1350,6 +3567,16 @@ Solver::compute_scalar_field_gradient(const Eigen::VectorXd &scalar_field, const
         b(i) = scalar_field(compute_index(neighbor_panel.surface, neighbor_panel.panel)) - panel_value;
     }
     
+    for (int i = 0; i < (int) mirrored_neighbors.size(); i++) {
+        // The scalar field is symmetric, so that the mirrored value equals the panel value:
+        Vector3d neighbor_vector_normalized = transformation * mirrored_neighbors[i];
+        
+        A(neighbors.size() + i, 0) = neighbor_vector_normalized(0);
+        A(neighbors.size() + i, 1) = neighbor_vector_normalized(1);
+        
+        b(neighbors.size() + i) = 0.0;
+    }
+    
     // Solve model equations:
     JacobiSVD<MatrixXd> svd(A, ComputeThinU | ComputeThinV);
     svd.setThreshold(Parameters::zero_threshold);
@@ -1440,14 +3667,8 @@ Solver::compute_velocity_potential(const Vector3d &x) const
     for (si = non_wake_surfaces.begin(); si != non_wake_surfaces.end(); si++) {
         const shared_ptr<Body::SurfaceData> &d = *si;
 
-        for (int i = 0; i < d->surface->n_panels(); i++) {
-            double source_influence, doublet_influence;
-            
-            d->surface->source_and_doublet_influence(x, i, source_influence, doublet_influence);
-            
-            phi += doublet_influence * doublet_coefficients(offset + i);
-            phi += source_influence * source_coefficients(offset + i);
-        }
+        phi += compute_induced_velocity_potential(d->surface, source_coefficients.segment(offset, d->surface->n_panels()),
+                                                  doublet_coefficients.segment(offset, d->surface->n_panels()), x);
         
         offset += d->surface->n_panels();
     }
@@ -1461,8 +3682,9 @@ Solver::compute_velocity_potential(const Vector3d &x) const
         for (lsi = bd->body->lifting_surfaces.begin(); lsi != bd->body->lifting_surfaces.end(); lsi++) {
             const shared_ptr<Body::LiftingSurfaceData> &d = *lsi;
 
-            for (int i = 0; i < d->wake->n_panels(); i++)
-                phi += d->wake->doublet_influence(x, i) * d->wake->doublet_coefficients[i];
+            Map<const VectorXd> wake_doublet_coefficients(d->wake->doublet_coefficients.data(), d->wake->n_panels());
+            
+            phi += compute_induced_velocity_potential(d->wake, VectorXd(), wake_doublet_coefficients, x);
         }
     }
                     
@@ -1482,6 +3704,28 @@ Solver::compute_velocity_potential(const Vector3d &x) const
 */ 
 Eigen::Vector3d
 Solver::compute_velocity_interpolated(const Eigen::Vector3d &x, std::set<int> &ignore_set) const
+{
+    Vector3d velocity;
+    if (compute_close_velocity(x, ignore_set, velocity))
+        return velocity;
+        
+    // No close panels.  Compute potential velocity:
+    return compute_velocity(x);
+}
+
+/**
+   Computes the interpolated velocity at the given point, if it lies close to the body.
+   
+   The interpolation code assumes the outer angles between panels to be over 90 degrees.
+   
+   @param[in]   x                       Reference point.
+   @param[in]   ignore_set              Set of panel IDs not to interpolate for.
+   @param[out]  interpolated_velocity   Interpolated velocity vector.
+   
+   @returns true if the point lies close to the body.
+*/ 
+bool
+Solver::compute_close_velocity(const Eigen::Vector3d &x, std::set<int> &ignore_set, Eigen::Vector3d &interpolated_velocity) const
 {
     // Lists of close velocities, ordered by primacy:
     vector<Vector3d, Eigen::aligned_allocator<Vector3d> > close_panel_velocities;
@@ -1551,8 +3795,8 @@ Solver::compute_velocity_interpolated(const Eigen::Vector3d &x, std::set<int> &i
                         else
                             next_l = l + 1;
                             
-                        Vector3d point_a = d->surface->panel_transformed_points[i][l];
-                        Vector3d point_b = d->surface->panel_transformed_points[i][next_l];
+                        Vector3d point_a = (*d->surface->panel_transformed_points)[i][l];
+                        Vector3d point_b = (*d->surface->panel_transformed_points)[i][next_l];
                             
                         Vector3d edge = point_b - point_a;
                         Vector3d normal(-edge(1), edge(0), 0.0);
@@ -1661,20 +3905,20 @@ Solver::compute_velocity_interpolated(const Eigen::Vector3d &x, std::set<int> &i
         // Yes, at primacy level i:
         if (velocity_lists[i]->size() > 0) {
             // Average:
-            Vector3d velocity = Vector3d(0, 0, 0);
+            interpolated_velocity = Vector3d(0, 0, 0);
             vector<Vector3d, Eigen::aligned_allocator<Vector3d> >::iterator it;
             for (it = velocity_lists[i]->begin(); it != velocity_lists[i]->end(); it++)
-                velocity += *it;
+                interpolated_velocity += *it;
                 
             // Normalize velocity.  The weights sum up to (n - 1) times the sum of the distances.
-            velocity /= velocity_lists[i]->size();
+            interpolated_velocity /= velocity_lists[i]->size();
             
-            return velocity;
+            return true;
         }
     }
 
-    // No close panels.  Compute potential velocity:
-    return compute_velocity(x);
+    // No close panels:
+    return false;
 }
 
 /**
@@ -1708,11 +3952,9 @@ Solver::compute_velocity(const Eigen::Vector3d &x) const
         for (si = surfaces.begin(); si != surfaces.end(); si++) {
             const shared_ptr<Body::SurfaceData> &d = *si;
 
-            for (int i = 0; i < d->surface->n_panels(); i++) {
-                // If no close panels were detected so far, add the influence of this panel:
-                velocity += d->surface->vortex_ring_unit_velocity(x, i) * doublet_coefficients(offset + i);
-                velocity += d->surface->source_unit_velocity(x, i) * source_coefficients(offset + i);
-            }
+            // Add the influence of the panels of this surface:
+            velocity += compute_induced_velocity(d->surface, source_coefficients.segment(offset, d->surface->n_panels()),
+                                                 doublet_coefficients.segment(offset, d->surface->n_panels()), x);
             
             offset += d->surface->n_panels();
         }
@@ -1722,8 +3964,9 @@ Solver::compute_velocity(const Eigen::Vector3d &x) const
             const shared_ptr<Body::LiftingSurfaceData> &d = *lsi;
             
             if (d->wake->n_panels() >= d->lifting_surface->n_spanwise_panels()) {
-                for (int i = 0; i < d->wake->n_panels(); i++)
-                    velocity += d->wake->vortex_ring_unit_velocity(x, i) * d->wake->doublet_coefficients[i];
+                Map<const VectorXd> wake_doublet_coefficients(d->wake->doublet_coefficients.data(), d->wake->n_panels());
+                
+                velocity += compute_induced_velocity(d->wake, VectorXd(), wake_doublet_coefficients, x);
             }
         }
     }
@@ -1732,6 +3975,163 @@ Solver::compute_velocity(const Eigen::Vector3d &x) const
     return velocity + freestream_velocity;
 }
 
+/**
+   Computes the potential velocity and the velocity potential at the given point, from a single evaluation of the panel
+   geometry.
+   
+   @param[in]   x                    Reference point.
+   @param[out]  velocity             Potential velocity vector.
+   @param[out]  velocity_potential   Velocity potential.
+*/ 
+void
+Solver::compute_velocity_and_velocity_potential(const Eigen::Vector3d &x, Eigen::Vector3d &velocity, double &velocity_potential) const
+{
+    velocity           = Vector3d(0, 0, 0);
+    velocity_potential = 0.0;
+    
+    int offset = 0;
+
+    // Iterate bodies:
+    vector<shared_ptr<BodyData> >::const_iterator bdi;
+    for (bdi = bodies.begin(); bdi != bodies.end(); bdi++) {
+        const shared_ptr<BodyData> &bd = *bdi;
+        
+        // Iterate surfaces:
+        vector<shared_ptr<Body::SurfaceData> > surfaces;
+        vector<shared_ptr<Body::LiftingSurfaceData> >::const_iterator lsi;
+        vector<shared_ptr<Body::SurfaceData> >::const_iterator si; 
+        for (si = bd->body->non_lifting_surfaces.begin(); si != bd->body->non_lifting_surfaces.end(); si++)
+            surfaces.push_back(*si);
+        for (lsi = bd->body->lifting_surfaces.begin(); lsi != bd->body->lifting_surfaces.end(); lsi++)
+            surfaces.push_back(*lsi);
+        
+        for (si = surfaces.begin(); si != surfaces.end(); si++) {
+            const shared_ptr<Body::SurfaceData> &d = *si;
+
+            // Add the influence of the panels of this surface:
+            compute_induced_velocity_and_velocity_potential(d->surface, source_coefficients.segment(offset, d->surface->n_panels()),
+                                                            doublet_coefficients.segment(offset, d->surface->n_panels()), x,
+                                                            velocity, velocity_potential);
+            
+            offset += d->surface->n_panels();
+        }
+        
+        // Add the influence of the wakes:
+        for (lsi = bd->body->lifting_surfaces.begin(); lsi != bd->body->lifting_surfaces.end(); lsi++) {
+            const shared_ptr<Body::LiftingSurfaceData> &d = *lsi;
+            
+            if (d->wake->n_panels() >= d->lifting_surface->n_spanwise_panels()) {
+                Map<const VectorXd> wake_doublet_coefficients(d->wake->doublet_coefficients.data(), d->wake->n_panels());
+                
+                compute_induced_velocity_and_velocity_potential(d->wake, VectorXd(), wake_doublet_coefficients, x,
+                                                                velocity, velocity_potential);
+            }
+        }
+    }
+    
+    // Done:
+    velocity           += freestream_velocity;
+    velocity_potential += freestream_velocity.dot(x);
+}
+
+/**
+   Computes the reference point together with its mirror images, one per column.
+   
+   @param[in]   x   Reference point.
+   
+   @returns Reference point and mirror images.
+*/
+Eigen::Matrix3Xd
+Solver::compute_image_points(const Eigen::Vector3d &x) const
+{
+    Matrix3Xd points(3, 1 + symmetry_plane_images.size());
+    
+    points.col(0) = x;
+    for (int k = 0; k < (int) symmetry_plane_images.size(); k++)
+        points.col(k + 1) = symmetry_plane_images[k] * x;
+        
+    return points;
+}
+
+/**
+   Computes the velocity induced by the panels of a surface, including the influence of its mirror images.  The reference 
+   point and its mirror images are evaluated as a single batch.
+   
+   @param[in]   surface                Surface.
+   @param[in]   source_coefficients    Strengths of the source panels of the surface.
+   @param[in]   doublet_coefficients   Strengths of the doublet panels of the surface.
+   @param[in]   x                      Reference point.
+   
+   @returns Induced velocity.
+*/
+Eigen::Vector3d
+Solver::compute_induced_velocity(const std::shared_ptr<Surface> &surface, const Eigen::Ref<const Eigen::VectorXd> &source_coefficients,
+                                 const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients, const Eigen::Vector3d &x) const
+{
+    Matrix3Xd points = compute_image_points(x);
+        
+    Matrix3Xd velocities(3, points.cols());
+    surface->induced_velocities(points, source_coefficients, doublet_coefficients, velocities);
+    
+    Vector3d velocity = velocities.col(0);
+    for (int k = 0; k < (int) symmetry_plane_images.size(); k++)
+        velocity += symmetry_plane_images[k].linear() * velocities.col(k + 1);
+        
+    return velocity;
+}
+
+/**
+   Computes the velocity potential induced by the panels of a surface, including the influence of its mirror images.  The 
+   reference point and its mirror images are evaluated as a single batch.
+   
+   @param[in]   surface                Surface.
+   @param[in]   source_coefficients    Strengths of the source panels of the surface.
+   @param[in]   doublet_coefficients   Strengths of the doublet panels of the surface.
+   @param[in]   x                      Reference point.
+   
+   @returns Induced velocity potential.
+*/
+double
+Solver::compute_induced_velocity_potential(const std::shared_ptr<Surface> &surface, const Eigen::Ref<const Eigen::VectorXd> &source_coefficients,
+                                           const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients, const Eigen::Vector3d &x) const
+{
+    Matrix3Xd points = compute_image_points(x);
+    
+    VectorXd potentials(points.cols());
+    surface->induced_velocity_potentials(points, source_coefficients, doublet_coefficients, potentials);
+    
+    return potentials.sum();
+}
+
+/**
+   Adds the velocity and the velocity potential induced by the panels of a surface, including the influence of its mirror 
+   images.  The reference point and its mirror images are evaluated as a single batch.
+   
+   @param[in]       surface                Surface.
+   @param[in]       source_coefficients    Strengths of the source panels of the surface.
+   @param[in]       doublet_coefficients   Strengths of the doublet panels of the surface.
+   @param[in]       x                      Reference point.
+   @param[in,out]   velocity               Velocity, to which the induced velocity is added.
+   @param[in,out]   velocity_potential     Velocity potential, to which the induced velocity potential is added.
+*/
+void
+Solver::compute_induced_velocity_and_velocity_potential(const std::shared_ptr<Surface> &surface, const Eigen::Ref<const Eigen::VectorXd> &source_coefficients,
+                                                        const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients, const Eigen::Vector3d &x,
+                                                        Eigen::Vector3d &velocity, double &velocity_potential) const
+{
+    Matrix3Xd points = compute_image_points(x);
+    
+    Matrix3Xd velocities(3, points.cols());
+    VectorXd potentials(points.cols());
+    surface->induced_velocities_and_potentials(points, source_coefficients, doublet_coefficients, velocities, potentials);
+    
+    velocity += velocities.col(0);
+    for (int k = 0; k < (int) symmetry_plane_images.size(); k++)
+        velocity += symmetry_plane_images[k].linear() * velocities.col(k + 1);
+        
+    velocity_potential += potentials.sum();
+}
+
 /**
    Computes the vector by which the first wake vortex is offset from the trailing edge.
    
@@ -1776,3 +4176,23 @@ Solver::compute_index(const std::shared_ptr<Surface> &surface, int panel) const
     
     return -1;
 }
+
+/**
+   Finds the surface and panel that correspond to the given index into the doublet and source distributions.
+   
+   @param[in]   index           Index of the panel.
+   @param[out]  surface_index   Index of the surface in the list of non-wake surfaces.
+   @param[out]  panel           Panel on the surface.
+*/
+void
+Solver::compute_surface_panel(int index, int &surface_index, int &panel) const
+{
+    for (surface_index = 0; surface_index < (int) non_wake_surfaces.size(); surface_index++) {
+        if (index < non_wake_surfaces[surface_index]->surface->n_panels())
+            break;
+        
+        index -= non_wake_surfaces[surface_index]->surface->n_panels();
+    }
+    
+    panel = index;
+}
@@ -15,11 +15,18 @@
 #include <fstream>
 
 #include <Eigen/Core>
+#include <Eigen/LU>
 #include <Eigen/StdVector>
 
 #include <vortexje/body.hpp>
 #include <vortexje/surface-writer.hpp>
 #include <vortexje/boundary-layer.hpp>
+#include <vortexje/recycled-gmres.hpp>
+#include <vortexje/anderson-acceleration.hpp>
+#include <vortexje/dense-operator.hpp>
+#include <vortexje/out-of-core-matrix.hpp>
+#include <vortexje/checkpoint.hpp>
+#include <vortexje/async-write-queue.hpp>
 
 namespace Vortexje
 {
@@ -88,6 +95,10 @@ public:
     
     void set_fluid_density(double value);
     
+    void set_cyclic_symmetry(int n_sectors, const Eigen::Vector3d &axis_point, const Eigen::Vector3d &axis_direction);
+    
+    void add_symmetry_plane(const Eigen::Vector3d &point, const Eigen::Vector3d &normal);
+    
     void initialize_wakes(double dt = 0.0);
     
     void update_wakes(double dt = 0.0);
@@ -96,10 +107,14 @@ public:
     
     void propagate();
     
+    int boundary_layer_iterations() const;
+    
     double velocity_potential(const Eigen::Vector3d &x) const;
     
     Eigen::Vector3d velocity(const Eigen::Vector3d &x) const;
     
+    void velocity_and_velocity_potential(const Eigen::Vector3d &x, Eigen::Vector3d &velocity, double &velocity_potential) const;
+    
     double surface_velocity_potential(const std::shared_ptr<Surface> &surface, int panel) const;
     
     Eigen::Vector3d surface_velocity(const std::shared_ptr<Surface> &surface, int panel) const;
@@ -112,6 +127,86 @@ public:
     Eigen::Vector3d moment(const std::shared_ptr<Body> &body, const Eigen::Vector3d &x) const;
     Eigen::Vector3d moment(const std::shared_ptr<Surface> &surface, const Eigen::Vector3d &x) const;
     
+    /**
+       Kinematic state of the flow and of the bodies, for batched steady solution.
+       
+       @brief Load case.
+    */
+    class LoadCase {
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+        
+        /**
+           Constructs a load case with the given freestream velocity, and the current body velocities.
+           
+           @param[in]   freestream_velocity   Freestream velocity.
+        */
+        LoadCase(const Eigen::Vector3d &freestream_velocity) : freestream_velocity(freestream_velocity) {};
+        
+        /**
+           Freestream velocity.
+        */
+        Eigen::Vector3d freestream_velocity;
+        
+        /**
+           Linear velocities of the bodies, in the order of Solver::bodies.  If empty, the current velocities are used.
+        */
+        std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > body_velocities;
+        
+        /**
+           Rotational velocities of the bodies, in the order of Solver::bodies.  If empty, the current rotational 
+           velocities are used.
+        */
+        std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > body_rotational_velocities;
+    };
+    
+    /**
+       Forces and moments on the bodies, for a single load case.
+       
+       @brief Load case result.
+    */
+    class LoadCaseResult {
+    public:
+        /**
+           Forces on the bodies, in the order of Solver::bodies.
+        */
+        std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > forces;
+        
+        /**
+           Moments on the bodies, in the order of Solver::bodies.
+        */
+        std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > moments;
+    };
+    
+    bool solve_load_cases(const std::vector<LoadCase, Eigen::aligned_allocator<LoadCase> > &load_cases, const Eigen::Vector3d &x,
+                          std::vector<LoadCaseResult> &results);
+    
+    /**
+       Derivatives of an objective function with respect to the node positions and the body velocities.
+       
+       @brief Sensitivities.
+    */
+    class Sensitivities {
+    public:
+        /**
+           Derivatives with respect to the node positions, as a 3 x n matrix for every non-wake surface.
+        */
+        std::map<std::shared_ptr<Surface>, Eigen::MatrixXd> nodes;
+        
+        /**
+           Derivatives with respect to the linear velocities of the bodies, in the order of Solver::bodies.
+        */
+        std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > body_velocities;
+        
+        /**
+           Derivatives with respect to the rotational velocities of the bodies, in the order of Solver::bodies.
+        */
+        std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > body_rotational_velocities;
+    };
+    
+    bool adjoint_sensitivities(const std::shared_ptr<Body> &body, const Eigen::Vector3d &force_weights, const Eigen::Vector3d &moment_weights,
+                               const Eigen::Vector3d &x, Sensitivities &sensitivities);
+    
     /**
        Data structure bundling a Surface, a panel ID, and a point on the panel.
        
@@ -150,6 +245,12 @@ public:
     std::vector<SurfacePanelPoint, Eigen::aligned_allocator<SurfacePanelPoint> > trace_streamline(const SurfacePanelPoint &start) const;
     
     void log(int step_number, SurfaceWriter &writer) const;
+    
+    bool save_checkpoint(const std::string &filename, bool asynchronous = false);
+    
+    bool load_checkpoint(const std::string &filename);
+    
+    bool flush_checkpoints();
 
 private:
     std::string log_folder;
@@ -166,8 +267,106 @@ private:
     Eigen::MatrixXd surface_velocities;
     Eigen::VectorXd pressure_coefficients;  
     
-    Eigen::VectorXd previous_surface_velocity_potentials; 
-                                          
+    Eigen::VectorXd previous_surface_velocity_potentials;
+    
+    std::vector<Eigen::VectorXd, Eigen::aligned_allocator<Eigen::VectorXd> > previous_doublet_coefficients;
+    
+    int n_cyclic_sectors;
+    Eigen::Vector3d cyclic_axis_point;
+    Eigen::Vector3d cyclic_axis_direction;
+    Eigen::Matrix3d cyclic_sector_rotation;
+    
+    std::vector<Eigen::Transform<double, 3, Eigen::Affine>, Eigen::aligned_allocator<Eigen::Transform<double, 3, Eigen::Affine> > > symmetry_plane_images;
+    
+    Eigen::PartialPivLU<Eigen::MatrixXd> body_influence_coefficients_lu;
+    Eigen::MatrixXd body_source_influence_coefficients;
+    Eigen::MatrixXd body_influence_coefficients_nodes;
+    
+    RecycledGMRES recycled_gmres;
+    
+    AndersonAcceleration boundary_layer_acceleration;
+    
+    int n_boundary_layer_iterations;
+    
+    std::shared_ptr<AsyncWriteQueue> checkpoint_queue;
+    
+    /**
+       Tile of the matrices of influence coefficients, within a single pair of surfaces.
+       
+       @brief Tile of influence coefficients.
+    */
+    class InfluenceTile {
+    public:
+        int row_surface, row_offset, row_begin, row_end;
+        int col_surface, col_offset, col_begin, col_end;
+    };
+    
+    bool cyclic_symmetric_geometry() const;
+    
+    bool cyclic_symmetric_flow() const;
+    
+    void compute_influence_coefficients(int n_row_surfaces, Eigen::MatrixXd &A, Eigen::MatrixXd &source_influence_coefficients) const;
+    
+    void compute_influence_coefficients(Eigen::MatrixXd &A, Eigen::VectorXd &b) const;
+    
+    void compute_influence_coefficients(OutOfCoreMatrix &A, Eigen::VectorXd &b) const;
+    
+    void compute_right_hand_side(Eigen::VectorXd &b) const;
+    
+    void add_kutta_influence_coefficients(int n_row_surfaces, Eigen::MatrixXd &A) const;
+    
+    std::vector<InfluenceTile> compute_influence_tiles(int row_begin, int row_end) const;
+    
+    void first_touch_resize(Eigen::MatrixXd &M, int rows) const;
+    
+    void compute_body_influence_coefficients(int n_row_surfaces, Eigen::MatrixXd &A, Eigen::MatrixXd &source_influence_coefficients) const;
+    
+    void compute_body_influence_coefficients_tile(const InfluenceTile &tile, Eigen::MatrixXd &A, Eigen::MatrixXd &source_influence_coefficients) const;
+    
+    void compute_body_influence_coefficients_tile(const InfluenceTile &tile, Eigen::Ref<Eigen::MatrixXd> A, Eigen::Ref<Eigen::VectorXd> tile_b) const;
+    
+    void sum_tile_right_hand_sides(const std::vector<InfluenceTile> &tiles, const Eigen::MatrixXd &tile_b, Eigen::Ref<Eigen::VectorXd> b) const;
+    
+    void compute_kutta_influence_coefficients(int n_row_surfaces, Eigen::MatrixXd &wake_influence_coefficients, std::vector<int> &upper_panels, std::vector<int> &lower_panels) const;
+    
+    Eigen::MatrixXd compute_non_wake_nodes() const;
+    
+    bool body_influence_coefficients_valid() const;
+    
+    Eigen::VectorXd compute_doublet_coefficients_initial_guess() const;
+    
+    bool compute_doublet_coefficients(const LinearOperator &A, const Eigen::VectorXd &b, const Eigen::VectorXd &initial_guess);
+    
+    bool compute_doublet_coefficients_low_rank(const Eigen::MatrixXd &A, const Eigen::MatrixXd &wake_influence_coefficients, const std::vector<int> &upper_panels, const std::vector<int> &lower_panels);
+    
+    bool compute_adjoint_low_rank(const Eigen::VectorXd &objective_gradient, const Eigen::MatrixXd &wake_influence_coefficients, 
+                                  const std::vector<int> &upper_panels, const std::vector<int> &lower_panels, Eigen::VectorXd &adjoint) const;
+    
+    bool compute_doublet_coefficients_cyclic(const Eigen::MatrixXd &A, const Eigen::MatrixXd &source_influence_coefficients, const Eigen::VectorXd &initial_guess);
+    
+    void set_load_case(const LoadCase &load_case);
+    
+    double compute_panel_objective(const std::shared_ptr<Body> &body, const std::shared_ptr<Surface> &surface, int panel,
+                                   const Eigen::Vector3d &force_weights, const Eigen::Vector3d &moment_weights, const Eigen::Vector3d &x) const;
+    
+    double compute_objective(const std::shared_ptr<Body> &body, const Eigen::Vector3d &force_weights, const Eigen::Vector3d &moment_weights, const Eigen::Vector3d &x) const;
+    
+    Eigen::VectorXd compute_objective_doublet_gradient(const std::shared_ptr<Body> &body, const Eigen::Vector3d &force_weights, const Eigen::Vector3d &moment_weights, const Eigen::Vector3d &x) const;
+    
+    double compute_adjoint_residual(const Eigen::VectorXd &adjoint, const Eigen::VectorXd &sources, const std::vector<int> &panels,
+                                    const std::vector<int> &upper_panels, const std::vector<int> &lower_panels) const;
+    
+    double compute_panel_residual(const std::shared_ptr<Surface> &row_surface, int row_panel, const std::shared_ptr<Surface> &col_surface, int col_panel,
+                                  double doublet_coefficient, double source_coefficient) const;
+    
+    void compute_source_coefficients(bool include_wake_influence);
+    
+    void compute_wake_doublet_coefficients();
+    
+    void compute_surface_velocities();
+    
+    void compute_pressure_coefficients(double dt);
+    
     double compute_source_coefficient(const std::shared_ptr<Body> &body, const std::shared_ptr<Surface> &surface, int panel,
                                       const std::shared_ptr<BoundaryLayer> &boundary_layer, bool include_wake_influence) const;
     
@@ -183,8 +382,24 @@ private:
     
     Eigen::Vector3d compute_velocity_interpolated(const Eigen::Vector3d &x, std::set<int> &ignore_set) const;
     
+    bool compute_close_velocity(const Eigen::Vector3d &x, std::set<int> &ignore_set, Eigen::Vector3d &interpolated_velocity) const;
+    
     Eigen::Vector3d compute_velocity(const Eigen::Vector3d &x) const;
     
+    void compute_velocity_and_velocity_potential(const Eigen::Vector3d &x, Eigen::Vector3d &velocity, double &velocity_potential) const;
+    
+    Eigen::Matrix3Xd compute_image_points(const Eigen::Vector3d &x) const;
+    
+    Eigen::Vector3d compute_induced_velocity(const std::shared_ptr<Surface> &surface, const Eigen::Ref<const Eigen::VectorXd> &source_coefficients,
+                                             const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients, const Eigen::Vector3d &x) const;
+    
+    double compute_induced_velocity_potential(const std::shared_ptr<Surface> &surface, const Eigen::Ref<const Eigen::VectorXd> &source_coefficients,
+                                              const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients, const Eigen::Vector3d &x) const;
+    
+    void compute_induced_velocity_and_velocity_potential(const std::shared_ptr<Surface> &surface, const Eigen::Ref<const Eigen::VectorXd> &source_coefficients,
+                                                         const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients, const Eigen::Vector3d &x,
+                                                         Eigen::Vector3d &velocity, double &velocity_potential) const;
+    
     double compute_velocity_potential(const Eigen::Vector3d &x) const;
     
     Eigen::Vector3d compute_trailing_edge_vortex_displacement(const std::shared_ptr<Body> &body, const std::shared_ptr<LiftingSurface> &lifting_surface, int index, double dt) const;
@@ -192,6 +407,8 @@ private:
     Eigen::Vector3d compute_scalar_field_gradient(const Eigen::VectorXd &scalar_field, const std::shared_ptr<Body> &body, const std::shared_ptr<Surface> &surface, int panel) const;
     
     int compute_index(const std::shared_ptr<Surface> &surface, int panel) const;
+    
+    void compute_surface_panel(int index, int &surface_index, int &panel) const;
 };
 
 };
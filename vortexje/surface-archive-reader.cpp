@@ -0,0 +1,702 @@
+//
+// Vortexje -- Surface archive reader.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <vortexje/surface-archive-reader.hpp>
+#include <vortexje/surface-writers/archive-surface-writer.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+// Size of the record header:  record type and payload size.
+static const uint64_t record_header_size = sizeof(uint32_t) + sizeof(uint64_t);
+
+// Size of the archive header:  identifier, version, and byte order mark.
+static const uint64_t archive_header_size = sizeof(ArchiveSurfaceWriter::archive_magic) + 2 * sizeof(uint32_t);
+
+// Helper to deserialize values from a record payload:
+class PayloadCursor
+{
+public:
+    PayloadCursor(const vector<char> &payload) : payload(payload), position(0), valid(true) {}
+    
+    template <class T>
+    T read()
+    {
+        T value = T();
+        
+        if (position + sizeof(T) > payload.size()) {
+            valid = false;
+            
+            return value;
+        }
+        
+        memcpy(&value, &payload[position], sizeof(T));
+        position += sizeof(T);
+        
+        return value;
+    }
+    
+    string read_string()
+    {
+        int32_t size = read<int32_t>();
+        if (size < 0 || position + size > payload.size()) {
+            valid = false;
+            
+            return string();
+        }
+        
+        string value(&payload[position], size);
+        position += size;
+        
+        return value;
+    }
+    
+    void read_doubles(double *values, size_t n_values)
+    {
+        if (position + n_values * sizeof(double) > payload.size()) {
+            valid = false;
+            
+            return;
+        }
+        
+        memcpy(values, &payload[position], n_values * sizeof(double));
+        position += n_values * sizeof(double);
+    }
+    
+    const vector<char> &payload;
+    size_t position;
+    bool valid;
+};
+
+// Helper to create the parent folders of a file:
+static void
+mkdir_parents_helper(const string &filename)
+{
+    for (size_t i = filename.find('/', 1); i != string::npos; i = filename.find('/', i + 1)) {
+        string folder = filename.substr(0, i);
+
+#ifdef _WIN32
+        if (mkdir(folder.c_str()) < 0)
+#else
+        if (mkdir(folder.c_str(), S_IRWXU) < 0)
+#endif
+            if (errno != EEXIST)
+                cerr << "SurfaceArchiveReader: Could not create folder " << folder << ": " << strerror(errno) << endl;
+    }
+}
+
+/**
+   Opens an archive, and reads its index.
+   
+   @param[in]   filename   Archive filename.
+   
+   @returns true on success.
+*/
+bool
+SurfaceArchiveReader::open(const std::string &filename)
+{
+    close();
+    
+    this->filename = filename;
+    
+    f.open(filename.c_str(), ios::binary);
+    if (!f.is_open()) {
+        cerr << "SurfaceArchiveReader: Unable to open " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    f.seekg(0, ios::end);
+    file_size = f.tellg();
+    f.seekg(0);
+    
+    // Check header:
+    char magic[sizeof(ArchiveSurfaceWriter::archive_magic)];
+    uint32_t version, byte_order_mark;
+    f.read(magic, sizeof(magic));
+    f.read((char *) &version, sizeof(version));
+    f.read((char *) &byte_order_mark, sizeof(byte_order_mark));
+    
+    if (!f.good() || memcmp(magic, ArchiveSurfaceWriter::archive_magic, sizeof(magic)) != 0) {
+        cerr << "SurfaceArchiveReader: " << filename << " is not a surface archive." << endl;
+        
+        close();
+        
+        return false;
+    }
+    
+    if (version != ArchiveSurfaceWriter::archive_version || byte_order_mark != 0x01020304) {
+        cerr << "SurfaceArchiveReader: " << filename << " has an unsupported version or byte order." << endl;
+        
+        close();
+        
+        return false;
+    }
+    
+    // Read index, or reconstruct it if the archive was not closed:
+    if (!read_index()) {
+        cout << "SurfaceArchiveReader: " << filename << " has no index.  Scanning records." << endl;
+        
+        if (!scan()) {
+            close();
+            
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/**
+   Closes the archive.
+*/
+void
+SurfaceArchiveReader::close()
+{
+    if (f.is_open())
+        f.close();
+    f.clear();
+    
+    stream_surface_ids.clear();
+    stream_n_steps.clear();
+    
+    index.clear();
+    step_entries.clear();
+}
+
+/**
+   Returns the number of streams, i.e., of distinct surfaces, in the archive.
+   
+   @returns Number of streams.
+*/
+int
+SurfaceArchiveReader::n_streams() const
+{
+    return stream_surface_ids.size();
+}
+
+/**
+   Returns the identifier of the surface written to a stream.
+   
+   @param[in]   stream   Stream number.
+   
+   @returns Surface identifier.
+*/
+const std::string &
+SurfaceArchiveReader::stream_surface_id(int stream) const
+{
+    return stream_surface_ids[stream];
+}
+
+/**
+   Returns the number of steps written to a stream.
+   
+   @param[in]   stream   Stream number.
+   
+   @returns Number of steps.
+*/
+int
+SurfaceArchiveReader::n_steps(int stream) const
+{
+    return stream_n_steps[stream];
+}
+
+/**
+   Returns the total number of steps, of all streams, in the archive.
+   
+   @returns Number of index entries.
+*/
+int
+SurfaceArchiveReader::n_entries() const
+{
+    return index.size();
+}
+
+/**
+   Returns the name of a step, i.e., the filename passed to ArchiveSurfaceWriter::write().
+   
+   @param[in]   entry   Index entry.
+   
+   @returns Step name.
+*/
+const std::string &
+SurfaceArchiveReader::entry_name(int entry) const
+{
+    return index[entry].name;
+}
+
+/**
+   Returns the stream to which a step belongs.
+   
+   @param[in]   entry   Index entry.
+   
+   @returns Stream number.
+*/
+int
+SurfaceArchiveReader::entry_stream(int entry) const
+{
+    return index[entry].stream;
+}
+
+/**
+   Returns the number of a step within its stream.
+   
+   @param[in]   entry   Index entry.
+   
+   @returns Step number.
+*/
+int
+SurfaceArchiveReader::entry_step(int entry) const
+{
+    return index[entry].step;
+}
+
+/**
+   Looks up a step by name.
+   
+   @param[in]   name   Step name.
+   
+   @returns Index entry, or -1 if not found.
+*/
+int
+SurfaceArchiveReader::find(const std::string &name) const
+{
+    for (int i = 0; i < (int) index.size(); i++)
+        if (index[i].name == name)
+            return i;
+    
+    return -1;
+}
+
+/**
+   Looks up a step by stream and step number.
+   
+   @param[in]   stream   Stream number.
+   @param[in]   step     Step number within the stream.
+   
+   @returns Index entry, or -1 if not found.
+*/
+int
+SurfaceArchiveReader::find(int stream, int step) const
+{
+    map<pair<int, int>, int>::const_iterator it = step_entries.find(make_pair(stream, step));
+    if (it == step_entries.end())
+        return -1;
+    
+    return it->second;
+}
+
+/**
+   Reads a step.  The returned surface contains the nodes and the panels of the step.  Quantities derived from these,
+   such as the panel neighbors and the panel coordinate systems, are not computed.
+   
+   @param[in]   entry        Index entry.
+   @param[out]  surface      Surface.
+   @param[out]  view_names   List of names of data vectors.
+   @param[out]  view_data    List of data vectors.
+   
+   @returns true on success.
+*/
+bool
+SurfaceArchiveReader::read(int entry, std::shared_ptr<Surface> &surface,
+                           std::vector<std::string> &view_names, std::vector<Eigen::MatrixXd, Eigen::aligned_allocator<Eigen::MatrixXd> > &view_data)
+{
+    const IndexEntry &e = index[entry];
+    
+    vector<char> payload;
+    if (!read_record(e.offset, ArchiveSurfaceWriter::STEP_RECORD, payload))
+        return false;
+    
+    PayloadCursor c(payload);
+    c.read<int32_t>();
+    c.read<int32_t>();
+    c.read_string();
+    uint64_t topology_offset = c.read<uint64_t>();
+    int n_nodes = c.read<int32_t>();
+    int type = c.read<int32_t>();
+    
+    // Skip geometry:
+    switch (type) {
+    case ArchiveSurfaceWriter::GEOMETRY_FULL:
+        c.position += 3 * n_nodes * sizeof(double);
+        break;
+    case ArchiveSurfaceWriter::GEOMETRY_UNCHANGED:
+        c.read<uint64_t>();
+        break;
+    case ArchiveSurfaceWriter::GEOMETRY_APPENDED:
+        c.read<uint64_t>();
+        c.position += 3 * (n_nodes - c.read<int32_t>()) * sizeof(double);
+        break;
+    case ArchiveSurfaceWriter::GEOMETRY_AFFINE:
+        c.read<uint64_t>();
+        c.position += 12 * sizeof(double);
+        break;
+    }
+    
+    // Panel data:
+    view_names.clear();
+    view_data.clear();
+    
+    int n_views = c.read<int32_t>();
+    for (int k = 0; k < n_views && c.valid; k++) {
+        view_names.push_back(c.read_string());
+        
+        int rows = c.read<int32_t>();
+        int cols = c.read<int32_t>();
+        if (!c.valid || rows < 0 || cols < 0)
+            break;
+        
+        MatrixXd data(rows, cols);
+        c.read_doubles(data.data(), data.size());
+        
+        view_data.push_back(data);
+    }
+    
+    if (!c.valid || c.position > payload.size()) {
+        cerr << "SurfaceArchiveReader: Corrupt step " << e.name << " in " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    // Surface:
+    surface = shared_ptr<Surface>(new Surface(stream_surface_ids[e.stream]));
+    
+    if (!read_topology(topology_offset, surface->panel_nodes))
+        return false;
+    
+    if (!read_geometry(e.offset, surface->nodes))
+        return false;
+    
+    if ((int) surface->nodes.size() != n_nodes) {
+        cerr << "SurfaceArchiveReader: Corrupt step " << e.name << " in " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+   Converts all steps in the archive into separate files.  The filename of every step is the given prefix, followed by
+   the step name and the file extension of the writer.  Missing folders are created.
+   
+   @param[in]   writer   Surface writer, e.g., a VTKSurfaceWriter.
+   @param[in]   prefix   Prefix of the filenames.
+   
+   @returns true on success.
+*/
+bool
+SurfaceArchiveReader::convert(SurfaceWriter &writer, const std::string &prefix)
+{
+    for (int i = 0; i < (int) index.size(); i++) {
+        shared_ptr<Surface> surface;
+        vector<string> view_names;
+        vector<MatrixXd, Eigen::aligned_allocator<MatrixXd> > view_data;
+        
+        if (!read(i, surface, view_names, view_data))
+            return false;
+        
+        string step_filename = prefix + index[i].name + writer.file_extension();
+        
+        mkdir_parents_helper(step_filename);
+        
+        if (!writer.write(surface, step_filename, 0, 0, view_names, view_data))
+            return false;
+    }
+    
+    return true;
+}
+
+// Read a record of any type.  Truncated records are rejected:
+bool
+SurfaceArchiveReader::read_record(uint64_t offset, uint32_t &type, std::vector<char> &payload, uint64_t &next_offset)
+{
+    f.clear();
+    f.seekg(offset);
+    
+    uint64_t size;
+    f.read((char *) &type, sizeof(type));
+    f.read((char *) &size, sizeof(size));
+    
+    if (!f.good() || offset + record_header_size + size > file_size)
+        return false;
+    
+    payload.resize(size);
+    f.read(payload.data(), size);
+    
+    if (!f.good())
+        return false;
+    
+    next_offset = offset + record_header_size + size;
+    
+    return true;
+}
+
+// Read a record of the expected type:
+bool
+SurfaceArchiveReader::read_record(uint64_t offset, int expected_type, std::vector<char> &payload)
+{
+    uint32_t type;
+    uint64_t next_offset;
+    if (!read_record(offset, type, payload, next_offset))
+        return false;
+    
+    return (int) type == expected_type;
+}
+
+// Read the index, by means of the trailer at the end of the archive:
+bool
+SurfaceArchiveReader::read_index()
+{
+    uint64_t index_offset;
+    char magic[sizeof(ArchiveSurfaceWriter::index_magic)];
+    
+    if (file_size < archive_header_size + sizeof(index_offset) + sizeof(magic))
+        return false;
+    
+    f.clear();
+    f.seekg(file_size - sizeof(index_offset) - sizeof(magic));
+    f.read((char *) &index_offset, sizeof(index_offset));
+    f.read(magic, sizeof(magic));
+    
+    if (!f.good() || memcmp(magic, ArchiveSurfaceWriter::index_magic, sizeof(magic)) != 0)
+        return false;
+    
+    vector<char> payload;
+    if (!read_record(index_offset, ArchiveSurfaceWriter::INDEX_RECORD, payload))
+        return false;
+    
+    PayloadCursor c(payload);
+    
+    int n_streams = c.read<int32_t>();
+    for (int i = 0; i < n_streams && c.valid; i++) {
+        stream_surface_ids.push_back(c.read_string());
+        stream_n_steps.push_back(0);
+    }
+    
+    int n_entries = c.read<int32_t>();
+    for (int i = 0; i < n_entries && c.valid; i++) {
+        int stream = c.read<int32_t>();
+        int step = c.read<int32_t>();
+        uint64_t offset = c.read<uint64_t>();
+        string name = c.read_string();
+        
+        if (stream < 0 || stream >= n_streams)
+            c.valid = false;
+        
+        if (c.valid)
+            add_entry(stream, step, offset, name);
+    }
+    
+    if (!c.valid) {
+        stream_surface_ids.clear();
+        stream_n_steps.clear();
+        
+        index.clear();
+        step_entries.clear();
+        
+        return false;
+    }
+    
+    return true;
+}
+
+// Reconstruct the index by scanning all records.  A truncated record at the end of the archive is ignored:
+bool
+SurfaceArchiveReader::scan()
+{
+    uint64_t offset = archive_header_size;
+    
+    uint32_t type;
+    vector<char> payload;
+    uint64_t next_offset;
+    while (read_record(offset, type, payload, next_offset)) {
+        PayloadCursor c(payload);
+        
+        if (type == ArchiveSurfaceWriter::STREAM_RECORD) {
+            int stream = c.read<int32_t>();
+            string surface_id = c.read_string();
+            
+            if (!c.valid || stream != (int) stream_surface_ids.size())
+                break;
+            
+            stream_surface_ids.push_back(surface_id);
+            stream_n_steps.push_back(0);
+        
+        } else if (type == ArchiveSurfaceWriter::STEP_RECORD) {
+            int stream = c.read<int32_t>();
+            int step = c.read<int32_t>();
+            string name = c.read_string();
+            
+            if (!c.valid || stream < 0 || stream >= (int) stream_surface_ids.size())
+                break;
+            
+            add_entry(stream, step, offset, name);
+        
+        } else if (type == ArchiveSurfaceWriter::INDEX_RECORD)
+            break;
+        
+        offset = next_offset;
+    }
+    
+    return true;
+}
+
+// Add an entry to the index:
+void
+SurfaceArchiveReader::add_entry(int stream, int step, uint64_t offset, const std::string &name)
+{
+    IndexEntry entry;
+    entry.stream = stream;
+    entry.step   = step;
+    entry.offset = offset;
+    entry.name   = name;
+    
+    step_entries[make_pair(stream, step)] = index.size();
+    
+    index.push_back(entry);
+    
+    stream_n_steps[stream] = max(stream_n_steps[stream], step + 1);
+}
+
+// Read the panels of a topology record, including those inherited from earlier topology records:
+bool
+SurfaceArchiveReader::read_topology(uint64_t offset, std::vector<std::vector<int> > &panel_nodes)
+{
+    vector<char> payload;
+    if (!read_record(offset, ArchiveSurfaceWriter::TOPOLOGY_RECORD, payload)) {
+        cerr << "SurfaceArchiveReader: Missing topology in " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    PayloadCursor c(payload);
+    c.read<int32_t>();
+    uint64_t base_offset = c.read<uint64_t>();
+    int n_inherited_panels = c.read<int32_t>();
+    int n_new_panels = c.read<int32_t>();
+    
+    if (n_inherited_panels > 0) {
+        if (!read_topology(base_offset, panel_nodes))
+            return false;
+        
+        if ((int) panel_nodes.size() != n_inherited_panels) {
+            cerr << "SurfaceArchiveReader: Corrupt topology in " << filename << "." << endl;
+            
+            return false;
+        }
+    } else
+        panel_nodes.clear();
+    
+    for (int i = 0; i < n_new_panels && c.valid; i++) {
+        int n = c.read<int32_t>();
+        
+        vector<int> single_panel_nodes;
+        for (int j = 0; j < n && c.valid; j++)
+            single_panel_nodes.push_back(c.read<int32_t>());
+        
+        panel_nodes.push_back(single_panel_nodes);
+    }
+    
+    if (!c.valid) {
+        cerr << "SurfaceArchiveReader: Corrupt topology in " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    return true;
+}
+
+// Read the nodes of a step, resolving references to the geometry of earlier steps:
+bool
+SurfaceArchiveReader::read_geometry(uint64_t offset, std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > &nodes)
+{
+    vector<char> payload;
+    if (!read_record(offset, ArchiveSurfaceWriter::STEP_RECORD, payload)) {
+        cerr << "SurfaceArchiveReader: Missing geometry in " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    PayloadCursor c(payload);
+    c.read<int32_t>();
+    c.read<int32_t>();
+    c.read_string();
+    c.read<uint64_t>();
+    int n_nodes = c.read<int32_t>();
+    int type = c.read<int32_t>();
+    
+    if (!c.valid || n_nodes < 0) {
+        cerr << "SurfaceArchiveReader: Corrupt geometry in " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    switch (type) {
+    case ArchiveSurfaceWriter::GEOMETRY_FULL:
+        nodes.resize(n_nodes);
+        for (int i = 0; i < n_nodes; i++)
+            c.read_doubles(nodes[i].data(), 3);
+        break;
+    case ArchiveSurfaceWriter::GEOMETRY_UNCHANGED:
+        if (!read_geometry(c.read<uint64_t>(), nodes))
+            return false;
+        break;
+    case ArchiveSurfaceWriter::GEOMETRY_APPENDED:
+        {
+            uint64_t base_offset = c.read<uint64_t>();
+            int n_base_nodes = c.read<int32_t>();
+            
+            if (!read_geometry(base_offset, nodes))
+                return false;
+            
+            if ((int) nodes.size() != n_base_nodes || n_base_nodes > n_nodes) {
+                c.valid = false;
+                break;
+            }
+            
+            nodes.resize(n_nodes);
+            for (int i = n_base_nodes; i < n_nodes; i++)
+                c.read_doubles(nodes[i].data(), 3);
+        }
+        break;
+    case ArchiveSurfaceWriter::GEOMETRY_AFFINE:
+        {
+            uint64_t base_offset = c.read<uint64_t>();
+            
+            Matrix<double, 3, 4> transformation;
+            c.read_doubles(transformation.data(), transformation.size());
+            
+            if (!read_geometry(base_offset, nodes))
+                return false;
+            
+            for (int i = 0; i < (int) nodes.size(); i++)
+                nodes[i] = transformation.leftCols<3>() * nodes[i] + transformation.col(3);
+        }
+        break;
+    default:
+        c.valid = false;
+        break;
+    }
+    
+    if (!c.valid || (int) nodes.size() != n_nodes) {
+        cerr << "SurfaceArchiveReader: Corrupt geometry in " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    return true;
+}
@@ -0,0 +1,107 @@
+//
+// Vortexje -- Surface archive reader.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __SURFACE_ARCHIVE_READER_HPP__
+#define __SURFACE_ARCHIVE_READER_HPP__
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include <vortexje/surface.hpp>
+#include <vortexje/surface-writer.hpp>
+
+namespace Vortexje
+{
+
+/**
+   Reader for archives written by the ArchiveSurfaceWriter.
+   
+   Any step can be read directly, by means of the index at the end of the archive.  If the index is missing, as is the case
+   for archives that were not closed properly, the index is reconstructed by scanning the records.
+   
+   @brief Surface archive reader.
+*/
+class SurfaceArchiveReader
+{
+public:
+    bool open(const std::string &filename);
+    
+    void close();
+    
+    int n_streams() const;
+    
+    const std::string &stream_surface_id(int stream) const;
+    
+    int n_steps(int stream) const;
+    
+    int n_entries() const;
+    
+    const std::string &entry_name(int entry) const;
+    
+    int entry_stream(int entry) const;
+    
+    int entry_step(int entry) const;
+    
+    int find(const std::string &name) const;
+    
+    int find(int stream, int step) const;
+    
+    bool read(int entry, std::shared_ptr<Surface> &surface,
+              std::vector<std::string> &view_names, std::vector<Eigen::MatrixXd, Eigen::aligned_allocator<Eigen::MatrixXd> > &view_data);
+    
+    bool convert(SurfaceWriter &writer, const std::string &prefix);
+
+private:
+    std::string filename;
+    
+    std::ifstream f;
+    
+    uint64_t file_size;
+    
+    std::vector<std::string> stream_surface_ids;
+    std::vector<int> stream_n_steps;
+    
+    class IndexEntry
+    {
+    public:
+        int stream;
+        int step;
+        uint64_t offset;
+        std::string name;
+    };
+    
+    std::vector<IndexEntry> index;
+    
+    std::map<std::pair<int, int>, int> step_entries;
+    
+    bool read_record(uint64_t offset, uint32_t &type, std::vector<char> &payload, uint64_t &next_offset);
+    
+    bool read_record(uint64_t offset, int expected_type, std::vector<char> &payload);
+    
+    bool read_index();
+    
+    bool scan();
+    
+    void add_entry(int stream, int step, uint64_t offset, const std::string &name);
+    
+    bool read_topology(uint64_t offset, std::vector<std::vector<int> > &panel_nodes);
+    
+    bool read_geometry(uint64_t offset, std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > &nodes);
+};
+
+};
+
+#endif // __SURFACE_ARCHIVE_READER_HPP__
@@ -41,7 +41,32 @@ SurfaceWriter::write(const std::shared_ptr<Surface> &surface, const std::string
                      int node_offset, int panel_offset)
 {
     vector<string> empty_names;
-    vector<MatrixXd, Eigen::aligned_allocator<MatrixXd> > empty_data;
+    vector<ViewData> empty_data;
     
     return write(surface, filename, 0, 0, empty_names, empty_data);
 }
+
+/**
+   Saves the given surface to a file, including data vectors associating numerical values to each panel.
+  
+   @param[in]   surface        Surface to write.
+   @param[in]   filename       Destination filename.
+   @param[in]   node_offset    Node numbering offset in output file.
+   @param[in]   panel_offset   Panel numbering offset in output file.
+   @param[in]   view_names     List of names of data vectors to be stored.
+   @param[in]   view_data      List of data vectors to be stored.
+   
+   @returns true on success.
+*/
+bool
+SurfaceWriter::write(const std::shared_ptr<Surface> &surface, const std::string &filename,
+                     int node_offset, int panel_offset,
+                     const std::vector<std::string> &view_names, const std::vector<Eigen::MatrixXd, Eigen::aligned_allocator<Eigen::MatrixXd> > &view_data)
+{
+    vector<ViewData> views;
+    views.reserve(view_data.size());
+    for (int k = 0; k < (int) view_data.size(); k++)
+        views.push_back(ViewData(view_data[k].data(), view_data[k].rows(), view_data[k].cols(), OuterStride<>(view_data[k].outerStride())));
+        
+    return write(surface, filename, node_offset, panel_offset, view_names, views);
+}
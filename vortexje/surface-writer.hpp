@@ -11,6 +11,10 @@
 
 #include <memory>
 #include <string>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
 
 #include <vortexje/surface.hpp>
 
@@ -25,6 +29,13 @@ namespace Vortexje
 class SurfaceWriter
 {
 public:
+    /**
+       Read-only view of a data vector associating numerical values to each panel, with one row per panel.  The view may
+       refer to a block of rows of a larger array, such as the global coefficient arrays of the solver, so that no data
+       needs to be copied for output.
+    */
+    typedef Eigen::Map<const Eigen::MatrixXd, 0, Eigen::OuterStride<> > ViewData;
+    
     /**
        Destructor.
     */
@@ -41,6 +52,10 @@ public:
     
     bool write(const std::shared_ptr<Surface> &surface, const std::string &filename,
                int node_offset, int panel_offset);
+    
+    bool write(const std::shared_ptr<Surface> &surface, const std::string &filename,
+               int node_offset, int panel_offset,
+               const std::vector<std::string> &view_names, const std::vector<Eigen::MatrixXd, Eigen::aligned_allocator<Eigen::MatrixXd> > &view_data);
       
     /**
        Saves the given surface to a file, including data vectors associating numerical values to each panel.
@@ -56,7 +71,7 @@ public:
     */               
     virtual bool write(const std::shared_ptr<Surface> &surface, const std::string &filename,
                        int node_offset, int panel_offset,
-                       const std::vector<std::string> &view_names, const std::vector<Eigen::MatrixXd, Eigen::aligned_allocator<Eigen::MatrixXd> > &view_data) = 0;
+                       const std::vector<std::string> &view_names, const std::vector<ViewData> &view_data) = 0;
 };
 
 };
@@ -0,0 +1,399 @@
+//
+// Vortexje -- Archive surface writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include <Eigen/QR>
+
+#include <vortexje/surface-writers/archive-surface-writer.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+const char ArchiveSurfaceWriter::archive_magic[8] = { 'V', 'X', 'J', 'A', 'R', 'C', 'H', 'V' };
+const char ArchiveSurfaceWriter::index_magic[8]   = { 'V', 'X', 'J', 'I', 'N', 'D', 'E', 'X' };
+
+const uint32_t ArchiveSurfaceWriter::archive_version = 1;
+
+// Relative tolerance for the detection of affine transformations:
+static const double affine_transformation_tolerance = 1e-12;
+
+// Helpers to serialize values into a record payload:
+template <class T>
+static void
+append(vector<char> &payload, const T &value)
+{
+    payload.insert(payload.end(), (const char *) &value, (const char *) &value + sizeof(T));
+}
+
+static void
+append(vector<char> &payload, const string &value)
+{
+    append(payload, (int32_t) value.size());
+    
+    payload.insert(payload.end(), value.begin(), value.end());
+}
+
+static void
+append(vector<char> &payload, const double *values, size_t n_values)
+{
+    payload.insert(payload.end(), (const char *) values, (const char *) (values + n_values));
+}
+
+/**
+   Constructs an archive surface writer, and creates the archive file.  An existing file is overwritten.
+   
+   @param[in]   archive_filename   Archive filename.
+*/
+ArchiveSurfaceWriter::ArchiveSurfaceWriter(const std::string &archive_filename) : archive_filename(archive_filename), offset(0)
+{
+    f.open(archive_filename.c_str(), ios::binary | ios::trunc);
+    if (!f.is_open()) {
+        cerr << "ArchiveSurfaceWriter: Unable to create " << archive_filename << "." << endl;
+        
+        return;
+    }
+    
+    // Header:  identifier, version, and a byte order mark.
+    vector<char> header;
+    header.insert(header.end(), archive_magic, archive_magic + sizeof(archive_magic));
+    append(header, archive_version);
+    append(header, (uint32_t) 0x01020304);
+    
+    f.write(header.data(), header.size());
+    
+    offset = header.size();
+}
+
+/**
+   Destructor.  Closes the archive, if this has not been done yet.
+*/
+ArchiveSurfaceWriter::~ArchiveSurfaceWriter()
+{
+    close();
+}
+
+/**
+   Returns the file extension used in step names.  Steps are not written to separate files, hence the extension is empty.
+   
+   @returns An empty string.
+*/
+const char *
+ArchiveSurfaceWriter::file_extension() const
+{
+    return "";
+}
+
+/**
+   Appends the given surface to the archive, including data vectors associating numerical values to each panel.
+   
+   @param[in]   surface        Surface to write.
+   @param[in]   filename       Name of the step within the archive.
+   @param[in]   node_offset    Node numbering offset in output file.  Ignored.
+   @param[in]   panel_offset   Panel numbering offset in output file.  Ignored.
+   @param[in]   view_names     List of names of data vectors to be stored.
+   @param[in]   view_data      List of data vectors to be stored.
+   
+   @returns true on success.
+*/
+bool
+ArchiveSurfaceWriter::write(const std::shared_ptr<Surface> &surface, const string &filename,
+                            int node_offset, int panel_offset,
+                            const std::vector<std::string> &view_names, const std::vector<ViewData> &view_data)
+{
+    if (!f.is_open()) {
+        cerr << "ArchiveSurfaceWriter: Archive " << archive_filename << " is not open." << endl;
+        
+        return false;
+    }
+    
+    int s = stream_number(surface);
+    if (s < 0)
+        return false;
+    
+    Stream &stream = streams[s];
+    
+    if (!write_topology(surface, stream, s))
+        return false;
+    
+    // Step header:
+    vector<char> payload;
+    append(payload, (int32_t) s);
+    append(payload, (int32_t) stream.n_steps);
+    append(payload, filename);
+    append(payload, stream.topology_offset);
+    append(payload, (int32_t) surface->n_nodes());
+    
+    // Geometry:
+    Matrix<double, 3, 4> transformation;
+    GeometryType type = geometry_type(surface, stream, transformation);
+    
+    append(payload, (int32_t) type);
+    
+    switch (type) {
+    case GEOMETRY_FULL:
+        for (int i = 0; i < surface->n_nodes(); i++)
+            append(payload, surface->nodes[i].data(), 3);
+        break;
+    case GEOMETRY_UNCHANGED:
+        append(payload, stream.geometry_offset);
+        break;
+    case GEOMETRY_APPENDED:
+        append(payload, stream.geometry_offset);
+        append(payload, (int32_t) stream.nodes.size());
+        for (int i = stream.nodes.size(); i < surface->n_nodes(); i++)
+            append(payload, surface->nodes[i].data(), 3);
+        break;
+    case GEOMETRY_AFFINE:
+        append(payload, stream.reference_geometry_offset);
+        append(payload, transformation.data(), transformation.size());
+        break;
+    }
+    
+    // Panel data:
+    append(payload, (int32_t) view_names.size());
+    for (int k = 0; k < (int) view_names.size(); k++) {
+        append(payload, view_names[k]);
+        append(payload, (int32_t) view_data[k].rows());
+        append(payload, (int32_t) view_data[k].cols());
+        for (int j = 0; j < view_data[k].cols(); j++)
+            append(payload, view_data[k].col(j).data(), view_data[k].rows());
+    }
+    
+    uint64_t step_offset = offset;
+    
+    if (!write_record(STEP_RECORD, payload))
+        return false;
+    
+    // Update stream state:
+    switch (type) {
+    case GEOMETRY_FULL:
+        stream.reference_nodes           = surface->nodes;
+        stream.reference_geometry_offset = step_offset;
+        
+        // Fall through.
+    case GEOMETRY_APPENDED:
+    case GEOMETRY_AFFINE:
+        stream.nodes           = surface->nodes;
+        stream.geometry_offset = step_offset;
+        break;
+    case GEOMETRY_UNCHANGED:
+        break;
+    }
+    
+    IndexEntry entry;
+    entry.stream = s;
+    entry.step   = stream.n_steps;
+    entry.offset = step_offset;
+    entry.name   = filename;
+    
+    index.push_back(entry);
+    
+    stream.n_steps++;
+    
+    // Done:
+    return true;
+}
+
+/**
+   Appends the index of all steps to the archive, and closes it.
+   
+   @returns true on success.
+*/
+bool
+ArchiveSurfaceWriter::close()
+{
+    if (!f.is_open())
+        return true;
+    
+    // Index:  surface identifiers of all streams, followed by all steps.
+    vector<char> payload;
+    append(payload, (int32_t) streams.size());
+    for (int i = 0; i < (int) streams.size(); i++)
+        append(payload, streams[i].surface_id);
+    
+    append(payload, (int32_t) index.size());
+    
+    vector<IndexEntry>::const_iterator it;
+    for (it = index.begin(); it != index.end(); it++) {
+        append(payload, (int32_t) it->stream);
+        append(payload, (int32_t) it->step);
+        append(payload, it->offset);
+        append(payload, it->name);
+    }
+    
+    uint64_t index_offset = offset;
+    
+    bool success = write_record(INDEX_RECORD, payload);
+    if (success) {
+        // Trailer, pointing at the index record:
+        vector<char> trailer;
+        append(trailer, index_offset);
+        trailer.insert(trailer.end(), index_magic, index_magic + sizeof(index_magic));
+        
+        f.write(trailer.data(), trailer.size());
+        
+        success = f.good();
+    }
+    
+    f.close();
+    
+    if (!success)
+        cerr << "ArchiveSurfaceWriter: Unable to write index to " << archive_filename << "." << endl;
+    
+    return success;
+}
+
+// Write a record, consisting of its type, the size of the payload, and the payload:
+bool
+ArchiveSurfaceWriter::write_record(RecordType type, const std::vector<char> &payload)
+{
+    vector<char> header;
+    append(header, (uint32_t) type);
+    append(header, (uint64_t) payload.size());
+    
+    f.write(header.data(), header.size());
+    f.write(payload.data(), payload.size());
+    
+    if (!f.good()) {
+        cerr << "ArchiveSurfaceWriter: Unable to write to " << archive_filename << "." << endl;
+        
+        return false;
+    }
+    
+    offset += header.size() + payload.size();
+    
+    return true;
+}
+
+// Look up the stream of a surface, and start a new stream if the surface was not written before:
+int
+ArchiveSurfaceWriter::stream_number(const std::shared_ptr<Surface> &surface)
+{
+    map<const Surface *, int>::const_iterator it = stream_numbers.find(surface.get());
+    if (it != stream_numbers.end())
+        return it->second;
+    
+    int s = streams.size();
+    
+    vector<char> payload;
+    append(payload, (int32_t) s);
+    append(payload, surface->id);
+    
+    if (!write_record(STREAM_RECORD, payload))
+        return -1;
+    
+    Stream stream;
+    stream.surface_id                = surface->id;
+    stream.n_steps                   = 0;
+    stream.topology_offset           = 0;
+    stream.geometry_offset           = 0;
+    stream.reference_geometry_offset = 0;
+    
+    streams.push_back(stream);
+    
+    stream_numbers[surface.get()] = s;
+    
+    return s;
+}
+
+// Write the topology of a surface, if it changed.  If panels were only appended, only the new panels are written:
+bool
+ArchiveSurfaceWriter::write_topology(const std::shared_ptr<Surface> &surface, Stream &stream, int stream_number)
+{
+    int n_inherited_panels = 0;
+    if (stream.topology_offset > 0 && surface->n_panels() >= (int) stream.panel_nodes.size()) {
+        n_inherited_panels = stream.panel_nodes.size();
+        for (int i = 0; i < n_inherited_panels; i++) {
+            if (surface->panel_nodes[i] != stream.panel_nodes[i]) {
+                n_inherited_panels = 0;
+                break;
+            }
+        }
+        
+        // Unchanged topology:
+        if (n_inherited_panels == surface->n_panels() && n_inherited_panels == (int) stream.panel_nodes.size())
+            return true;
+    }
+    
+    vector<char> payload;
+    append(payload, (int32_t) stream_number);
+    append(payload, (uint64_t) (n_inherited_panels > 0 ? stream.topology_offset : 0));
+    append(payload, (int32_t) n_inherited_panels);
+    append(payload, (int32_t) (surface->n_panels() - n_inherited_panels));
+    for (int i = n_inherited_panels; i < surface->n_panels(); i++) {
+        append(payload, (int32_t) surface->panel_nodes[i].size());
+        for (int j = 0; j < (int) surface->panel_nodes[i].size(); j++)
+            append(payload, (int32_t) surface->panel_nodes[i][j]);
+    }
+    
+    uint64_t topology_offset = offset;
+    
+    if (!write_record(TOPOLOGY_RECORD, payload))
+        return false;
+    
+    stream.panel_nodes     = surface->panel_nodes;
+    stream.topology_offset = topology_offset;
+    
+    return true;
+}
+
+// Determine how the geometry of a surface is stored, relative to the geometry stored earlier in the stream:
+ArchiveSurfaceWriter::GeometryType
+ArchiveSurfaceWriter::geometry_type(const std::shared_ptr<Surface> &surface, const Stream &stream, Eigen::Matrix<double, 3, 4> &transformation) const
+{
+    if (stream.geometry_offset == 0)
+        return GEOMETRY_FULL;
+    
+    // Unchanged, or with appended nodes:
+    int n_common_nodes = min(surface->n_nodes(), (int) stream.nodes.size());
+    
+    bool common_nodes_unchanged = true;
+    for (int i = 0; i < n_common_nodes; i++) {
+        if (surface->nodes[i] != stream.nodes[i]) {
+            common_nodes_unchanged = false;
+            break;
+        }
+    }
+    
+    if (common_nodes_unchanged) {
+        if (surface->n_nodes() == (int) stream.nodes.size())
+            return GEOMETRY_UNCHANGED;
+        else if (surface->n_nodes() > (int) stream.nodes.size())
+            return GEOMETRY_APPENDED;
+    }
+    
+    // Affine, e.g., rigid, transformation of the reference geometry.  Fit the transformation in the least-squares sense, and
+    // accept it if it reproduces all nodes:
+    int n = surface->n_nodes();
+    if (n != (int) stream.reference_nodes.size() || n < 4)
+        return GEOMETRY_FULL;
+    
+    MatrixXd X(n, 4);
+    MatrixXd Y(n, 3);
+    double scale = 1.0;
+    for (int i = 0; i < n; i++) {
+        X.block<1, 3>(i, 0) = stream.reference_nodes[i].transpose();
+        X(i, 3) = 1.0;
+        
+        Y.row(i) = surface->nodes[i].transpose();
+        
+        scale = max(scale, surface->nodes[i].cwiseAbs().maxCoeff());
+    }
+    
+    transformation = X.colPivHouseholderQr().solve(Y).transpose();
+    
+    double residual = (X * transformation.transpose() - Y).cwiseAbs().maxCoeff();
+    if (residual < affine_transformation_tolerance * scale)
+        return GEOMETRY_AFFINE;
+    
+    return GEOMETRY_FULL;
+}
@@ -0,0 +1,141 @@
+//
+// Vortexje -- Archive surface writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __ARCHIVE_SURFACE_WRITER_HPP__
+#define __ARCHIVE_SURFACE_WRITER_HPP__
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#include <vortexje/surface-writer.hpp>
+
+namespace Vortexje
+{
+
+/**
+   Surface writer which appends all surfaces, at all time steps, to a single binary archive file.
+   
+   Every surface written to the archive forms a stream of steps.  The topology of a stream is stored once, and extended
+   incrementally as panels are added, as happens for wakes.  The geometry of a step is only stored if it changed:  Unchanged
+   geometry, geometry with appended nodes, and affine (e.g., rigid) transformations of previously stored geometry are stored
+   as deltas.  The filename passed to write() serves as the name of the step within the archive.
+   
+   Records are self-delimiting, and every record is written in one go.  When the archive is closed, an index of all steps
+   is appended, giving random access to any step by means of the SurfaceArchiveReader.  Archives that were not closed,
+   for instance due to a crash, remain readable by scanning the records.
+   
+   @brief Archive surface writer.
+*/
+class ArchiveSurfaceWriter : public SurfaceWriter
+{
+public:
+    /**
+       Record types.
+    */
+    typedef enum {
+        STREAM_RECORD   = 1,
+        TOPOLOGY_RECORD = 2,
+        STEP_RECORD     = 3,
+        INDEX_RECORD    = 4
+    } RecordType;
+    
+    /**
+       Geometry storage types.
+    */
+    typedef enum {
+        GEOMETRY_FULL      = 0,
+        GEOMETRY_UNCHANGED = 1,
+        GEOMETRY_APPENDED  = 2,
+        GEOMETRY_AFFINE    = 3
+    } GeometryType;
+    
+    /**
+       Archive file identifier.
+    */
+    static const char archive_magic[8];
+    
+    /**
+       Index trailer identifier.
+    */
+    static const char index_magic[8];
+    
+    /**
+       Archive format version.
+    */
+    static const uint32_t archive_version;
+    
+    ArchiveSurfaceWriter(const std::string &archive_filename);
+    
+    ~ArchiveSurfaceWriter();
+    
+    const char *file_extension() const;
+    
+    bool write(const std::shared_ptr<Surface> &surface, const std::string &filename,
+               int node_offset, int panel_offset,
+               const std::vector<std::string> &view_names, const std::vector<ViewData> &view_data);
+    
+    bool close();
+
+private:
+    std::string archive_filename;
+    
+    std::ofstream f;
+    
+    uint64_t offset;
+    
+    class Stream
+    {
+    public:
+        std::string surface_id;
+        
+        int n_steps;
+        
+        std::vector<std::vector<int> > panel_nodes;
+        uint64_t topology_offset;
+        
+        std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > nodes;
+        uint64_t geometry_offset;
+        
+        std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > reference_nodes;
+        uint64_t reference_geometry_offset;
+    };
+    
+    std::map<const Surface *, int> stream_numbers;
+    std::vector<Stream> streams;
+    
+    class IndexEntry
+    {
+    public:
+        int stream;
+        int step;
+        uint64_t offset;
+        std::string name;
+    };
+    
+    std::vector<IndexEntry> index;
+    
+    bool write_record(RecordType type, const std::vector<char> &payload);
+    
+    int stream_number(const std::shared_ptr<Surface> &surface);
+    
+    bool write_topology(const std::shared_ptr<Surface> &surface, Stream &stream, int stream_number);
+    
+    GeometryType geometry_type(const std::shared_ptr<Surface> &surface, const Stream &stream, Eigen::Matrix<double, 3, 4> &transformation) const;
+    
+    // Archive surface writers cannot be copied:
+    ArchiveSurfaceWriter(const ArchiveSurfaceWriter &);
+    ArchiveSurfaceWriter &operator=(const ArchiveSurfaceWriter &);
+};
+
+};
+
+#endif // __ARCHIVE_SURFACE_WRITER_HPP__
@@ -0,0 +1,107 @@
+//
+// Vortexje -- Asynchronous surface writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <vortexje/surface-writers/async-surface-writer.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+/**
+   Constructs an asynchronous surface writer, and starts its I/O thread.
+   
+   @param[in]   writer             Surface writer to which the surfaces are handed.
+   @param[in]   max_queue_length   Maximum number of pending writes.
+*/
+AsyncSurfaceWriter::AsyncSurfaceWriter(SurfaceWriter &writer, int max_queue_length) : writer(writer), queue(max_queue_length)
+{
+}
+
+/**
+   Destructor.  Completes all pending writes.
+*/
+AsyncSurfaceWriter::~AsyncSurfaceWriter()
+{
+    queue.flush();
+}
+
+/**
+   Returns the file extension of the wrapped surface writer.
+   
+   @returns The file extension.
+*/
+const char *
+AsyncSurfaceWriter::file_extension() const
+{
+    return writer.file_extension();
+}
+
+/**
+   Queues the given surface for writing, including data vectors associating numerical values to each panel.  The surface
+   and the data vectors may be modified as soon as this function returns.
+   
+   @param[in]   surface        Surface to write.
+   @param[in]   filename       Destination filename.
+   @param[in]   node_offset    Node numbering offset in output file.
+   @param[in]   panel_offset   Panel numbering offset in output file.
+   @param[in]   view_names     List of names of data vectors to be stored.
+   @param[in]   view_data      List of data vectors to be stored.
+   
+   @returns true.  Errors are reported by flush().
+*/
+bool
+AsyncSurfaceWriter::write(const std::shared_ptr<Surface> &surface, const string &filename,
+                          int node_offset, int panel_offset,
+                          const std::vector<std::string> &view_names, const std::vector<ViewData> &view_data)
+{
+    // Snapshot:
+    shared_ptr<Job> job = make_shared<Job>();
+    job->surface      = surface.get();
+    job->surface_id   = surface->id;
+    job->nodes        = surface->nodes;
+    job->panel_nodes  = surface->panel_nodes;
+    job->filename     = filename;
+    job->node_offset  = node_offset;
+    job->panel_offset = panel_offset;
+    job->view_names   = view_names;
+    
+    job->view_data.reserve(view_data.size());
+    for (int k = 0; k < (int) view_data.size(); k++)
+        job->view_data.push_back(MatrixXd(view_data[k]));
+    
+    // Queue:
+    queue.push(std::bind(&AsyncSurfaceWriter::write_job, this, job));
+    
+    return true;
+}
+
+/**
+   Waits until all queued surfaces have been written.
+   
+   @returns true if all writes since the previous flush succeeded.
+*/
+bool
+AsyncSurfaceWriter::flush()
+{
+    return queue.flush();
+}
+
+// Hand a snapshot to the wrapped writer.  Runs on the I/O thread:
+bool
+AsyncSurfaceWriter::write_job(const std::shared_ptr<Job> &job)
+{
+    shared_ptr<Surface> &snapshot_surface = snapshot_surfaces[job->surface];
+    if (!snapshot_surface)
+        snapshot_surface = make_shared<Surface>(job->surface_id);
+    
+    snapshot_surface->id = job->surface_id;
+    snapshot_surface->nodes.swap(job->nodes);
+    snapshot_surface->panel_nodes.swap(job->panel_nodes);
+    
+    return writer.write(snapshot_surface, job->filename, job->node_offset, job->panel_offset, job->view_names, job->view_data);
+}
@@ -0,0 +1,85 @@
+//
+// Vortexje -- Asynchronous surface writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __ASYNC_SURFACE_WRITER_HPP__
+#define __ASYNC_SURFACE_WRITER_HPP__
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <vortexje/surface-writer.hpp>
+#include <vortexje/async-write-queue.hpp>
+
+namespace Vortexje
+{
+
+/**
+   Surface writer which hands surfaces to another surface writer, running on a background I/O thread.
+   
+   write() takes a snapshot of the node positions, the panels, and the data vectors, queues it, and returns immediately.
+   The time stepping loop may therefore proceed with the next time step, while the previous one is being written.  If
+   the queue is full, write() blocks until the I/O thread catches up.
+   
+   The wrapped surface writer is called from the I/O thread only, and must not be used directly while this writer is
+   alive.  Every source surface is represented to the wrapped writer by the same snapshot surface, so that writers which
+   track surfaces across calls, such as the ArchiveSurfaceWriter, see a consistent identity.
+   
+   @brief Asynchronous surface writer.
+*/
+class AsyncSurfaceWriter : public SurfaceWriter
+{
+public:
+    AsyncSurfaceWriter(SurfaceWriter &writer, int max_queue_length = 32);
+    
+    ~AsyncSurfaceWriter();
+    
+    const char *file_extension() const;
+    
+    bool write(const std::shared_ptr<Surface> &surface, const std::string &filename,
+               int node_offset, int panel_offset,
+               const std::vector<std::string> &view_names, const std::vector<ViewData> &view_data);
+    
+    bool flush();
+
+private:
+    SurfaceWriter &writer;
+    
+    class Job
+    {
+    public:
+        const Surface *surface;
+        
+        std::string surface_id;
+        
+        std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > nodes;
+        
+        std::vector<std::vector<int> > panel_nodes;
+        
+        std::string filename;
+        
+        int node_offset;
+        int panel_offset;
+        
+        std::vector<std::string> view_names;
+        std::vector<Eigen::MatrixXd, Eigen::aligned_allocator<Eigen::MatrixXd> > view_data;
+    };
+    
+    // Snapshot surfaces, by source surface.  Only accessed by the I/O thread:
+    std::map<const Surface *, std::shared_ptr<Surface> > snapshot_surfaces;
+    
+    // The queue is declared last, so that it is flushed before the other members are destroyed:
+    AsyncWriteQueue queue;
+    
+    bool write_job(const std::shared_ptr<Job> &job);
+};
+
+};
+
+#endif // __ASYNC_SURFACE_WRITER_HPP__
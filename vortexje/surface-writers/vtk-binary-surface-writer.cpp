@@ -0,0 +1,139 @@
+//
+// Vortexje -- VTK binary surface writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+#include <vortexje/vtk-binary-data.hpp>
+#include <vortexje/surface-writers/vtk-binary-surface-writer.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+/**
+   Returns the VTK surface file extension (".vtk").
+   
+   @returns The VTK surface file extension (".vtk").
+*/
+const char *
+VTKBinarySurfaceWriter::file_extension() const
+{
+    return ".vtk";
+}
+
+/**
+   Saves the given surface to a binary VTK file, including data vectors associating numerical values to each panel.  The
+   file is assembled in memory, and written to disk in one go.
+  
+   @param[in]   surface        Surface to write.
+   @param[in]   filename       Destination filename.
+   @param[in]   node_offset    Node numbering offset in output file.
+   @param[in]   panel_offset   Panel numbering offset in output file.
+   @param[in]   view_names     List of names of data vectors to be stored.
+   @param[in]   view_data      List of data vectors to be stored.
+   
+   @returns true on success.
+*/
+bool
+VTKBinarySurfaceWriter::write(const std::shared_ptr<Surface> &surface, const string &filename, 
+                              int node_offset, int panel_offset,
+                              const std::vector<std::string> &view_names, const std::vector<ViewData> &view_data)
+{
+    cout << "Surface " << surface->id << ": Saving to " << filename << "." << endl;
+    
+    VTKLegacyBinaryData data;
+    
+    data.append("# vtk DataFile Version 2.0\n");
+    data.append("FieldData\n");
+    data.append("BINARY\n");
+    data.append("DATASET UNSTRUCTURED_GRID\n");
+    
+    // Nodes:
+    stringstream ss;
+    ss << "POINTS " << surface->n_nodes() << " double\n";
+    data.append(ss.str());
+    
+    vector<double> points(3 * surface->n_nodes());
+    for (int i = 0; i < surface->n_nodes(); i++)
+        for (int j = 0; j < 3; j++)
+            points[3 * i + j] = surface->nodes[i](j);
+            
+    data.append(points.data(), points.size());
+    data.append("\n");
+    
+    // Panels:
+    vector<int32_t> cells;
+    vector<int32_t> cell_types;
+    for (int i = 0; i < surface->n_panels(); i++) {
+        cells.push_back(surface->panel_nodes[i].size());
+        for (int j = 0; j < (int) surface->panel_nodes[i].size(); j++)
+            cells.push_back(surface->panel_nodes[i][j]);
+            
+        switch (surface->panel_nodes[i].size()) {
+        case 3:
+            cell_types.push_back(5);
+            break;
+        case 4:
+            cell_types.push_back(9);
+            break;
+        default:
+            cell_types.push_back(7);
+            break;
+        }
+    }
+    
+    ss.str(string());
+    ss << "CELLS " << surface->n_panels() << " " << cells.size() << "\n";
+    data.append(ss.str());
+    data.append(cells.data(), cells.size());
+    data.append("\n");
+    
+    ss.str(string());
+    ss << "CELL_TYPES " << surface->n_panels() << "\n";
+    data.append(ss.str());
+    data.append(cell_types.data(), cell_types.size());
+    data.append("\n");
+    
+    // Panel data:
+    ss.str(string());
+    ss << "CELL_DATA " << surface->n_panels() << "\n";
+    data.append(ss.str());
+    
+    for (int k = 0; k < (int) view_names.size(); k++) {
+        ss.str(string());
+        if (view_data[k].cols() == 1) {
+            ss << "SCALARS " << view_names[k] << " double 1\n";
+            ss << "LOOKUP_TABLE default\n";
+        } else
+            ss << "VECTORS " << view_names[k] << " double\n";
+        data.append(ss.str());
+        
+        // Panel values are stored consecutively, i.e., in row-major order:
+        Matrix<double, Dynamic, Dynamic, RowMajor> values = view_data[k].topRows(surface->n_panels());
+        
+        data.append(values.data(), values.size());
+        data.append("\n");
+    }
+    
+    // Save to disk:
+    ofstream f;
+    f.open(filename.c_str(), ios::binary);
+    
+    if (!data.write(f)) {
+        cerr << "Surface " << surface->id << ": Unable to save to " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    f.close();
+    
+    // Done:
+    return true;
+}
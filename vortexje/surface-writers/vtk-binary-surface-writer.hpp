@@ -0,0 +1,36 @@
+//
+// Vortexje -- VTK binary surface writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __VTK_BINARY_SURFACE_WRITER_HPP__
+#define __VTK_BINARY_SURFACE_WRITER_HPP__
+
+#include <string>
+
+#include <vortexje/surface-writer.hpp>
+
+namespace Vortexje
+{
+
+/**
+   Legacy VTK surface file writer, using the binary data format.
+   
+   @brief VTK binary surface writer.
+*/
+class VTKBinarySurfaceWriter : public SurfaceWriter
+{
+public:
+    const char *file_extension() const;
+       
+    bool write(const std::shared_ptr<Surface> &surface, const std::string &filename,
+               int node_offset, int panel_offset,
+               const std::vector<std::string> &view_names, const std::vector<ViewData> &view_data);
+};
+
+};
+
+#endif // __VTK_BINARY_SURFACE_WRITER_HPP__
@@ -42,7 +42,7 @@ VTKSurfaceWriter::file_extension() const
 bool
 VTKSurfaceWriter::write(const std::shared_ptr<Surface> &surface, const string &filename, 
                         int node_offset, int panel_offset,
-                        const std::vector<std::string> &view_names, const vector<MatrixXd, Eigen::aligned_allocator<MatrixXd> > &view_data)
+                        const std::vector<std::string> &view_names, const std::vector<ViewData> &view_data)
 {
     cout << "Surface " << surface->id << ": Saving to " << filename << "." << endl;
     
@@ -62,7 +62,7 @@ VTKSurfaceWriter::write(const std::shared_ptr<Surface> &surface, const string &f
                 f << ' ';
             f << surface->nodes[i](j);
         }
-        f << endl;
+        f << '\n';
     }
     
     f << endl;
@@ -81,7 +81,7 @@ VTKSurfaceWriter::write(const std::shared_ptr<Surface> &surface, const string &f
             f << surface->panel_nodes[i][j];
         }
         
-        f << endl;
+        f << '\n';
     }
     
     f << endl;
@@ -102,7 +102,7 @@ VTKSurfaceWriter::write(const std::shared_ptr<Surface> &surface, const string &f
             continue;
         }
         
-        f << cell_type << endl;
+        f << cell_type << '\n';
     }
     
     f << endl;
@@ -124,7 +124,7 @@ VTKSurfaceWriter::write(const std::shared_ptr<Surface> &surface, const string &f
                 f << view_data[k](i, j);
             }
             
-            f << endl;
+            f << '\n';
         }
         
         f << endl;
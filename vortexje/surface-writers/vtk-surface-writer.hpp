@@ -28,7 +28,7 @@ public:
        
     bool write(const std::shared_ptr<Surface> &surface, const std::string &filename,
                int node_offset, int panel_offset,
-               const std::vector<std::string> &view_names, const std::vector<Eigen::MatrixXd, Eigen::aligned_allocator<Eigen::MatrixXd> > &view_data);
+               const std::vector<std::string> &view_names, const std::vector<ViewData> &view_data);
 };
 
 };
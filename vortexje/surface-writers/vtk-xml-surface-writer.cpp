@@ -0,0 +1,146 @@
+//
+// Vortexje -- VTK XML surface writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <iostream>
+#include <fstream>
+
+#include <vortexje/vtk-binary-data.hpp>
+#include <vortexje/surface-writers/vtk-xml-surface-writer.hpp>
+
+using namespace std;
+using namespace Eigen;
+using namespace Vortexje;
+
+/**
+   Constructs a VTK XML surface writer.
+   
+   @param[in]   compress   Compress the data arrays with zlib.
+*/
+VTKXMLSurfaceWriter::VTKXMLSurfaceWriter(bool compress) : compress(compress)
+{
+}
+
+/**
+   Returns the VTK XML unstructured grid file extension (".vtu").
+   
+   @returns The VTK XML unstructured grid file extension (".vtu").
+*/
+const char *
+VTKXMLSurfaceWriter::file_extension() const
+{
+    return ".vtu";
+}
+
+/**
+   Saves the given surface to a VTK XML file, including data vectors associating numerical values to each panel.  The
+   data arrays are assembled in memory, and written to disk in one go.
+  
+   @param[in]   surface        Surface to write.
+   @param[in]   filename       Destination filename.
+   @param[in]   node_offset    Node numbering offset in output file.
+   @param[in]   panel_offset   Panel numbering offset in output file.
+   @param[in]   view_names     List of names of data vectors to be stored.
+   @param[in]   view_data      List of data vectors to be stored.
+   
+   @returns true on success.
+*/
+bool
+VTKXMLSurfaceWriter::write(const std::shared_ptr<Surface> &surface, const string &filename, 
+                           int node_offset, int panel_offset,
+                           const std::vector<std::string> &view_names, const std::vector<ViewData> &view_data)
+{
+    cout << "Surface " << surface->id << ": Saving to " << filename << "." << endl;
+    
+    VTKAppendedData data(compress);
+    
+    // Nodes:
+    vector<double> points(3 * surface->n_nodes());
+    for (int i = 0; i < surface->n_nodes(); i++)
+        for (int j = 0; j < 3; j++)
+            points[3 * i + j] = surface->nodes[i](j);
+            
+    uint64_t points_offset = data.append(points.data(), points.size());
+    
+    // Panels:
+    vector<int32_t> connectivity;
+    vector<int32_t> offsets;
+    vector<uint8_t> cell_types;
+    for (int i = 0; i < surface->n_panels(); i++) {
+        for (int j = 0; j < (int) surface->panel_nodes[i].size(); j++)
+            connectivity.push_back(surface->panel_nodes[i][j]);
+            
+        offsets.push_back(connectivity.size());
+        
+        switch (surface->panel_nodes[i].size()) {
+        case 3:
+            cell_types.push_back(5);
+            break;
+        case 4:
+            cell_types.push_back(9);
+            break;
+        default:
+            cell_types.push_back(7);
+            break;
+        }
+    }
+    
+    uint64_t connectivity_offset = data.append(connectivity.data(), connectivity.size());
+    uint64_t offsets_offset      = data.append(offsets.data(), offsets.size());
+    uint64_t cell_types_offset   = data.append(cell_types.data(), cell_types.size());
+    
+    // Panel data.  Panel values are stored consecutively, i.e., in row-major order:
+    vector<uint64_t> view_offsets;
+    for (int k = 0; k < (int) view_names.size(); k++) {
+        Matrix<double, Dynamic, Dynamic, RowMajor> values = view_data[k].topRows(surface->n_panels());
+        
+        view_offsets.push_back(data.append(values.data(), values.size()));
+    }
+    
+    // Save to disk:
+    ofstream f;
+    f.open(filename.c_str(), ios::binary);
+    
+    f << "<?xml version=\"1.0\"?>\n";
+    f << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"" << data.byte_order() << "\" header_type=\"UInt64\"";
+    if (data.compressed())
+        f << " compressor=\"vtkZLibDataCompressor\"";
+    f << ">\n";
+    f << " <UnstructuredGrid>\n";
+    f << "  <Piece NumberOfPoints=\"" << surface->n_nodes() << "\" NumberOfCells=\"" << surface->n_panels() << "\">\n";
+    f << "   <Points>\n";
+    f << "    <DataArray type=\"Float64\" Name=\"Points\" NumberOfComponents=\"3\" format=\"appended\" offset=\"" << points_offset << "\"/>\n";
+    f << "   </Points>\n";
+    f << "   <Cells>\n";
+    f << "    <DataArray type=\"Int32\" Name=\"connectivity\" format=\"appended\" offset=\"" << connectivity_offset << "\"/>\n";
+    f << "    <DataArray type=\"Int32\" Name=\"offsets\" format=\"appended\" offset=\"" << offsets_offset << "\"/>\n";
+    f << "    <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\"" << cell_types_offset << "\"/>\n";
+    f << "   </Cells>\n";
+    f << "   <CellData>\n";
+    for (int k = 0; k < (int) view_names.size(); k++) {
+        f << "    <DataArray type=\"Float64\" Name=\"" << view_names[k] << "\" NumberOfComponents=\"" << view_data[k].cols()
+          << "\" format=\"appended\" offset=\"" << view_offsets[k] << "\"/>\n";
+    }
+    f << "   </CellData>\n";
+    f << "  </Piece>\n";
+    f << " </UnstructuredGrid>\n";
+    
+    bool data_written = data.write(f);
+    
+    f << "</VTKFile>\n";
+    
+    if (!data_written || !f.good()) {
+        cerr << "Surface " << surface->id << ": Unable to save to " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    f.close();
+    
+    // Done:
+    return true;
+}
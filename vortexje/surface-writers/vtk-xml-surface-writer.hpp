@@ -0,0 +1,42 @@
+//
+// Vortexje -- VTK XML surface writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __VTK_XML_SURFACE_WRITER_HPP__
+#define __VTK_XML_SURFACE_WRITER_HPP__
+
+#include <string>
+
+#include <vortexje/surface-writer.hpp>
+
+namespace Vortexje
+{
+
+/**
+   VTK XML unstructured grid (.vtu) file writer.  All data arrays are stored in a single appended binary data section,
+   optionally compressed with zlib.
+   
+   @brief VTK XML surface writer.
+*/
+class VTKXMLSurfaceWriter : public SurfaceWriter
+{
+public:
+    VTKXMLSurfaceWriter(bool compress = false);
+    
+    const char *file_extension() const;
+       
+    bool write(const std::shared_ptr<Surface> &surface, const std::string &filename,
+               int node_offset, int panel_offset,
+               const std::vector<std::string> &view_names, const std::vector<ViewData> &view_data);
+               
+private:
+    bool compress;
+};
+
+};
+
+#endif // __VTK_XML_SURFACE_WRITER_HPP__
@@ -12,6 +12,7 @@
 #include <limits>
 #include <cmath>
 #include <algorithm>
+#include <map>
 
 #include <Eigen/Geometry>
 
@@ -29,8 +30,10 @@ static const double one_over_4pi = 1.0 / (4 * pi);
 /**
    Constructs an empty surface.
 */
-Surface::Surface(const string &id) : id(id)
+Surface::Surface(const string &id) : id(id), n_vortex_filament_panels(0)
 {
+    panel_neighbors          = make_shared<vector<vector<vector<pair<int, int> > > > >();
+    panel_transformed_points = make_shared<vector<vector<Vector3d, Eigen::aligned_allocator<Vector3d> > > >();
 }
 
 /**
@@ -109,6 +112,10 @@ Surface::add_quadrangle(int node_a, int node_b, int node_c, int node_d)
 void
 Surface::compute_topology()
 {   
+    // Stop sharing the panel neighbor map with copies of this surface:
+    if (panel_neighbors.use_count() > 1)
+        panel_neighbors = make_shared<vector<vector<vector<pair<int, int> > > > >(*panel_neighbors);
+    
     // Compute panel neighbors:
     for (int i = 0; i < (int) panel_nodes.size(); i++) {
         vector<vector<pair<int, int> > > single_panel_neighbors;
@@ -165,8 +172,62 @@ Surface::compute_topology()
             }
         }
         
-        panel_neighbors.push_back(single_panel_neighbors);
+        panel_neighbors->push_back(single_panel_neighbors);
+    }
+    
+    // Compute vortex filaments:
+    compute_vortex_filaments();
+}
+
+/**
+   Computes the unique vortex filaments of the vortex ring lattice.  An edge shared by two panels is stored only once, so that
+   the velocity induced by the vortex sheet can be evaluated using a single Biot-Savart evaluation per edge, carrying the
+   net circulation of the adjacent vortex rings.
+   
+   @note The filaments are indexed by node and panel numbers, and therefore remain valid under transformations of the surface.
+   They must be recomputed whenever panels are added.
+*/
+void
+Surface::compute_vortex_filaments()
+{
+    vortex_filaments.clear();
+    
+    // Directed edge to unpaired filament map:
+    map<pair<int, int>, int> unpaired_filaments;
+    
+    for (int i = 0; i < (int) panel_nodes.size(); i++) {
+        for (int j = 0; j < (int) panel_nodes[i].size(); j++) {
+            int previous_j;
+            if (j == 0)
+                previous_j = panel_nodes[i].size() - 1;
+            else
+                previous_j = j - 1;
+                
+            int node_a = panel_nodes[i][previous_j];
+            int node_b = panel_nodes[i][j];
+            
+            // Is this edge traversed in the opposite direction by a panel visited earlier?
+            map<pair<int, int>, int>::iterator it = unpaired_filaments.find(make_pair(node_b, node_a));
+            if (it != unpaired_filaments.end()) {
+                vortex_filaments[it->second].panels[1] = i;
+                
+                unpaired_filaments.erase(it);
+                
+            } else {
+                VortexFilament filament;
+                filament.nodes[0]  = node_a;
+                filament.nodes[1]  = node_b;
+                filament.panels[0] = i;
+                filament.panels[1] = -1;
+                
+                unpaired_filaments[make_pair(node_a, node_b)] = vortex_filaments.size();
+                
+                vortex_filaments.push_back(filament);
+            }
+        }
     }
+    
+    n_vortex_filament_panels = panel_nodes.size();
 }
 
 /**
@@ -178,6 +239,10 @@ Surface::compute_topology()
 void
 Surface::cut_panels(int panel_a, int panel_b)
 {
+    // Stop sharing the panel neighbor map with copies of this surface:
+    if (panel_neighbors.use_count() > 1)
+        panel_neighbors = make_shared<vector<vector<vector<pair<int, int> > > > >(*panel_neighbors);
+    
     for (int i = 0; i < 2; i++) {
         int panel_ids[2];
         if (i == 0) {
@@ -188,7 +253,7 @@ Surface::cut_panels(int panel_a, int panel_b)
             panel_ids[1] = panel_a;
         }
         
-        vector<vector<pair<int, int> > > &single_panel_neighbors = panel_neighbors[panel_ids[0]];
+        vector<vector<pair<int, int> > > &single_panel_neighbors = (*panel_neighbors)[panel_ids[0]];
         vector<vector<pair<int, int> > >::iterator it;
         for (it = single_panel_neighbors.begin(); it != single_panel_neighbors.end(); it++) {
             vector<pair<int, int> > &edge_neighbors = *it;
@@ -211,12 +276,16 @@ Surface::cut_panels(int panel_a, int panel_b)
 void
 Surface::compute_geometry(int panel)
 {
+    // Stop sharing the panel vertex points with copies of this surface:
+    if (panel_transformed_points.use_count() > 1)
+        panel_transformed_points = make_shared<vector<vector<Vector3d, Eigen::aligned_allocator<Vector3d> > > >(*panel_transformed_points);
+    
     // Resize arrays, if necessary:
     panel_normals.resize(n_panels());
     panel_collocation_points[0].resize(n_panels());
     panel_collocation_points[1].resize(n_panels());
     panel_coordinate_transformations.resize(n_panels());
-    panel_transformed_points.resize(n_panels());
+    panel_transformed_points->resize(n_panels());
     panel_surface_areas.resize(n_panels());
     
     // Get panel nodes:
@@ -272,7 +341,7 @@ Surface::compute_geometry(int panel)
     for (int j = 0; j < (int) single_panel_nodes.size(); j++)
         single_panel_transformed_points.push_back(transformation * nodes[single_panel_nodes[j]]);
         
-    panel_transformed_points[panel] = single_panel_transformed_points;
+    (*panel_transformed_points)[panel] = single_panel_transformed_points;
     
     // Surface area: 
     double surface_area = 0.0;
@@ -326,6 +395,173 @@ Surface::n_panels() const
     return panel_nodes.size();
 }
 
+/**
+   Appends the time-dependent state of this surface to a checkpoint:  the node positions, and the panel geometry.  The panel
+   topology is stored as well, so that a checkpoint cannot be restored into a surface built differently.
+   
+   The panel geometry is stored as is, rather than recomputed from the nodes on restart, since rigid body motion updates it 
+   incrementally.  This way, a restarted run reproduces the original run exactly.
+   
+   @param[in]   checkpoint   Checkpoint to append to.
+*/
+void
+Surface::save_state(CheckpointWriter &checkpoint) const
+{
+    checkpoint.write_int(n_nodes());
+    checkpoint.write_int(n_panels());
+    
+    for (int i = 0; i < n_panels(); i++) {
+        checkpoint.write_int(panel_nodes[i].size());
+        for (int j = 0; j < (int) panel_nodes[i].size(); j++)
+            checkpoint.write_int(panel_nodes[i][j]);
+    }
+    
+    checkpoint.write_points(nodes);
+    
+    checkpoint.write_points(panel_collocation_points[0]);
+    checkpoint.write_points(panel_collocation_points[1]);
+    checkpoint.write_points(panel_normals);
+    
+    for (int i = 0; i < n_panels(); i++) {
+        Matrix<double, 3, 4> affine = panel_coordinate_transformations[i].affine();
+        checkpoint.write_doubles(affine.data(), affine.size());
+    }
+    
+    checkpoint.write_doubles(panel_surface_areas.data(), panel_surface_areas.size());
+    
+    for (int i = 0; i < n_panels(); i++)
+        checkpoint.write_points((*panel_transformed_points)[i]);
+}
+
+/**
+   Restores the time-dependent state of this surface from a checkpoint written by save_state().  The stored topology is passed
+   to restore_topology(), which by default rejects a checkpoint of a surface with different topology.
+   
+   @param[in]   checkpoint   Checkpoint to read from.
+   
+   @returns true on success.
+*/
+bool
+Surface::load_state(CheckpointReader &checkpoint)
+{
+    int stored_n_nodes;
+    vector<vector<int> > stored_panel_nodes;
+    if (!read_topology(checkpoint, stored_n_nodes, stored_panel_nodes))
+        return false;
+        
+    if (!restore_topology(stored_n_nodes, stored_panel_nodes))
+        return false;
+    
+    checkpoint.read_points(nodes, n_nodes());
+    
+    checkpoint.read_points(panel_collocation_points[0], n_panels());
+    checkpoint.read_points(panel_collocation_points[1], n_panels());
+    checkpoint.read_points(panel_normals, n_panels());
+    
+    panel_coordinate_transformations.resize(n_panels());
+    for (int i = 0; i < n_panels(); i++) {
+        Matrix<double, 3, 4> affine;
+        checkpoint.read_doubles(affine.data(), affine.size());
+        
+        panel_coordinate_transformations[i].setIdentity();
+        panel_coordinate_transformations[i].affine() = affine;
+    }
+    
+    panel_surface_areas.resize(n_panels());
+    checkpoint.read_doubles(panel_surface_areas.data(), panel_surface_areas.size());
+    
+    // Keep sharing the panel vertex points with copies of this surface, unless they changed:
+    vector<vector<Vector3d, Eigen::aligned_allocator<Vector3d> > > transformed_points(n_panels());
+    for (int i = 0; i < n_panels(); i++)
+        checkpoint.read_points(transformed_points[i], panel_nodes[i].size());
+    
+    if (!checkpoint.valid()) {
+        cerr << "Surface " << id << ": Checkpoint is truncated." << endl;
+        
+        return false;
+    }
+    
+    if (transformed_points != *panel_transformed_points)
+        panel_transformed_points = make_shared<vector<vector<Vector3d, Eigen::aligned_allocator<Vector3d> > > >(transformed_points);
+    
+    return true;
+}
+
+/**
+   Reads the panel topology written by save_state().
+   
+   @param[in]   checkpoint           Checkpoint to read from.
+   @param[out]  stored_n_nodes       Number of nodes.
+   @param[out]  stored_panel_nodes   Panel number to node numbers map.
+   
+   @returns true on success.
+*/
+bool
+Surface::read_topology(CheckpointReader &checkpoint, int &stored_n_nodes, std::vector<std::vector<int> > &stored_panel_nodes) const
+{
+    stored_n_nodes      = checkpoint.read_int();
+    int stored_n_panels = checkpoint.read_int();
+    
+    if (!checkpoint.valid() || stored_n_nodes < 0 || stored_n_panels < 0) {
+        cerr << "Surface " << id << ": Checkpoint is truncated." << endl;
+        
+        return false;
+    }
+    
+    stored_panel_nodes.clear();
+    for (int i = 0; i < stored_n_panels && checkpoint.valid(); i++) {
+        int n_panel_nodes = checkpoint.read_int();
+        if (n_panel_nodes != 3 && n_panel_nodes != 4) {
+            cerr << "Surface " << id << ": Checkpoint contains an invalid panel." << endl;
+            
+            return false;
+        }
+        
+        vector<int> vertices;
+        for (int j = 0; j < n_panel_nodes; j++) {
+            int node = checkpoint.read_int();
+            if (node < 0 || node >= stored_n_nodes) {
+                cerr << "Surface " << id << ": Checkpoint contains an invalid panel." << endl;
+                
+                return false;
+            }
+            
+            vertices.push_back(node);
+        }
+        
+        stored_panel_nodes.push_back(vertices);
+    }
+    
+    if (!checkpoint.valid()) {
+        cerr << "Surface " << id << ": Checkpoint is truncated." << endl;
+        
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+   Checks the panel topology stored in a checkpoint against the topology of this surface.  The topology of a surface is created
+   when it is built, and is not restored from a checkpoint.
+   
+   @param[in]   stored_n_nodes       Number of nodes.
+   @param[in]   stored_panel_nodes   Panel number to node numbers map.
+   
+   @returns true if the topology matches.
+*/
+bool
+Surface::restore_topology(int stored_n_nodes, const std::vector<std::vector<int> > &stored_panel_nodes)
+{
+    if (stored_n_nodes != n_nodes() || stored_panel_nodes != panel_nodes) {
+        cerr << "Surface " << id << ": Checkpoint does not match the topology of the surface." << endl;
+        
+        return false;
+    }
+    
+    return true;
+}
+
 /**
    Rotates this surface.
    
@@ -443,20 +679,16 @@ Surface::panel_surface_area(int panel) const
     return panel_surface_areas[panel];
 }
 
-// Simultaneously compute influence of source and doublet panel edges on given point.
-static void
-source_and_doublet_edge_influence(const Vector3d &x, const Vector3d &node_a, const Vector3d &node_b, double *source_edge_influence, double *doublet_edge_influence)
+// Compute the terms shared by the influence and the velocity induced by a panel edge on a given point, in panel coordinates,
+// following Hess and Smith:  the edge length d, the angle delta_theta, and, if requested, the logarithmic term l.  Returns false 
+// if the edge is degenerate:
+static bool
+hess_smith_edge_terms(const Vector3d &x, const Vector3d &node_a, const Vector3d &node_b, double &d, double &delta_theta, double *l)
 {
-    double d = sqrt(pow(node_b(0) - node_a(0), 2) + pow(node_b(1) - node_a(1), 2));
+    d = sqrt(pow(node_b(0) - node_a(0), 2) + pow(node_b(1) - node_a(1), 2));
 
-    if (d < Parameters::zero_threshold) {
-        if (source_edge_influence != NULL)
-            *source_edge_influence = 0.0;
-        if (doublet_edge_influence != NULL)
-            *doublet_edge_influence = 0.0;
-            
-        return;
-    }
+    if (d < Parameters::zero_threshold)
+        return false;
         
     double z = x(2);
     
@@ -475,14 +707,33 @@ source_and_doublet_edge_influence(const Vector3d &x, const Vector3d &node_a, con
     double u = (m * e1 - h1) / (z * r1);
     double v = (m * e2 - h2) / (z * r2);
     
-    double delta_theta;
     if (u == v)
         delta_theta = 0.0;
     else
         delta_theta = atan2(u - v, 1 + u * v);
+        
+    if (l != NULL)
+        *l = log((r1 + r2 + d) / (r1 + r2 - d));
+        
+    return true;
+}
+
+// Simultaneously compute influence of source and doublet panel edges on given point.
+static void
+source_and_doublet_edge_influence(const Vector3d &x, const Vector3d &node_a, const Vector3d &node_b, double *source_edge_influence, double *doublet_edge_influence)
+{
+    double d, delta_theta, l;
+    if (!hess_smith_edge_terms(x, node_a, node_b, d, delta_theta, source_edge_influence != NULL ? &l : NULL)) {
+        if (source_edge_influence != NULL)
+            *source_edge_influence = 0.0;
+        if (doublet_edge_influence != NULL)
+            *doublet_edge_influence = 0.0;
+            
+        return;
+    }
     
     if (source_edge_influence != NULL)
-        *source_edge_influence  = ((x(0) - node_a(0)) * (node_b(1) - node_a(1)) - (x(1) - node_a(1)) * (node_b(0) - node_a(0))) / d * log((r1 + r2 + d) / (r1 + r2 - d)) - fabs(z) * delta_theta; 
+        *source_edge_influence  = ((x(0) - node_a(0)) * (node_b(1) - node_a(1)) - (x(1) - node_a(1)) * (node_b(0) - node_a(0))) / d * l - fabs(x(2)) * delta_theta; 
     if (doublet_edge_influence != NULL)
         *doublet_edge_influence = delta_theta;
 }
@@ -514,8 +765,8 @@ Surface::source_and_doublet_influence(const Eigen::Vector3d &x, int this_panel,
         else
             next_idx = i + 1;
             
-        const Vector3d &node_a = panel_transformed_points[this_panel][i];
-        const Vector3d &node_b = panel_transformed_points[this_panel][next_idx];
+        const Vector3d &node_a = (*panel_transformed_points)[this_panel][i];
+        const Vector3d &node_b = (*panel_transformed_points)[this_panel][next_idx];
         
         double source_edge_influence, doublet_edge_influence;
         
@@ -554,8 +805,8 @@ Surface::source_influence(const Eigen::Vector3d &x, int this_panel) const
         else
             next_idx = i + 1;
             
-        const Vector3d &node_a = panel_transformed_points[this_panel][i];
-        const Vector3d &node_b = panel_transformed_points[this_panel][next_idx];
+        const Vector3d &node_a = (*panel_transformed_points)[this_panel][i];
+        const Vector3d &node_b = (*panel_transformed_points)[this_panel][next_idx];
         
         double edge_influence;
         source_and_doublet_edge_influence(x_normalized, node_a, node_b, &edge_influence, NULL);
@@ -591,8 +842,8 @@ Surface::doublet_influence(const Eigen::Vector3d &x, int this_panel) const
         else
             next_idx = i + 1;
             
-        const Vector3d &node_a = panel_transformed_points[this_panel][i];
-        const Vector3d &node_b = panel_transformed_points[this_panel][next_idx];
+        const Vector3d &node_a = (*panel_transformed_points)[this_panel][i];
+        const Vector3d &node_b = (*panel_transformed_points)[this_panel][next_idx];
         
         double edge_influence;
         source_and_doublet_edge_influence(x_normalized, node_a, node_b, NULL, &edge_influence);
@@ -607,38 +858,12 @@ Surface::doublet_influence(const Eigen::Vector3d &x, int this_panel) const
 static Vector3d
 source_edge_unit_velocity(const Vector3d &x, const Vector3d &node_a, const Vector3d &node_b)
 {   
-    double d = sqrt(pow(node_b(0) - node_a(0), 2) + pow(node_b(1) - node_a(1), 2));
-    
-    if (d < Parameters::zero_threshold)
+    double d, delta_theta, l;
+    if (!hess_smith_edge_terms(x, node_a, node_b, d, delta_theta, &l))
         return Vector3d(0, 0, 0);
-        
-    double z = x(2);
-    
-    double m = (node_b(1) - node_a(1)) / (node_b(0) - node_a(0));
     
-    double e1 = pow(x(0) - node_a(0), 2) + pow(z, 2);
-    double e2 = pow(x(0) - node_b(0), 2) + pow(z, 2);
-    
-    double r1 = sqrt(e1 + pow(x(1) - node_a(1), 2));
-    double r2 = sqrt(e2 + pow(x(1) - node_b(1), 2));
-    
-    double h1 = (x(0) - node_a(0)) * (x(1) - node_a(1));
-    double h2 = (x(0) - node_b(0)) * (x(1) - node_b(1));
-    
-    // IEEE-754 floating point division by zero results in +/- inf, and atan(inf) = pi / 2.
-    double u = (m * e1 - h1) / (z * r1);
-    double v = (m * e2 - h2) / (z * r2);
-    
-    double delta_theta;
-    if (u == v)
-        delta_theta = 0.0;
-    else
-        delta_theta = atan2(u - v, 1 + u * v);
-        
-    double l = log((r1 + r2 - d) / (r1 + r2 + d));
-    
-    return Vector3d((node_b(1) - node_a(1)) / d * l,
-                    (node_a(0) - node_b(0)) / d * l,
+    return Vector3d(-(node_b(1) - node_a(1)) / d * l,
+                    -(node_a(0) - node_b(0)) / d * l,
                     delta_theta);
 }
 
@@ -667,8 +892,8 @@ Surface::source_unit_velocity(const Eigen::Vector3d &x, int this_panel) const
         else
             next_idx = i + 1;
             
-        const Vector3d &node_a = panel_transformed_points[this_panel][i];
-        const Vector3d &node_b = panel_transformed_points[this_panel][next_idx];
+        const Vector3d &node_a = (*panel_transformed_points)[this_panel][i];
+        const Vector3d &node_b = (*panel_transformed_points)[this_panel][next_idx];
         
         velocity += source_edge_unit_velocity(x_normalized, node_a, node_b);
     }   
@@ -680,6 +905,80 @@ Surface::source_unit_velocity(const Eigen::Vector3d &x, int this_panel) const
     return one_over_4pi * velocity;
 }
 
+// Simultaneously compute influence and velocity of source and doublet panel edges on given point, from a single evaluation
+// of the edge geometry:
+static void
+source_and_doublet_edge_influence_and_velocity(const Vector3d &x, const Vector3d &node_a, const Vector3d &node_b,
+                                               double &source_edge_influence, double &doublet_edge_influence, Vector3d &source_edge_velocity)
+{
+    double d, delta_theta, l;
+    if (!hess_smith_edge_terms(x, node_a, node_b, d, delta_theta, &l)) {
+        source_edge_influence  = 0.0;
+        doublet_edge_influence = 0.0;
+        source_edge_velocity   = Vector3d(0, 0, 0);
+            
+        return;
+    }
+    
+    source_edge_influence  = ((x(0) - node_a(0)) * (node_b(1) - node_a(1)) - (x(1) - node_a(1)) * (node_b(0) - node_a(0))) / d * l - fabs(x(2)) * delta_theta;
+    doublet_edge_influence = delta_theta;
+    
+    source_edge_velocity = Vector3d(-(node_b(1) - node_a(1)) / d * l,
+                                    -(node_a(0) - node_b(0)) / d * l,
+                                    delta_theta);
+}
+
+/**
+   Simultaneously computes the potential influences induced by source and doublet panels of unit strength, and the velocity
+   induced by a source panel of unit strength.  The edge geometry is evaluated only once.
+   
+   @param[in]   x                   Point at which the influences and the velocity are evaluated.
+   @param[in]   this_panel          Panel on which the source and doublet panels are located.
+   @param[out]  source_influence    Source influence value.
+   @param[out]  doublet_influence   Doublet influence value.
+   @param[out]  source_velocity     Velocity induced by the source panel.
+*/
+void
+Surface::source_and_doublet_influence_and_velocity(const Eigen::Vector3d &x, int this_panel, double &source_influence, double &doublet_influence,
+                                                   Eigen::Vector3d &source_velocity) const
+{
+    // Transform such that panel normal becomes unit Z vector:    
+    const Transform<double, 3, Affine> &transformation = panel_coordinate_transformation(this_panel);
+    
+    Vector3d x_normalized = transformation * x;
+    
+    // Compute influence coefficients and velocity according to Hess:
+    source_influence  = 0.0;
+    doublet_influence = 0.0;
+    source_velocity   = Vector3d(0, 0, 0);
+    
+    for (int i = 0; i < (int) panel_nodes[this_panel].size(); i++) {
+        int next_idx;
+        if (i == (int) panel_nodes[this_panel].size() - 1)
+            next_idx = 0;
+        else
+            next_idx = i + 1;
+            
+        const Vector3d &node_a = (*panel_transformed_points)[this_panel][i];
+        const Vector3d &node_b = (*panel_transformed_points)[this_panel][next_idx];
+        
+        double source_edge_influence, doublet_edge_influence;
+        Vector3d source_edge_velocity;
+        
+        source_and_doublet_edge_influence_and_velocity(x_normalized, node_a, node_b, source_edge_influence, doublet_edge_influence, source_edge_velocity);
+        
+        source_influence  += source_edge_influence;
+        doublet_influence += doublet_edge_influence;
+        source_velocity   += source_edge_velocity;
+    }   
+    
+    source_influence  *= -one_over_4pi;
+    doublet_influence *=  one_over_4pi;
+    
+    // Transform back:
+    source_velocity = one_over_4pi * (transformation.linear().transpose() * source_velocity);
+}
+
 /**
    Computes the velocity induced by a vortex ring of unit strength.
    
@@ -691,37 +990,166 @@ Surface::source_unit_velocity(const Eigen::Vector3d &x, int this_panel) const
 Vector3d
 Surface::vortex_ring_unit_velocity(const Eigen::Vector3d &x, int this_panel) const
 {    
-    Vector3d velocity(0, 0, 0);
+    return compute_vortex_ring_unit_velocity(FreeVortexCore(), x, this_panel);
+}
+
+/**
+   Computes the velocities induced by the vortex sheet formed by the vortex rings of this surface, for a batch of points.
+   
+   @param[in]   points                 Points at which the velocity is evaluated, one per column.
+   @param[in]   doublet_coefficients   Strengths of the vortex rings.  Panels beyond the length of this vector have zero strength.
+   @param[out]  velocities             Velocities induced by the vortex sheet, one per column.
+*/
+void
+Surface::vortex_sheet_velocities(const Eigen::Ref<const Eigen::Matrix3Xd> &points, const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients,
+                                 Eigen::Ref<Eigen::Matrix3Xd> velocities) const
+{
+    compute_vortex_sheet_velocities(FreeVortexCore(), points, doublet_coefficients, velocities);
+}
+
+/**
+   Computes the velocity induced by the vortex sheet formed by the vortex rings of this surface.
+   
+   @param[in]   x                      Point at which the velocity is evaluated.
+   @param[in]   doublet_coefficients   Strengths of the vortex rings.  Panels beyond the length of this vector have zero strength.
+   
+   @returns Velocity induced by the vortex sheet.
+*/
+Vector3d
+Surface::vortex_sheet_velocity(const Eigen::Vector3d &x, const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients) const
+{
+    Vector3d velocity;
+    vortex_sheet_velocities(x, doublet_coefficients, velocity);
     
-    for (int i = 0; i < (int) panel_nodes[this_panel].size(); i++) {
-        int previous_idx;
-        if (i == 0)
-            previous_idx = panel_nodes[this_panel].size() - 1;
-        else
-            previous_idx = i - 1;
+    return velocity;
+}
+
+/**
+   Computes the velocities induced by all source and doublet panels of this surface, for a batch of points.  The doublet panels
+   are evaluated as a vortex sheet.
+   
+   @param[in]   points                 Points at which the velocity is evaluated, one per column.
+   @param[in]   source_coefficients    Strengths of the source panels.  Panels beyond the length of this vector have zero strength.
+   @param[in]   doublet_coefficients   Strengths of the doublet panels.  Panels beyond the length of this vector have zero strength.
+   @param[out]  velocities             Induced velocities, one per column.
+*/
+void
+Surface::induced_velocities(const Eigen::Ref<const Eigen::Matrix3Xd> &points, const Eigen::Ref<const Eigen::VectorXd> &source_coefficients,
+                            const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients, Eigen::Ref<Eigen::Matrix3Xd> velocities) const
+{
+    vortex_sheet_velocities(points, doublet_coefficients, velocities);
+    
+    for (int i = 0; i < source_coefficients.size(); i++) {
+        if (source_coefficients(i) == 0.0)
+            continue;
             
-        const Vector3d &node_a = nodes[panel_nodes[this_panel][previous_idx]];
-        const Vector3d &node_b = nodes[panel_nodes[this_panel][i]];
-        
-        Vector3d r_0 = node_b - node_a;
-        Vector3d r_1 = node_a - x;
-        Vector3d r_2 = node_b - x;
-        
-        double r_1_norm = r_1.norm();
-        double r_2_norm = r_2.norm();
-        
-        Vector3d r_1xr_2 = r_1.cross(r_2);
-        double r_1xr_2_sqnorm = r_1xr_2.squaredNorm();
+        for (int k = 0; k < points.cols(); k++)
+            velocities.col(k) += source_unit_velocity(points.col(k), i) * source_coefficients(i);
+    }
+}
+
+/**
+   Computes the velocity potentials induced by all source and doublet panels of this surface, for a batch of points.
+   
+   @param[in]   points                 Points at which the velocity potential is evaluated, one per column.
+   @param[in]   source_coefficients    Strengths of the source panels.  Panels beyond the length of this vector have zero strength.
+   @param[in]   doublet_coefficients   Strengths of the doublet panels.  Panels beyond the length of this vector have zero strength.
+   @param[out]  potentials             Induced velocity potentials.
+*/
+void
+Surface::induced_velocity_potentials(const Eigen::Ref<const Eigen::Matrix3Xd> &points, const Eigen::Ref<const Eigen::VectorXd> &source_coefficients,
+                                     const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients, Eigen::Ref<Eigen::VectorXd> potentials) const
+{
+    potentials.setZero();
+    
+    int n = max(source_coefficients.size(), doublet_coefficients.size());
+    for (int i = 0; i < n; i++) {
+        double source_coefficient  = (i < source_coefficients.size())  ? source_coefficients(i)  : 0.0;
+        double doublet_coefficient = (i < doublet_coefficients.size()) ? doublet_coefficients(i) : 0.0;
         
-        if (r_1_norm < Parameters::zero_threshold ||
-            r_2_norm < Parameters::zero_threshold ||
-            r_1xr_2_sqnorm < Parameters::zero_threshold)
-            continue;
+        if (source_coefficient == 0.0) {
+            if (doublet_coefficient == 0.0)
+                continue;
+                
+            for (int k = 0; k < points.cols(); k++)
+                potentials(k) += doublet_influence(points.col(k), i) * doublet_coefficient;
+                
+        } else {
+            for (int k = 0; k < points.cols(); k++) {
+                double source_influence, doublet_influence;
+                source_and_doublet_influence(points.col(k), i, source_influence, doublet_influence);
+                
+                potentials(k) += doublet_influence * doublet_coefficient + source_influence * source_coefficient;
+            }
+        }
+    }
+}
 
-        velocity += r_1xr_2 / r_1xr_2_sqnorm * r_0.dot(r_1 / r_1_norm - r_2 / r_2_norm);
+/**
+   Simultaneously computes the velocities and the velocity potentials induced by all source and doublet panels of this surface,
+   for a batch of points.  The edge geometry of the source panels is evaluated only once for both quantities.
+   
+   @param[in]   points                 Points at which the velocity and the velocity potential are evaluated, one per column.
+   @param[in]   source_coefficients    Strengths of the source panels.  Panels beyond the length of this vector have zero strength.
+   @param[in]   doublet_coefficients   Strengths of the doublet panels.  Panels beyond the length of this vector have zero strength.
+   @param[out]  velocities             Induced velocities, one per column.
+   @param[out]  potentials             Induced velocity potentials.
+*/
+void
+Surface::induced_velocities_and_potentials(const Eigen::Ref<const Eigen::Matrix3Xd> &points, const Eigen::Ref<const Eigen::VectorXd> &source_coefficients,
+                                           const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients, Eigen::Ref<Eigen::Matrix3Xd> velocities,
+                                           Eigen::Ref<Eigen::VectorXd> potentials) const
+{
+    vortex_sheet_velocities(points, doublet_coefficients, velocities);
+    
+    potentials.setZero();
+    
+    int n = max(source_coefficients.size(), doublet_coefficients.size());
+    for (int i = 0; i < n; i++) {
+        double source_coefficient  = (i < source_coefficients.size())  ? source_coefficients(i)  : 0.0;
+        double doublet_coefficient = (i < doublet_coefficients.size()) ? doublet_coefficients(i) : 0.0;
+        
+        if (source_coefficient == 0.0) {
+            if (doublet_coefficient == 0.0)
+                continue;
+                
+            for (int k = 0; k < points.cols(); k++)
+                potentials(k) += doublet_influence(points.col(k), i) * doublet_coefficient;
+                
+        } else {
+            for (int k = 0; k < points.cols(); k++) {
+                double source_influence, doublet_influence;
+                Vector3d source_velocity;
+                source_and_doublet_influence_and_velocity(points.col(k), i, source_influence, doublet_influence, source_velocity);
+                
+                potentials(k) += doublet_influence * doublet_coefficient + source_influence * source_coefficient;
+                
+                velocities.col(k) += source_velocity * source_coefficient;
+            }
+        }
     }
+}
 
-    return one_over_4pi * velocity;
+/**
+   Computes the net circulation of a vortex filament.
+   
+   @param[in]   filament               Vortex filament.
+   @param[in]   doublet_coefficients   Strengths of the vortex rings.  Panels beyond the length of this vector have zero strength.
+   
+   @returns Net circulation.
+*/
+double
+Surface::vortex_filament_strength(const VortexFilament &filament, const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients) const
+{
+    double strength = 0.0;
+    
+    if (filament.panels[0] < doublet_coefficients.size())
+        strength += doublet_coefficients(filament.panels[0]);
+        
+    if (filament.panels[1] >= 0 && filament.panels[1] < doublet_coefficients.size())
+        strength -= doublet_coefficients(filament.panels[1]);
+        
+    return strength;
 }
 
 /**
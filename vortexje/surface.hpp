@@ -19,6 +19,8 @@
 #include <Eigen/StdVector>
 
 #include <vortexje/parameters.hpp>
+#include <vortexje/vortex-core-models.hpp>
+#include <vortexje/checkpoint.hpp>
 
 namespace Vortexje
 {
@@ -27,6 +29,11 @@ namespace Vortexje
    Surface representation using node-panel, panel-node, and panel-panel data structures.
    Implements geometrical and singularity panel influence operations.
    
+   The panel-panel neighbor map and the panel vertices in panel coordinates are invariant under rigid transformations.
+   Copies of a surface share these with the original, until either of them is modified.  Surfaces which are identical
+   up to a rigid transformation, such as the blades of a rotor, should therefore be created by building a single
+   template surface, and by transforming copies of it into place.
+   
    @brief Surface representation.
 */
 class Surface
@@ -48,6 +55,8 @@ public:
     
     void compute_topology();
     
+    void compute_vortex_filaments();
+    
     void compute_geometry(int panel);
     void compute_geometry();
     
@@ -55,6 +64,9 @@ public:
     
     int n_nodes() const;
     int n_panels() const;
+    
+    virtual void save_state(CheckpointWriter &checkpoint) const;
+    virtual bool load_state(CheckpointReader &checkpoint);
 
     /**
        Node number to point map.
@@ -82,13 +94,17 @@ public:
        
        By including a vector of (neighboring panel number, edge number) pairs for every (panel, edge) pair,
        an edge of a large panel may border several edges of smaller panels.
+       
+       This map is shared between copies of the surface.
     */
-    std::vector<std::vector<std::vector<std::pair<int, int> > > > panel_neighbors;
+    std::shared_ptr<std::vector<std::vector<std::vector<std::pair<int, int> > > > > panel_neighbors;
     
     /**
        Panel number to comprising vertex points (in the panel coordinate system) map.
+       
+       This map is shared between copies of the surface.
     */
-    std::vector<std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > > panel_transformed_points;
+    std::shared_ptr<std::vector<std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > > > panel_transformed_points;
     
     void rotate(const Eigen::Vector3d &axis, double angle);
     virtual void transform(const Eigen::Matrix3d &transformation);
@@ -109,8 +125,27 @@ public:
     double doublet_influence(const Eigen::Vector3d &x, int this_panel) const;
     
     virtual Eigen::Vector3d source_unit_velocity(const Eigen::Vector3d &x, int this_panel) const;
+    
+    virtual void source_and_doublet_influence_and_velocity(const Eigen::Vector3d &x, int this_panel, double &source_influence, double &doublet_influence,
+                                                           Eigen::Vector3d &source_velocity) const;
+    
     virtual Eigen::Vector3d vortex_ring_unit_velocity(const Eigen::Vector3d &x, int this_panel) const;
     
+    virtual void vortex_sheet_velocities(const Eigen::Ref<const Eigen::Matrix3Xd> &points, const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients,
+                                         Eigen::Ref<Eigen::Matrix3Xd> velocities) const;
+    
+    Eigen::Vector3d vortex_sheet_velocity(const Eigen::Vector3d &x, const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients) const;
+    
+    virtual void induced_velocities(const Eigen::Ref<const Eigen::Matrix3Xd> &points, const Eigen::Ref<const Eigen::VectorXd> &source_coefficients,
+                                    const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients, Eigen::Ref<Eigen::Matrix3Xd> velocities) const;
+                                    
+    virtual void induced_velocity_potentials(const Eigen::Ref<const Eigen::Matrix3Xd> &points, const Eigen::Ref<const Eigen::VectorXd> &source_coefficients,
+                                             const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients, Eigen::Ref<Eigen::VectorXd> potentials) const;
+                                             
+    virtual void induced_velocities_and_potentials(const Eigen::Ref<const Eigen::Matrix3Xd> &points, const Eigen::Ref<const Eigen::VectorXd> &source_coefficients,
+                                                   const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients, Eigen::Ref<Eigen::Matrix3Xd> velocities,
+                                                   Eigen::Ref<Eigen::VectorXd> potentials) const;
+    
     double doublet_influence(const std::shared_ptr<Surface> &other, int other_panel, int this_panel) const;
     double source_influence(const std::shared_ptr<Surface> &other, int other_panel, int this_panel) const;
     
@@ -139,8 +174,140 @@ protected:
        Panel number to surface area map.
     */
     std::vector<double> panel_surface_areas;
+    
+    /**
+       Vortex filament, i.e., a panel edge together with the vortex rings that share it.
+       
+       @brief Vortex filament.
+    */
+    class VortexFilament
+    {
+    public:
+        /**
+           Start and end node numbers.
+        */
+        int nodes[2];
+        
+        /**
+           Panel which traverses the filament from the start to the end node, and panel which traverses it in the
+           opposite direction.  The latter is -1 if the filament lies on the boundary of the surface.
+        */
+        int panels[2];
+    };
+    
+    /**
+       Unique vortex filaments of the vortex ring lattice.
+    */
+    std::vector<VortexFilament> vortex_filaments;
+    
+    /**
+       Number of panels at the time the vortex filaments were computed.
+    */
+    int n_vortex_filament_panels;
+    
+    double vortex_filament_strength(const VortexFilament &filament, const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients) const;
+    
+    bool read_topology(CheckpointReader &checkpoint, int &stored_n_nodes, std::vector<std::vector<int> > &stored_panel_nodes) const;
+    
+    virtual bool restore_topology(int stored_n_nodes, const std::vector<std::vector<int> > &stored_panel_nodes);
+    
+    template <class CoreModel>
+    Eigen::Vector3d compute_vortex_ring_unit_velocity(const CoreModel &core_model, const Eigen::Vector3d &x, int this_panel) const;
+    
+    template <class CoreModel>
+    void compute_vortex_sheet_velocities(const CoreModel &core_model, const Eigen::Ref<const Eigen::Matrix3Xd> &points,
+                                         const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients, Eigen::Ref<Eigen::Matrix3Xd> velocities) const;
 };
 
+/**
+   Computes the velocity induced by a vortex ring of unit strength, for a given vortex core model.
+   
+   @param[in]   core_model   Vortex core model.
+   @param[in]   x            Point at which the velocity is evaluated.
+   @param[in]   this_panel   Panel on which the vortex ring is located.
+   
+   @returns Velocity induced by the vortex ring.
+*/
+template <class CoreModel>
+Eigen::Vector3d
+Surface::compute_vortex_ring_unit_velocity(const CoreModel &core_model, const Eigen::Vector3d &x, int this_panel) const
+{
+    const double one_over_4pi = 1.0 / (4 * 3.141592653589793238462643383279502884);
+    
+    Eigen::Vector3d velocity(0, 0, 0);
+    
+    for (int i = 0; i < (int) panel_nodes[this_panel].size(); i++) {
+        int previous_idx;
+        if (i == 0)
+            previous_idx = panel_nodes[this_panel].size() - 1;
+        else
+            previous_idx = i - 1;
+            
+        velocity += vortex_filament_velocity(x, nodes[panel_nodes[this_panel][previous_idx]], nodes[panel_nodes[this_panel][i]], core_model);
+    }
+    
+    return one_over_4pi * velocity;
+}
+
+/**
+   Computes the velocities induced by the vortex sheet formed by the vortex rings of this surface, for a given vortex core
+   model.  Every unique vortex filament is evaluated once, with the net circulation of the adjacent vortex rings, for all points
+   in the batch.
+   
+   @param[in]   core_model             Vortex core model.
+   @param[in]   points                 Points at which the velocity is evaluated, one per column.
+   @param[in]   doublet_coefficients   Strengths of the vortex rings.  Panels beyond the length of this vector have zero strength.
+   @param[out]  velocities             Velocities induced by the vortex sheet, one per column.
+*/
+template <class CoreModel>
+void
+Surface::compute_vortex_sheet_velocities(const CoreModel &core_model, const Eigen::Ref<const Eigen::Matrix3Xd> &points,
+                                         const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients, Eigen::Ref<Eigen::Matrix3Xd> velocities) const
+{
+    const double one_over_4pi = 1.0 / (4 * 3.141592653589793238462643383279502884);
+    
+    velocities.setZero();
+    
+    if (n_vortex_filament_panels != n_panels()) {
+        // Evaluate the vortex rings individually, if panels were added after the filaments were computed:
+        for (int i = 0; i < doublet_coefficients.size(); i++) {
+            if (doublet_coefficients(i) == 0.0)
+                continue;
+                
+            for (int j = 0; j < (int) panel_nodes[i].size(); j++) {
+                int previous_j;
+                if (j == 0)
+                    previous_j = panel_nodes[i].size() - 1;
+                else
+                    previous_j = j - 1;
+                    
+                const Eigen::Vector3d &node_a = nodes[panel_nodes[i][previous_j]];
+                const Eigen::Vector3d &node_b = nodes[panel_nodes[i][j]];
+                
+                for (int k = 0; k < points.cols(); k++)
+                    velocities.col(k) += vortex_filament_velocity(points.col(k), node_a, node_b, core_model) * doublet_coefficients(i);
+            }
+        }
+        
+    } else {
+        for (int i = 0; i < (int) vortex_filaments.size(); i++) {
+            const VortexFilament &filament = vortex_filaments[i];
+            
+            double strength = vortex_filament_strength(filament, doublet_coefficients);
+            if (strength == 0.0)
+                continue;
+                
+            const Eigen::Vector3d &node_a = nodes[filament.nodes[0]];
+            const Eigen::Vector3d &node_b = nodes[filament.nodes[1]];
+            
+            for (int k = 0; k < points.cols(); k++)
+                velocities.col(k) += vortex_filament_velocity(points.col(k), node_a, node_b, core_model) * strength;
+        }
+    }
+    
+    velocities *= one_over_4pi;
+}
+
 };
 
 #endif // __SURFACE_HPP__
@@ -0,0 +1,22 @@
+//
+// Vortexje -- Vortex core models.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <vortexje/vortex-core-models.hpp>
+#include <vortexje/empirical-wakes/ramasamy-leishman-wake.hpp>
+
+using namespace Vortexje;
+
+/**
+   Constructs a Lamb-Oseen vortex core.
+   
+   @param[in]   core_radius   Vortex core radius.
+*/
+LambOseenVortexCore::LambOseenVortexCore(double core_radius) :
+    alpha_over_core_radius_squared(RamasamyLeishmanWake::Parameters::lambs_constant / (core_radius * core_radius))
+{
+}
@@ -0,0 +1,217 @@
+//
+// Vortexje -- Vortex core models.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __VORTEX_CORE_MODELS_HPP__
+#define __VORTEX_CORE_MODELS_HPP__
+
+#include <cmath>
+
+#include <Eigen/Core>
+
+#include <vortexje/parameters.hpp>
+
+namespace Vortexje
+{
+
+/**
+   Free vortex filament, without a core.
+   
+   A vortex core model is a policy class, which maps the squared distance from a vortex filament to the factor by which the
+   velocity induced by a free vortex filament is scaled.  Core models are passed to the templated Biot-Savart kernels, such as
+   vortex_filament_velocity(), by value, so that the kernels can be fully inlined.
+   
+   @brief Free vortex filament.
+*/
+class FreeVortexCore
+{
+public:
+    /**
+       Computes the velocity scaling factor.
+       
+       @param[in]   distance_squared   Squared distance from the vortex filament.
+       
+       @returns Velocity scaling factor.
+    */
+    double operator()(double distance_squared) const
+    {
+        return 1.0;
+    }
+};
+
+/**
+   Rankine vortex core, i.e., solid body rotation inside the core radius.
+   
+   @brief Rankine vortex core.
+*/
+class RankineVortexCore
+{
+public:
+    /**
+       Constructs a Rankine vortex core.
+       
+       @param[in]   core_radius   Vortex core radius.
+    */
+    RankineVortexCore(double core_radius) : one_over_core_radius_squared(1.0 / (core_radius * core_radius)) {}
+    
+    /**
+       Computes the velocity scaling factor.
+       
+       @param[in]   distance_squared   Squared distance from the vortex filament.
+       
+       @returns Velocity scaling factor.
+    */
+    double operator()(double distance_squared) const
+    {
+        return fmin(distance_squared * one_over_core_radius_squared, 1.0);
+    }
+    
+private:
+    double one_over_core_radius_squared;
+};
+
+/**
+   Lamb-Oseen vortex core.  The core radius is the radius of maximum swirl velocity.  Lamb's constant is shared with the
+   Ramasamy-Leishman wake, as RamasamyLeishmanWake::Parameters::lambs_constant.
+   
+   @brief Lamb-Oseen vortex core.
+*/
+class LambOseenVortexCore
+{
+public:
+    LambOseenVortexCore(double core_radius);
+    
+    /**
+       Computes the velocity scaling factor.
+       
+       @param[in]   distance_squared   Squared distance from the vortex filament.
+       
+       @returns Velocity scaling factor.
+    */
+    double operator()(double distance_squared) const
+    {
+        return 1.0 - exp(-distance_squared * alpha_over_core_radius_squared);
+    }
+    
+private:
+    double alpha_over_core_radius_squared;
+};
+
+/**
+   Vatistas vortex core, with shape parameter n = 2.  The core radius is the radius of maximum swirl velocity.
+   
+   @brief Vatistas vortex core.
+   
+   @note See G. H. Vatistas, V. Kozel, and W. C. Mih, A Simpler Model for Concentrated Vortices, Experiments in Fluids 11, 1991.
+*/
+class VatistasVortexCore
+{
+public:
+    /**
+       Constructs a Vatistas vortex core.
+       
+       @param[in]   core_radius   Vortex core radius.
+    */
+    VatistasVortexCore(double core_radius) : core_radius_4(pow(core_radius, 4)) {}
+    
+    /**
+       Computes the velocity scaling factor.
+       
+       @param[in]   distance_squared   Squared distance from the vortex filament.
+       
+       @returns Velocity scaling factor.
+    */
+    double operator()(double distance_squared) const
+    {
+        return distance_squared / sqrt(core_radius_4 + distance_squared * distance_squared);
+    }
+    
+private:
+    double core_radius_4;
+};
+
+/**
+   Ramasamy-Leishman vortex core, given the series coefficients interpolated for the vortex Reynolds number.
+   
+   @brief Ramasamy-Leishman vortex core.
+   
+   @note See M. Ramasamy and J. G. Leishman, Reynolds Number Based Blade Tip Vortex Model, University of Maryland, 2005.
+*/
+class RamasamyLeishmanVortexCore
+{
+public:
+    /**
+       Constructs a Ramasamy-Leishman vortex core.
+       
+       @param[in]   a                              Series coefficients a_1, a_2, a_3.
+       @param[in]   b                              Series coefficients b_1, b_2, b_3.
+       @param[in]   one_over_core_radius_squared   Inverse squared vortex core radius.
+    */
+    RamasamyLeishmanVortexCore(const double *a, const double *b, double one_over_core_radius_squared) :
+        a(a), b(b), one_over_core_radius_squared(one_over_core_radius_squared) {}
+    
+    /**
+       Computes the velocity scaling factor.
+       
+       @param[in]   distance_squared   Squared distance from the vortex filament.
+       
+       @returns Velocity scaling factor.
+    */
+    double operator()(double distance_squared) const
+    {
+        double dr = distance_squared * one_over_core_radius_squared;
+        
+        double sum = 0;
+        for (int j = 0; j < 3; j++)
+            sum += a[j] * exp(-b[j] * dr);
+        
+        return 1 - sum;
+    }
+    
+private:
+    const double *a;
+    const double *b;
+    double one_over_core_radius_squared;
+};
+
+/**
+   Computes the velocity induced by a vortex filament of unit strength, multiplied by 4 pi.
+   
+   @param[in]   x            Point at which the velocity is evaluated.
+   @param[in]   node_a       Start point of the filament.
+   @param[in]   node_b       End point of the filament.
+   @param[in]   core_model   Vortex core model.
+   
+   @returns Velocity induced by the vortex filament, multiplied by 4 pi.
+*/
+template <class CoreModel>
+inline Eigen::Vector3d
+vortex_filament_velocity(const Eigen::Vector3d &x, const Eigen::Vector3d &node_a, const Eigen::Vector3d &node_b, const CoreModel &core_model)
+{
+    Eigen::Vector3d r_0 = node_b - node_a;
+    Eigen::Vector3d r_1 = node_a - x;
+    Eigen::Vector3d r_2 = node_b - x;
+    
+    double r_0_sqnorm = r_0.squaredNorm();
+    double r_1_norm = r_1.norm();
+    double r_2_norm = r_2.norm();
+    
+    Eigen::Vector3d r_1xr_2 = r_1.cross(r_2);
+    double r_1xr_2_sqnorm = r_1xr_2.squaredNorm();
+    
+    if (r_0_sqnorm < Parameters::zero_threshold * Parameters::zero_threshold ||
+        r_1_norm < Parameters::zero_threshold ||
+        r_2_norm < Parameters::zero_threshold ||
+        r_1xr_2_sqnorm < Parameters::zero_threshold)
+        return Eigen::Vector3d(0, 0, 0);
+    
+    return core_model(r_1xr_2_sqnorm / r_0_sqnorm) * r_1xr_2 / r_1xr_2_sqnorm * r_0.dot(r_1 / r_1_norm - r_2 / r_2_norm);
+}
+
+};
+
+#endif // __VORTEX_CORE_MODELS_HPP__
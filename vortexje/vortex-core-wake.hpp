@@ -0,0 +1,79 @@
+//
+// Vortexje -- Wake with a vortex core model.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __VORTEX_CORE_WAKE_HPP__
+#define __VORTEX_CORE_WAKE_HPP__
+
+#include <vortexje/wake.hpp>
+#include <vortexje/vortex-core-models.hpp>
+
+namespace Vortexje
+{
+
+/**
+   Representation of a wake, of which the vortex filaments have the core given by the CoreModel policy class.  The core radius
+   is Parameters::wake_vortex_core_radius.
+   
+   The core model is resolved at compile time, so that the Biot-Savart loops over the vortex filaments of the wake are fully 
+   inlined.
+   
+   @brief Wake representation with a vortex core model.
+*/
+template <class CoreModel>
+class VortexCoreWake : public Wake
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    
+    /**
+       Constructs an empty wake.
+       
+       @param[in]   lifting_surface   Associated lifting surface.
+    */
+    VortexCoreWake(std::shared_ptr<LiftingSurface> lifting_surface) : Wake(lifting_surface) {}
+    
+    /**
+       Computes the velocity induced by a vortex ring of unit strength.
+       
+       @param[in]   x            Point at which the velocity is evaluated.
+       @param[in]   this_panel   Panel on which the vortex ring is located.
+       
+       @returns Velocity induced by the vortex ring.
+    */
+    Eigen::Vector3d vortex_ring_unit_velocity(const Eigen::Vector3d &x, int this_panel) const
+    {
+        return compute_vortex_ring_unit_velocity(CoreModel(Parameters::wake_vortex_core_radius), x, this_panel);
+    }
+    
+    /**
+       Computes the velocities induced by the vortex sheet formed by the vortex rings of this wake, for a batch of points.
+       
+       @param[in]   points                 Points at which the velocity is evaluated, one per column.
+       @param[in]   doublet_coefficients   Strengths of the vortex rings.  Panels beyond the length of this vector have zero strength.
+       @param[out]  velocities             Velocities induced by the vortex sheet, one per column.
+    */
+    void vortex_sheet_velocities(const Eigen::Ref<const Eigen::Matrix3Xd> &points, const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients,
+                                 Eigen::Ref<Eigen::Matrix3Xd> velocities) const
+    {
+        compute_vortex_sheet_velocities(CoreModel(Parameters::wake_vortex_core_radius), points, doublet_coefficients, velocities);
+    }
+};
+
+/**
+   Wake with Lamb-Oseen vortex cores.
+*/
+typedef VortexCoreWake<LambOseenVortexCore> LambOseenWake;
+
+/**
+   Wake with Vatistas vortex cores.
+*/
+typedef VortexCoreWake<VatistasVortexCore> VatistasWake;
+
+};
+
+#endif // __VORTEX_CORE_WAKE_HPP__
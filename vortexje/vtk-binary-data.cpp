@@ -0,0 +1,190 @@
+//
+// Vortexje -- Binary data for VTK output files.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <algorithm>
+#include <iostream>
+
+#ifdef VORTEXJE_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <vortexje/vtk-binary-data.hpp>
+
+using namespace std;
+using namespace Vortexje;
+
+// Size of the blocks in which appended data arrays are compressed:
+static const size_t compression_block_size = 32768;
+
+/**
+   Appends text, such as a section header.
+   
+   @param[in]   text   Text to append.
+*/
+void
+VTKLegacyBinaryData::append(const std::string &text)
+{
+    buffer.insert(buffer.end(), text.begin(), text.end());
+}
+
+/**
+   Writes the accumulated data to a file.
+   
+   @param[in]   f   Destination file stream.
+   
+   @returns true on success.
+*/
+bool
+VTKLegacyBinaryData::write(std::ofstream &f) const
+{
+    f.write(buffer.data(), buffer.size());
+    
+    return f.good();
+}
+
+/**
+   Returns true if the host stores numerical values in big-endian byte order.
+   
+   @returns true if the host byte order is big-endian.
+*/
+bool
+VTKLegacyBinaryData::host_is_big_endian()
+{
+    const uint16_t one = 1;
+    
+    return *((const char *) &one) == 0;
+}
+
+// Reverses the byte order of every value in an array:
+void
+VTKLegacyBinaryData::swap_byte_order(char *data, size_t n_values, size_t value_size)
+{
+    for (size_t i = 0; i < n_values; i++)
+        reverse(data + i * value_size, data + (i + 1) * value_size);
+}
+
+/**
+   Constructs an empty appended data section.
+   
+   @param[in]   compress   Compress data arrays with zlib.  Ignored if Vortexje was built without zlib.
+*/
+VTKAppendedData::VTKAppendedData(bool compress) : compress(compress), is_valid(true)
+{
+#ifndef VORTEXJE_HAVE_ZLIB
+    if (compress) {
+        cerr << "VTKAppendedData: Vortexje was built without zlib.  Writing uncompressed data." << endl;
+        
+        this->compress = false;
+    }
+#endif
+}
+
+/**
+   Returns true if the data arrays are compressed.
+   
+   @returns true if the data arrays are compressed.
+*/
+bool
+VTKAppendedData::compressed() const
+{
+    return compress;
+}
+
+/**
+   Returns the byte order of the data arrays, as named in the VTKFile element.
+   
+   @returns "BigEndian" or "LittleEndian".
+*/
+const char *
+VTKAppendedData::byte_order() const
+{
+    if (VTKLegacyBinaryData::host_is_big_endian())
+        return "BigEndian";
+    else
+        return "LittleEndian";
+}
+
+/**
+   Writes the appended data section, including the enclosing AppendedData element, to a file.
+   
+   @param[in]   f   Destination file stream.
+   
+   @returns true on success, and false if the file could not be written, or if the compression of a data array failed.
+*/
+bool
+VTKAppendedData::write(std::ofstream &f) const
+{
+    if (!is_valid)
+        return false;
+        
+    f << "  <AppendedData encoding=\"raw\">\n";
+    f << "   _";
+    
+    f.write(buffer.data(), buffer.size());
+    
+    f << "\n";
+    f << "  </AppendedData>\n";
+    
+    return f.good();
+}
+
+// Appends a block of raw data, and returns its offset:
+uint64_t
+VTKAppendedData::append_bytes(const char *data, size_t size)
+{
+    uint64_t offset = buffer.size();
+    
+    if (!compress) {
+        uint64_t header = size;
+        
+        buffer.insert(buffer.end(), (const char *) &header, (const char *) &header + sizeof(header));
+        buffer.insert(buffer.end(), data, data + size);
+        
+        return offset;
+    }
+    
+#ifdef VORTEXJE_HAVE_ZLIB
+    // Header: number of blocks, block size, size of the last partial block, and compressed size of every block:
+    size_t n_blocks = (size + compression_block_size - 1) / compression_block_size;
+    
+    vector<uint64_t> header(3 + n_blocks);
+    header[0] = n_blocks;
+    header[1] = compression_block_size;
+    header[2] = size % compression_block_size;
+    
+    size_t header_begin = buffer.size();
+    buffer.resize(header_begin + header.size() * sizeof(uint64_t));
+    
+    for (size_t i = 0; i < n_blocks; i++) {
+        size_t block_begin = i * compression_block_size;
+        size_t block_size  = min(compression_block_size, size - block_begin);
+        
+        uLongf compressed_size = compressBound(block_size);
+        
+        size_t compressed_begin = buffer.size();
+        buffer.resize(compressed_begin + compressed_size);
+        
+        int status = compress2((Bytef *) &buffer[compressed_begin], &compressed_size, (const Bytef *) data + block_begin, block_size, Z_DEFAULT_COMPRESSION);
+        if (status != Z_OK) {
+            cerr << "VTKAppendedData: Unable to compress data array (zlib error " << status << ")." << endl;
+            
+            is_valid = false;
+            
+            compressed_size = 0;
+        }
+        
+        buffer.resize(compressed_begin + compressed_size);
+        
+        header[3 + i] = compressed_size;
+    }
+    
+    memcpy(&buffer[header_begin], header.data(), header.size() * sizeof(uint64_t));
+#endif
+    
+    return offset;
+}
@@ -0,0 +1,109 @@
+//
+// Vortexje -- Binary data for VTK output files.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __VTK_BINARY_DATA_HPP__
+#define __VTK_BINARY_DATA_HPP__
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+namespace Vortexje
+{
+
+/**
+   Binary data section of a legacy VTK file.
+   
+   Text and big-endian binary data are accumulated in memory, so that the complete file can be written to disk in one go.
+   
+   @brief Binary data section of a legacy VTK file.
+*/
+class VTKLegacyBinaryData
+{
+public:
+    void append(const std::string &text);
+    
+    /**
+       Appends an array of numerical values, in big-endian byte order.
+       
+       @param[in]   values     Array of values.
+       @param[in]   n_values   Number of values.
+    */
+    template <class T>
+    void append(const T *values, size_t n_values)
+    {
+        size_t begin = buffer.size();
+        
+        buffer.resize(begin + n_values * sizeof(T));
+        
+        memcpy(&buffer[begin], values, n_values * sizeof(T));
+        
+        if (!host_is_big_endian())
+            swap_byte_order(&buffer[begin], n_values, sizeof(T));
+    }
+    
+    bool write(std::ofstream &f) const;
+    
+    static bool host_is_big_endian();
+    
+private:
+    std::vector<char> buffer;
+    
+    static void swap_byte_order(char *data, size_t n_values, size_t value_size);
+};
+
+/**
+   Appended data section of a VTK XML file.
+   
+   Every data array is stored as a block of raw binary data in the native byte order, preceded by a 64-bit header.  If
+   compression is enabled, the arrays are compressed with zlib in blocks of 32 KiB, following the layout of the
+   vtkZLibDataCompressor.  If the compression of an array fails, the section is invalid, and write() fails.
+   
+   @brief Appended data section of a VTK XML file.
+*/
+class VTKAppendedData
+{
+public:
+    VTKAppendedData(bool compress);
+    
+    /**
+       Appends an array of numerical values.
+       
+       @param[in]   values     Array of values.
+       @param[in]   n_values   Number of values.
+       
+       @returns Offset of the array within the appended data section.
+    */
+    template <class T>
+    uint64_t append(const T *values, size_t n_values)
+    {
+        return append_bytes((const char *) values, n_values * sizeof(T));
+    }
+    
+    bool compressed() const;
+    
+    const char *byte_order() const;
+    
+    bool write(std::ofstream &f) const;
+    
+private:
+    bool compress;
+    
+    bool is_valid;
+    
+    std::vector<char> buffer;
+    
+    uint64_t append_bytes(const char *data, size_t size);
+};
+
+};
+
+#endif // __VTK_BINARY_DATA_HPP__
@@ -0,0 +1,80 @@
+//
+// Vortexje -- VTK collection writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#include <iostream>
+#include <fstream>
+#include <limits>
+
+#include <vortexje/vtk-collection-writer.hpp>
+
+using namespace std;
+using namespace Vortexje;
+
+/**
+   Adds a data set to the collection.
+   
+   @param[in]   time       Simulation time associated with the data set.
+   @param[in]   filename   Filename of the data set, absolute or relative to the collection file.
+   @param[in]   part       Part number, for collections that consist of multiple data sets per time step.
+*/
+void
+VTKCollectionWriter::add_dataset(double time, const std::string &filename, int part)
+{
+    DataSet dataset;
+    dataset.time     = time;
+    dataset.part     = part;
+    dataset.filename = filename;
+    
+    datasets.push_back(dataset);
+}
+
+/**
+   Removes all data sets from the collection.
+*/
+void
+VTKCollectionWriter::clear()
+{
+    datasets.clear();
+}
+
+/**
+   Saves the collection.  The collection file is small, so that it can be rewritten after every time step.
+   
+   @param[in]   filename   Destination filename.
+   
+   @returns true on success.
+*/
+bool
+VTKCollectionWriter::write(const std::string &filename) const
+{
+    ofstream f;
+    f.open(filename.c_str());
+    
+    f.precision(numeric_limits<double>::digits10);
+    
+    f << "<?xml version=\"1.0\"?>\n";
+    f << "<VTKFile type=\"Collection\" version=\"0.1\">\n";
+    f << " <Collection>\n";
+    
+    vector<DataSet>::const_iterator it;
+    for (it = datasets.begin(); it != datasets.end(); it++)
+        f << "  <DataSet timestep=\"" << it->time << "\" part=\"" << it->part << "\" file=\"" << it->filename << "\"/>\n";
+    
+    f << " </Collection>\n";
+    f << "</VTKFile>\n";
+    
+    if (!f.good()) {
+        cerr << "VTKCollectionWriter: Unable to save to " << filename << "." << endl;
+        
+        return false;
+    }
+    
+    f.close();
+    
+    return true;
+}
@@ -0,0 +1,47 @@
+//
+// Vortexje -- VTK collection writer.
+//
+// Copyright (C) 2026 agent.
+//
+// Authors: agent <agent@local>
+//
+
+#ifndef __VTK_COLLECTION_WRITER_HPP__
+#define __VTK_COLLECTION_WRITER_HPP__
+
+#include <string>
+#include <vector>
+
+namespace Vortexje
+{
+
+/**
+   ParaView data collection (.pvd) file writer.  A collection ties the VTK files written at subsequent time steps together
+   into a single time series, optionally consisting of multiple parts, such as the surfaces of a body.
+   
+   @brief VTK collection writer.
+*/
+class VTKCollectionWriter
+{
+public:
+    void add_dataset(double time, const std::string &filename, int part = 0);
+    
+    void clear();
+    
+    bool write(const std::string &filename) const;
+    
+private:
+    class DataSet
+    {
+    public:
+        double time;
+        int part;
+        std::string filename;
+    };
+    
+    std::vector<DataSet> datasets;
+};
+
+};
+
+#endif // __VTK_COLLECTION_WRITER_HPP__
@@ -14,11 +14,6 @@ using namespace std;
 using namespace Eigen;
 using namespace Vortexje;
 
-static const double pi = 3.141592653589793238462643383279502884;
-
-// Avoid having to divide by 4 pi all the time:
-static const double one_over_4pi = 1.0 / (4 * pi);
-
 /**
    Constructs an empty wake.
    
@@ -42,6 +37,10 @@ Wake::add_layer()
     else
         first_layer = false;
         
+    // Stop sharing the panel neighbor map with copies of this wake:
+    if (!first_layer && panel_neighbors.use_count() > 1)
+        panel_neighbors = make_shared<vector<vector<vector<pair<int, int> > > > >(*panel_neighbors);
+        
     // Add layer of nodes at trailing edge, and add panels if necessary:
     for (int k = 0; k < lifting_surface->n_spanwise_nodes(); k++) {
         Vector3d new_point = lifting_surface->nodes[lifting_surface->trailing_edge_node(k)];
@@ -61,7 +60,7 @@ Wake::add_layer()
         
             vector<vector<pair<int, int> > > local_panel_neighbors;
             local_panel_neighbors.resize(vertices.size());
-            panel_neighbors.push_back(local_panel_neighbors);
+            panel_neighbors->push_back(local_panel_neighbors);
             
             shared_ptr<vector<int> > empty = make_shared<vector<int> >();
             node_panel_neighbors.push_back(empty);
@@ -75,6 +74,10 @@ Wake::add_layer()
             node_panel_neighbors.push_back(empty);
         }
     }
+    
+    // Update vortex filaments:
+    if (!first_layer)
+        compute_vortex_filaments();
 }
 
 /**
@@ -148,7 +151,76 @@ Wake::update_properties(double dt)
 }
 
 /**
-   Computes the velocity induced by a vortex ring of unit strength.
+   Appends the state of this wake to a checkpoint:  the panel topology, which grows as layers are added, the node positions and 
+   panel geometry, and the doublet distribution.
+   
+   @param[in]   checkpoint   Checkpoint to append to.
+*/
+void
+Wake::save_state(CheckpointWriter &checkpoint) const
+{
+    this->Surface::save_state(checkpoint);
+    
+    checkpoint.write_doubles(doublet_coefficients.data(), doublet_coefficients.size());
+}
+
+/**
+   Restores the state of this wake from a checkpoint written by save_state().  Any existing wake panels are replaced.
+   
+   @param[in]   checkpoint   Checkpoint to read from.
+   
+   @returns true on success.
+*/
+bool
+Wake::load_state(CheckpointReader &checkpoint)
+{
+    // Restore topology and geometry:
+    if (!this->Surface::load_state(checkpoint))
+        return false;
+        
+    // Restore doublet distribution:
+    doublet_coefficients.resize(n_panels());
+    checkpoint.read_doubles(doublet_coefficients.data(), doublet_coefficients.size());
+    
+    if (!checkpoint.valid()) {
+        cerr << "Wake " << id << ": Checkpoint is truncated." << endl;
+        
+        return false;
+    }
+    
+    compute_vortex_filaments();
+    
+    return true;
+}
+
+/**
+   Replaces the panel topology of this wake by the topology stored in a checkpoint.  Wake panels have no neighbors.
+   
+   @param[in]   stored_n_nodes       Number of nodes.
+   @param[in]   stored_panel_nodes   Panel number to node numbers map.
+   
+   @returns true on success.
+*/
+bool
+Wake::restore_topology(int stored_n_nodes, const std::vector<std::vector<int> > &stored_panel_nodes)
+{
+    nodes.resize(stored_n_nodes);
+    
+    node_panel_neighbors.clear();
+    for (int i = 0; i < stored_n_nodes; i++)
+        node_panel_neighbors.push_back(make_shared<vector<int> >());
+    
+    panel_nodes = stored_panel_nodes;
+    
+    panel_neighbors = make_shared<vector<vector<vector<pair<int, int> > > > >();
+    for (int i = 0; i < (int) stored_panel_nodes.size(); i++)
+        panel_neighbors->push_back(vector<vector<pair<int, int> > >(panel_nodes[i].size()));
+        
+    return true;
+}
+
+/**
+   Computes the velocity induced by a vortex ring of unit strength, with a Rankine vortex core.
    
    @param[in]   x            Point at which the velocity is evaluated.
    @param[in]   this_panel   Panel on which the vortex ring is located.
@@ -158,48 +230,20 @@ Wake::update_properties(double dt)
 Vector3d
 Wake::vortex_ring_unit_velocity(const Eigen::Vector3d &x, int this_panel) const
 {    
-    Vector3d velocity(0, 0, 0);
-    
-    for (int i = 0; i < (int) panel_nodes[this_panel].size(); i++) {
-        int previous_idx;
-        if (i == 0)
-            previous_idx = panel_nodes[this_panel].size() - 1;
-        else
-            previous_idx = i - 1;
-            
-        const Vector3d &node_a = nodes[panel_nodes[this_panel][previous_idx]];
-        const Vector3d &node_b = nodes[panel_nodes[this_panel][i]];
-        
-        Vector3d r_0 = node_b - node_a;
-        Vector3d r_1 = node_a - x;
-        Vector3d r_2 = node_b - x;
-        
-        double r_0_norm = r_0.norm();
-        double r_1_norm = r_1.norm();
-        double r_2_norm = r_2.norm();
-        
-        Vector3d r_1xr_2 = r_1.cross(r_2);
-        double r_1xr_2_sqnorm = r_1xr_2.squaredNorm();
-        
-        if (r_0_norm < Parameters::zero_threshold ||
-            r_1_norm < Parameters::zero_threshold ||
-            r_2_norm < Parameters::zero_threshold ||
-            r_1xr_2_sqnorm < Parameters::zero_threshold)
-            continue;
-
-        double r = sqrt(r_1xr_2_sqnorm) / r_0_norm;
-        if (r < Parameters::wake_vortex_core_radius) {
-            // Rankine vortex core segment:
-            velocity += r_1xr_2 / (r_0_norm * pow(Parameters::wake_vortex_core_radius, 2))
-                * (r_0 / r_0_norm).dot(r_1 / r_1_norm - r_2 / r_2_norm);
-                
-        } else {
-            // Free vortex segment:
-            velocity += r_1xr_2 / r_1xr_2_sqnorm * r_0.dot(r_1 / r_1_norm - r_2 / r_2_norm);
-            
-        }
-    }
-
-    return one_over_4pi * velocity;
+    return compute_vortex_ring_unit_velocity(RankineVortexCore(Parameters::wake_vortex_core_radius), x, this_panel);
 }
 
+/**
+   Computes the velocities induced by the vortex sheet formed by the vortex rings of this wake, with a Rankine vortex core, for 
+   a batch of points.
+   
+   @param[in]   points                 Points at which the velocity is evaluated, one per column.
+   @param[in]   doublet_coefficients   Strengths of the vortex rings.  Panels beyond the length of this vector have zero strength.
+   @param[out]  velocities             Velocities induced by the vortex sheet, one per column.
+*/
+void
+Wake::vortex_sheet_velocities(const Eigen::Ref<const Eigen::Matrix3Xd> &points, const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients,
+                              Eigen::Ref<Eigen::Matrix3Xd> velocities) const
+{
+    compute_vortex_sheet_velocities(RankineVortexCore(Parameters::wake_vortex_core_radius), points, doublet_coefficients, velocities);
+}
@@ -42,12 +42,21 @@ public:
     
     virtual void update_properties(double dt);
     
+    virtual void save_state(CheckpointWriter &checkpoint) const;
+    virtual bool load_state(CheckpointReader &checkpoint);
+    
     virtual Eigen::Vector3d vortex_ring_unit_velocity(const Eigen::Vector3d &x, int this_panel) const;
     
+    virtual void vortex_sheet_velocities(const Eigen::Ref<const Eigen::Matrix3Xd> &points, const Eigen::Ref<const Eigen::VectorXd> &doublet_coefficients,
+                                         Eigen::Ref<Eigen::Matrix3Xd> velocities) const;
+    
     /**
        Strengths of the doublet, or vortex ring, panels.
     */
     std::vector<double> doublet_coefficients;
+    
+protected:
+    bool restore_topology(int stored_n_nodes, const std::vector<std::vector<int> > &stored_panel_nodes);
 };
 
 };